@@ -0,0 +1,379 @@
+#ifndef MIV_AD_DUAL_H
+#define MIV_AD_DUAL_H
+
+#include <cstddef>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <type_traits>
+
+namespace miv::ad
+{
+    /**
+     * @brief Дуальное число прямого режима: значение и N производных по направлениям.
+     *
+     * dual<T, N> x = v + Σ d_k ε_k, ε_k ε_l = 0. Арифметика и элементарные функции
+     * переносят производные по правилу цепочки, поэтому функция f, вызванная от
+     * dual, возвращает f(v) и N производных по направлениям d сразу — за один
+     * проход вместо N разностных.
+     *
+     * Производные хранятся плотным массивом T[N]: все циклы по k — константной
+     * длины, компилятор разворачивает и векторизует их.
+     *
+     * Пользовательские функции должны вызывать математику без квалификации
+     * (sin(x), а не std::sin(x)) — тогда для dual её находит ADL:
+     *
+     * @code
+     * template <miv::ad::Scalar T>
+     * T f(miv::array<T> &x)
+     * {
+     *     using std::sin;
+     *     return sin(x[0]) * x[1] + static_cast<T>(2);
+     * }
+     * @endcode
+     */
+    template <typename T, std::size_t N>
+        requires std::is_floating_point_v<T>
+    struct dual
+    {
+        static_assert(N > 0, "dual: N must be positive");
+
+        using value_type = T;
+        static constexpr std::size_t width = N;
+
+        T v{};      ///< значение
+        T d[N]{};   ///< производные по N направлениям
+
+        constexpr dual() = default;
+
+        /// Константа: все производные нулевые (нужно для static_cast<T>(1.2), T sum = 0 и т.п.)
+        template <typename U>
+            requires std::is_arithmetic_v<U>
+        constexpr dual(U value) : v(static_cast<T>(value))
+        {
+        }
+
+        /**
+         * @brief Независимая переменная со значением value и производной 1 по направлению k.
+         */
+        static constexpr dual variable(T value, std::size_t k)
+        {
+            dual r(value);
+            r.d[k] = static_cast<T>(1);
+            return r;
+        }
+
+        constexpr explicit operator T() const { return v; }
+
+        // ---------------------------------------------------------------------
+        //                        Составное присваивание
+        // ---------------------------------------------------------------------
+
+        constexpr dual &operator+=(const dual &b)
+        {
+            v += b.v;
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                d[k] += b.d[k];
+            }
+            return *this;
+        }
+
+        constexpr dual &operator-=(const dual &b)
+        {
+            v -= b.v;
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                d[k] -= b.d[k];
+            }
+            return *this;
+        }
+
+        constexpr dual &operator*=(const dual &b)
+        {
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                d[k] = d[k] * b.v + v * b.d[k];
+            }
+            v *= b.v;
+            return *this;
+        }
+
+        constexpr dual &operator/=(const dual &b)
+        {
+            const T inv = static_cast<T>(1) / b.v;
+            const T q = v * inv;
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                d[k] = (d[k] - q * b.d[k]) * inv;
+            }
+            v = q;
+            return *this;
+        }
+
+        constexpr dual &operator+=(T b)
+        {
+            v += b;
+            return *this;
+        }
+
+        constexpr dual &operator-=(T b)
+        {
+            v -= b;
+            return *this;
+        }
+
+        constexpr dual &operator*=(T b)
+        {
+            v *= b;
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                d[k] *= b;
+            }
+            return *this;
+        }
+
+        constexpr dual &operator/=(T b)
+        {
+            return *this *= static_cast<T>(1) / b;
+        }
+
+        // ---------------------------------------------------------------------
+        //        Арифметика (скрытые друзья: int/double приводятся к T)
+        // ---------------------------------------------------------------------
+
+        friend constexpr dual operator+(const dual &a) { return a; }
+
+        friend constexpr dual operator-(const dual &a)
+        {
+            dual r;
+            r.v = -a.v;
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                r.d[k] = -a.d[k];
+            }
+            return r;
+        }
+
+        friend constexpr dual operator+(dual a, const dual &b) { return a += b; }
+        friend constexpr dual operator-(dual a, const dual &b) { return a -= b; }
+        friend constexpr dual operator*(dual a, const dual &b) { return a *= b; }
+        friend constexpr dual operator/(dual a, const dual &b) { return a /= b; }
+
+        friend constexpr dual operator+(dual a, T b) { return a += b; }
+        friend constexpr dual operator-(dual a, T b) { return a -= b; }
+        friend constexpr dual operator*(dual a, T b) { return a *= b; }
+        friend constexpr dual operator/(dual a, T b) { return a /= b; }
+
+        friend constexpr dual operator+(T a, dual b) { return b += a; }
+        friend constexpr dual operator-(T a, const dual &b) { return -b + a; }
+        friend constexpr dual operator*(T a, dual b) { return b *= a; }
+        friend constexpr dual operator/(T a, const dual &b) { return dual(a) / b; }
+
+        // Сравнения — по значению (ветвления в функциях выбирают ту же ветку, что и для T)
+        friend constexpr bool operator==(const dual &a, const dual &b) { return a.v == b.v; }
+        friend constexpr auto operator<=>(const dual &a, const dual &b) { return a.v <=> b.v; }
+        friend constexpr bool operator==(const dual &a, T b) { return a.v == b; }
+        friend constexpr auto operator<=>(const dual &a, T b) { return a.v <=> b; }
+    };
+
+    // ============================================================
+    //                          Трейты
+    // ============================================================
+
+    template <typename T>
+    struct is_dual : std::false_type
+    {
+    };
+
+    template <typename T, std::size_t N>
+    struct is_dual<dual<T, N>> : std::true_type
+    {
+    };
+
+    template <typename T>
+    inline constexpr bool is_dual_v = is_dual<T>::value;
+
+    /**
+     * @brief Тип, от которого можно вызывать функции системы: число с плавающей точкой
+     *        (как miv::math::FloatNumber) или dual.
+     */
+    template <typename T>
+    concept Scalar = std::is_floating_point_v<T> || is_dual_v<T>;
+
+    // ============================================================
+    //                   Элементарные функции (ADL)
+    // ============================================================
+
+    namespace detail
+    {
+        /**
+         * @brief f(a) при f(a.v) = value, f'(a.v) = slope.
+         */
+        template <typename T, std::size_t N>
+        constexpr dual<T, N> chain(const dual<T, N> &a, T value, T slope)
+        {
+            dual<T, N> r;
+            r.v = value;
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                r.d[k] = slope * a.d[k];
+            }
+            return r;
+        }
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> sin(const dual<T, N> &a)
+    {
+        return detail::chain(a, std::sin(a.v), std::cos(a.v));
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> cos(const dual<T, N> &a)
+    {
+        return detail::chain(a, std::cos(a.v), -std::sin(a.v));
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> tan(const dual<T, N> &a)
+    {
+        const T t = std::tan(a.v);
+        return detail::chain(a, t, static_cast<T>(1) + t * t);
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> asin(const dual<T, N> &a)
+    {
+        return detail::chain(a, std::asin(a.v), static_cast<T>(1) / std::sqrt(static_cast<T>(1) - a.v * a.v));
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> acos(const dual<T, N> &a)
+    {
+        return detail::chain(a, std::acos(a.v), static_cast<T>(-1) / std::sqrt(static_cast<T>(1) - a.v * a.v));
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> atan(const dual<T, N> &a)
+    {
+        return detail::chain(a, std::atan(a.v), static_cast<T>(1) / (static_cast<T>(1) + a.v * a.v));
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> sinh(const dual<T, N> &a)
+    {
+        return detail::chain(a, std::sinh(a.v), std::cosh(a.v));
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> cosh(const dual<T, N> &a)
+    {
+        return detail::chain(a, std::cosh(a.v), std::sinh(a.v));
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> tanh(const dual<T, N> &a)
+    {
+        const T t = std::tanh(a.v);
+        return detail::chain(a, t, static_cast<T>(1) - t * t);
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> exp(const dual<T, N> &a)
+    {
+        const T e = std::exp(a.v);
+        return detail::chain(a, e, e);
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> log(const dual<T, N> &a)
+    {
+        return detail::chain(a, std::log(a.v), static_cast<T>(1) / a.v);
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> log10(const dual<T, N> &a)
+    {
+        return detail::chain(a, std::log10(a.v), static_cast<T>(1) / (a.v * std::log(static_cast<T>(10))));
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> sqrt(const dual<T, N> &a)
+    {
+        const T s = std::sqrt(a.v);
+        return detail::chain(a, s, static_cast<T>(0.5) / s);
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> cbrt(const dual<T, N> &a)
+    {
+        const T c = std::cbrt(a.v);
+        return detail::chain(a, c, static_cast<T>(1) / (static_cast<T>(3) * c * c));
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> abs(const dual<T, N> &a)
+    {
+        return a.v < T{} ? -a : a;
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> fabs(const dual<T, N> &a)
+    {
+        return abs(a);
+    }
+
+    /**
+     * @brief a^p для постоянного показателя (pow(x, 2), pow(x, 0.5)).
+     */
+    template <typename T, std::size_t N>
+    dual<T, N> pow(const dual<T, N> &a, std::type_identity_t<T> p)
+    {
+        if (p == static_cast<T>(2))
+        {
+            return a * a;
+        }
+
+        const T value = std::pow(a.v, p);
+        const T slope = (p == T{}) ? T{} : p * std::pow(a.v, p - static_cast<T>(1));
+        return detail::chain(a, value, slope);
+    }
+
+    /**
+     * @brief a^b = exp(b log a) (a > 0).
+     */
+    template <typename T, std::size_t N>
+    dual<T, N> pow(const dual<T, N> &a, const dual<T, N> &b)
+    {
+        return exp(b * log(a));
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> pow(std::type_identity_t<T> a, const dual<T, N> &b)
+    {
+        const T value = std::pow(a, b.v);
+        return detail::chain(b, value, value * std::log(a));
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> atan2(const dual<T, N> &y, const dual<T, N> &x)
+    {
+        const T r2 = x.v * x.v + y.v * y.v;
+        dual<T, N> r;
+        r.v = std::atan2(y.v, x.v);
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            r.d[k] = (x.v * y.d[k] - y.v * x.d[k]) / r2;
+        }
+        return r;
+    }
+
+    template <typename T, std::size_t N>
+    dual<T, N> hypot(const dual<T, N> &x, const dual<T, N> &y)
+    {
+        return sqrt(x * x + y * y);
+    }
+}
+
+#endif // MIV_AD_DUAL_H
@@ -0,0 +1,1055 @@
+#include "batch.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "containers/array.hpp"
+#include "containers/matrix.hpp"
+#include "exec/thread_pool.hpp"
+#include "math/batch_solver.hpp"
+#include "math/newton_options.hpp"
+#include "math/newton_solver.hpp"
+#include "math/multi_start.hpp"
+#include "math/sparse.hpp"
+#include "math/system.hpp"
+#include "io/matrix_file.hpp"
+#include "io/trace.hpp"
+
+#include "functions.hpp"
+
+/**
+ * @file batch.cpp
+ * @brief Пакетный режим: конфигурация, очередь начальных приближений, рабочие потоки.
+ *
+ * @details
+ * Входной поток — по начальному приближению на строку: n чисел через пробел
+ * или @файл.qmm. Пустые строки и строки с # пропускаются. Главный поток читает
+ * строки в ограниченную очередь (читатель не убегает вперёд на бесконечном
+ * входе), --jobs рабочих потоков разбирают их и решают — у каждого свой
+ * newton_solver, поэтому буферы Якобиана и разложения не делятся.
+ *
+ * Результат пишется строкой CSV сразу после решения задачи:
+ *   index,status,iterations,residual_norm,x1,...,xn
+ * index — номер задачи во входе (с 1); с --jobs > 1 строки идут в порядке
+ * готовности. status — критерий остановки (residual, step, max_iterations)
+ * или error (текст ошибки — в stderr).
+ *
+ * С --multi-start все начальные приближения (из входа или --starts K в --box)
+ * решаются как один мульти-старт на пуле miv::exec (math/multi_start.hpp), и
+ * выводятся только разные корни:
+ *   root,hits,start,residual_norm,x1,...,xn
+ *
+ * С --soa все начальные приближения решаются одним вызовом solve_batch
+ * (math/batch_solver.hpp): блоками по --block-lanes дорожек в формате SoA на
+ * пуле miv::exec. Вывод — те же строки index,... в порядке входа; status —
+ * converged, max_iterations, singular или diverged.
+ */
+
+namespace
+{
+    using T = FuncFloat;
+    using miv::math::JacobianMode;
+
+    /**
+     * @brief Параметры пакетного запуска.
+     */
+    struct batch_config
+    {
+        miv::math::newton_options<T> options;
+        std::size_t jobs = 1;           ///< 0 — по числу потоков пула miv::exec
+        std::string input = "-";        ///< "-" — stdin
+        std::string output = "-";       ///< "-" — stdout
+        std::string jacobian_file;      ///< .qmm с матрицей для jacobian = manual
+        bool header = true;             ///< строка заголовка CSV
+
+        bool multi_start = false;       ///< все старты — один мульти-старт, вывод — разные корни
+        std::size_t starts = 0;         ///< мульти-старт: сгенерировать столько стартов в box (0 — из входа)
+        T box_lower = static_cast<T>(-1);
+        T box_upper = static_cast<T>(1);
+        std::uint64_t seed = 1;
+        miv::math::multi_start_options multi;
+
+        bool soa = false;               ///< все старты — один solve_batch (SoA-блоки дорожек)
+        miv::math::batch_options lanes;
+    };
+
+    void print_usage(const char *program)
+    {
+        std::cerr
+            << "Использование: " << program << " [параметры]\n"
+            << "Без параметров — интерактивное меню.\n\n"
+            << "  --config FILE          файл конфигурации: строки 'ключ = значение' с теми же\n"
+            << "                         ключами, что у параметров (без --); параметры\n"
+            << "                         командной строки его переопределяют\n"
+            << "  --method M             newton | modified | broyden-good | broyden-bad\n"
+            << "  --jacobian J           numeric | manual | sparse | jacobian-free | automatic\n"
+            << "  --formula F            two-point | three-point\n"
+            << "  --linear-precision P   native | double | float: плотное LU в P с уточнением в FuncFloat\n"
+            << "  --jacobian-file FILE   матрица Якоби (.qmm) для --jacobian manual\n"
+            << "  --lambda L             демпфирование шага, (0, 1] (для line-search — первое λ)\n"
+            << "  --globalization G      none | line-search | dogleg\n"
+            << "  --eps-f E              остановка по ||F||\n"
+            << "  --eps-x E              остановка по ||s||\n"
+            << "  --max-iter N           лимит итераций\n"
+            << "  --cache-mb M           кэш разложений Якобиана (LRU) на поток, МиБ (0 — выключен)\n"
+            << "  --cache-radius R       старт берёт разложение из кэша при ||x0 - x_c|| <= R (1 + ||x_c||)\n"
+            << "  --jobs N               решать N задач одновременно (0 — все ядра)\n"
+            << "  --input FILE           начальные приближения, по одному на строку (- — stdin)\n"
+            << "  --output FILE          результаты CSV (- — stdout)\n"
+            << "  --no-header            без строки заголовка CSV\n"
+            << "  --multi-start          все старты — один мульти-старт, вывод — разные корни\n"
+            << "  --starts K             мульти-старт: K случайных стартов в --box вместо входа\n"
+            << "  --box LO:HI            мульти-старт: интервал каждой координаты (-1:1)\n"
+            << "  --seed S               мульти-старт: зерно генератора стартов\n"
+            << "  --root-tol E           мульти-старт: допуск совпадения корней\n"
+            << "  --max-roots N          мульти-старт: остановиться после N разных корней\n"
+            << "  --soa                  все старты — одним пакетом SoA (numeric, newton | modified)\n"
+            << "  --block-lanes N        --soa: дорожек в одном блоке (64)\n"
+            << "  --help                 эта справка\n";
+    }
+
+    template <typename V>
+    V parse_value(std::string_view key, std::string_view text)
+    {
+        std::istringstream ss{ std::string(text) };
+        V value{};
+        ss >> value;
+        if (ss.fail() || !(ss >> std::ws).eof())
+        {
+            throw std::invalid_argument("bad value '" + std::string(text) + "' for " + std::string(key));
+        }
+        return value;
+    }
+
+    std::size_t parse_count(std::string_view key, std::string_view text)
+    {
+        const auto value = parse_value<long long>(key, text);
+        if (value < 0)
+        {
+            throw std::invalid_argument(std::string(key) + " must not be negative");
+        }
+        return static_cast<std::size_t>(value);
+    }
+
+    /**
+     * @brief Применить одну настройку.
+     *
+     * @return false, если ключ неизвестен
+     * @throws std::invalid_argument при неверном значении
+     */
+    bool apply_setting(batch_config &config, std::string_view key, std::string_view value)
+    {
+        auto &opt = config.options;
+
+        auto require = [&](bool ok)
+        {
+            if (!ok)
+            {
+                throw std::invalid_argument("bad value '" + std::string(value) + "' for " + std::string(key));
+            }
+        };
+
+        if (key == "method")
+        {
+            require(miv::math::parse_method(value, opt.method));
+        }
+        else if (key == "jacobian")
+        {
+            require(miv::math::parse_jacobian_mode(value, opt.jacobian));
+        }
+        else if (key == "formula")
+        {
+            require(miv::math::parse_numeric_formula(value, opt.formula));
+        }
+        else if (key == "linear-precision")
+        {
+            require(miv::math::parse_linear_precision(value, opt.linear_precision));
+        }
+        else if (key == "jacobian-file")
+        {
+            config.jacobian_file = value;
+        }
+        else if (key == "lambda")
+        {
+            opt.lambda = parse_value<T>(key, value);
+        }
+        else if (key == "globalization")
+        {
+            require(miv::math::parse_globalization(value, opt.globalization));
+        }
+        else if (key == "eps-f")
+        {
+            opt.eps_F = parse_value<T>(key, value);
+        }
+        else if (key == "eps-x")
+        {
+            opt.eps_x = parse_value<T>(key, value);
+        }
+        else if (key == "cache-mb")
+        {
+            opt.cache_bytes = parse_count(key, value) << 20;
+        }
+        else if (key == "cache-radius")
+        {
+            opt.cache_radius = parse_value<T>(key, value);
+            require(opt.cache_radius >= static_cast<T>(0));
+        }
+        else if (key == "max-iter")
+        {
+            opt.max_iterations = parse_count(key, value);
+            require(opt.max_iterations > 0);
+        }
+        else if (key == "jobs")
+        {
+            config.jobs = parse_count(key, value);
+        }
+        else if (key == "input")
+        {
+            config.input = value;
+        }
+        else if (key == "output")
+        {
+            config.output = value;
+        }
+        else if (key == "header")
+        {
+            require(value == "true" || value == "false");
+            config.header = (value == "true");
+        }
+        else if (key == "multi-start")
+        {
+            require(value == "true" || value == "false");
+            config.multi_start = (value == "true");
+        }
+        else if (key == "starts")
+        {
+            config.starts = parse_count(key, value);
+        }
+        else if (key == "box")
+        {
+            const auto colon = value.find(':');
+            require(colon != std::string_view::npos);
+            config.box_lower = parse_value<T>(key, value.substr(0, colon));
+            config.box_upper = parse_value<T>(key, value.substr(colon + 1));
+            require(config.box_lower <= config.box_upper);
+        }
+        else if (key == "seed")
+        {
+            config.seed = parse_count(key, value);
+        }
+        else if (key == "root-tol")
+        {
+            config.multi.root_tolerance = parse_value<miv::math::norm_t>(key, value);
+            require(config.multi.root_tolerance > 0);
+        }
+        else if (key == "max-roots")
+        {
+            config.multi.max_roots = parse_count(key, value);
+        }
+        else if (key == "soa")
+        {
+            require(value == "true" || value == "false");
+            config.soa = (value == "true");
+        }
+        else if (key == "block-lanes")
+        {
+            config.lanes.block_lanes = parse_count(key, value);
+            require(config.lanes.block_lanes > 0);
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    std::string_view trim(std::string_view s)
+    {
+        const auto first = s.find_first_not_of(" \t\r");
+        if (first == std::string_view::npos)
+        {
+            return {};
+        }
+        const auto last = s.find_last_not_of(" \t\r");
+        return s.substr(first, last - first + 1);
+    }
+
+    /**
+     * @brief Файл конфигурации: "ключ = значение", # — комментарий до конца строки.
+     */
+    void load_config(const std::string &path, batch_config &config)
+    {
+        std::ifstream in(path);
+        if (!in)
+        {
+            throw std::runtime_error("cannot open config '" + path + "'");
+        }
+
+        std::string line;
+        std::size_t line_no = 0;
+        while (std::getline(in, line))
+        {
+            ++line_no;
+            std::string_view text = line;
+            text = trim(text.substr(0, text.find('#')));
+            if (text.empty())
+            {
+                continue;
+            }
+
+            const auto eq = text.find('=');
+            const std::string where = path + ":" + std::to_string(line_no) + ": ";
+            if (eq == std::string_view::npos)
+            {
+                throw std::invalid_argument(where + "expected 'key = value'");
+            }
+
+            const std::string_view key = trim(text.substr(0, eq));
+            try
+            {
+                if (!apply_setting(config, key, trim(text.substr(eq + 1))))
+                {
+                    throw std::invalid_argument("unknown key '" + std::string(key) + "'");
+                }
+            }
+            catch (const std::invalid_argument &ex)
+            {
+                throw std::invalid_argument(where + ex.what());
+            }
+        }
+    }
+
+    /**
+     * @brief Разобрать argv: сначала --config, затем остальные параметры поверх него.
+     *
+     * @return std::nullopt для --help
+     */
+    std::optional<batch_config> parse_arguments(int argc, char **argv)
+    {
+        std::vector<std::pair<std::string, std::string>> settings;
+        std::string config_path;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg = argv[i];
+
+            if (arg == "--help" || arg == "-h")
+            {
+                return std::nullopt;
+            }
+            if (arg == "--no-header")
+            {
+                settings.emplace_back("header", "false");
+                continue;
+            }
+            if (arg == "--multi-start")
+            {
+                settings.emplace_back("multi-start", "true");
+                continue;
+            }
+            if (arg == "--soa")
+            {
+                settings.emplace_back("soa", "true");
+                continue;
+            }
+            if (!arg.starts_with("--"))
+            {
+                throw std::invalid_argument("unexpected argument '" + std::string(arg) + "'");
+            }
+
+            arg.remove_prefix(2);
+            std::string key;
+            std::string value;
+
+            if (const auto eq = arg.find('='); eq != std::string_view::npos)
+            {
+                key = arg.substr(0, eq);
+                value = arg.substr(eq + 1);
+            }
+            else
+            {
+                if (i + 1 >= argc)
+                {
+                    throw std::invalid_argument("--" + std::string(arg) + " needs a value");
+                }
+                key = arg;
+                value = argv[++i];
+            }
+
+            if (key == "config")
+            {
+                config_path = value;
+            }
+            else
+            {
+                settings.emplace_back(std::move(key), std::move(value));
+            }
+        }
+
+        batch_config config;
+        if (!config_path.empty())
+        {
+            load_config(config_path, config);
+        }
+
+        for (const auto &[key, value] : settings)
+        {
+            if (!apply_setting(config, key, value))
+            {
+                throw std::invalid_argument("unknown option --" + key);
+            }
+        }
+
+        const auto &opt = config.options;
+        if (opt.lambda <= static_cast<T>(0) || opt.lambda > static_cast<T>(1))
+        {
+            throw std::invalid_argument("lambda must be in (0, 1]");
+        }
+        if (miv::math::is_broyden(opt.method) && opt.jacobian == JacobianMode::JacobianFree)
+        {
+            throw std::invalid_argument("Broyden methods need an explicit Jacobian (not jacobian-free)");
+        }
+        if (opt.globalization == miv::math::Globalization::Dogleg &&
+            (miv::math::is_broyden(opt.method) || opt.jacobian == JacobianMode::JacobianFree))
+        {
+            throw std::invalid_argument("dogleg needs an explicit Jacobian (newton or modified, not jacobian-free)");
+        }
+        if (opt.jacobian == JacobianMode::Manual && config.jacobian_file.empty())
+        {
+            throw std::invalid_argument("jacobian = manual needs jacobian-file");
+        }
+        if (config.soa &&
+            (opt.jacobian != JacobianMode::Numeric || miv::math::is_broyden(opt.method) ||
+             opt.globalization != miv::math::Globalization::None))
+        {
+            throw std::invalid_argument("soa needs jacobian = numeric, method newton or modified, globalization none");
+        }
+        if (config.soa && config.multi_start)
+        {
+            throw std::invalid_argument("soa and multi-start cannot be combined");
+        }
+
+        if (config.jobs == 0)
+        {
+            config.jobs = miv::exec::thread_count();
+        }
+        config.multi.jobs = config.jobs;
+
+        return config;
+    }
+
+    // ============================================================
+    //                 Очередь строк входного потока
+    // ============================================================
+
+    struct problem
+    {
+        std::size_t index = 0;   ///< номер во входе, с 1
+        std::string line;
+    };
+
+    /**
+     * @brief Ограниченная очередь: push ждёт места, pop — строки или закрытия.
+     */
+    class problem_queue
+    {
+    public:
+        explicit problem_queue(std::size_t capacity) : m_capacity(capacity > 0 ? capacity : 1) {}
+
+        void push(problem p)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_not_full.wait(lock, [&] { return m_items.size() < m_capacity; });
+            m_items.push_back(std::move(p));
+            lock.unlock();
+            m_not_empty.notify_one();
+        }
+
+        /**
+         * @return false, если очередь закрыта и пуста
+         */
+        bool pop(problem &out)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_not_empty.wait(lock, [&] { return !m_items.empty() || m_closed; });
+            if (m_items.empty())
+            {
+                return false;
+            }
+            out = std::move(m_items.front());
+            m_items.pop_front();
+            lock.unlock();
+            m_not_full.notify_one();
+            return true;
+        }
+
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_closed = true;
+            }
+            m_not_empty.notify_all();
+        }
+
+    private:
+        std::size_t m_capacity;
+        std::deque<problem> m_items;
+        bool m_closed = false;
+        std::mutex m_mutex;
+        std::condition_variable m_not_empty;
+        std::condition_variable m_not_full;
+    };
+
+    /**
+     * @brief Общий вывод результатов и счётчики (под одним мьютексом).
+     */
+    struct batch_output
+    {
+        explicit batch_output(std::ostream &stream) : out(stream) {}
+
+        std::ostream &out;
+        std::mutex mutex;
+        std::size_t solved = 0;
+        std::size_t converged = 0;
+        std::size_t failed = 0;
+        std::size_t cache_hits = 0;
+    };
+
+    /**
+     * @brief Начальное приближение из строки: n чисел или @файл.
+     */
+    miv::array<T> read_start(const std::string &line, std::size_t n)
+    {
+        const std::string_view text = trim(line);
+
+        if (text.starts_with('@'))
+        {
+            auto x = miv::io::load_array<T>(std::string(text.substr(1)));
+            if (x.size() != n)
+            {
+                throw std::invalid_argument("start point has " + std::to_string(x.size()) + " values, expected " +
+                                            std::to_string(n));
+            }
+            return x;
+        }
+
+        std::istringstream ss(line);
+        miv::array<T> x(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (!(ss >> x[i]))
+            {
+                throw std::invalid_argument("start point must have " + std::to_string(n) + " numbers");
+            }
+        }
+        if (!(ss >> std::ws).eof())
+        {
+            throw std::invalid_argument("start point must have " + std::to_string(n) + " numbers");
+        }
+        return x;
+    }
+
+    /**
+     * @brief read_start и, в отладочной сборке с HasSystemVector, сверка обеих форм системы в этой точке.
+     */
+    miv::array<T> parse_start(const std::string &line, std::size_t n)
+    {
+        auto x = read_start(line, n);
+#ifndef NDEBUG
+        if constexpr (HasSystemVector)
+        {
+            check_system_vector(x);
+        }
+#endif
+        return x;
+    }
+
+    /**
+     * @brief То, что готовится один раз и копируется в решатель каждого потока.
+     */
+    struct solver_setup
+    {
+        miv::matrix<T> J_manual;
+        std::optional<miv::math::sparsity_pattern> pattern;
+    };
+
+    /**
+     * @brief Решатель потока: параметры и подготовленные данные из setup.
+     */
+    template <typename System>
+    miv::math::newton_solver<T> make_solver(const batch_config &config, const System &system, const solver_setup &setup)
+    {
+        miv::math::newton_solver<T> solver(config.options);
+
+        if (config.options.jacobian == JacobianMode::Manual)
+        {
+            solver.set_manual_jacobian(setup.J_manual);
+        }
+        if (config.options.jacobian == JacobianMode::Automatic)
+        {
+            if constexpr (HasSystemVector)
+            {
+                solver.set_automatic_jacobian<AutoDiffWidth>(system);
+            }
+            else
+            {
+                solver.set_automatic_jacobian(get_system_dual_functions());
+            }
+        }
+        if (setup.pattern)
+        {
+            solver.set_sparsity(*setup.pattern);
+        }
+
+        return solver;
+    }
+
+    /**
+     * @brief Рабочий поток: задачи из очереди — свой решатель — строки CSV.
+     */
+    template <typename System>
+    void run_worker(
+        const batch_config &config,
+        const System &system,
+        std::size_t n,
+        const solver_setup &setup,
+        problem_queue &queue,
+        batch_output &output,
+        miv::io::trace_writer *trace)
+    {
+        auto solver = make_solver(config, system, setup);
+
+        std::size_t current = 0;
+        if (trace)
+        {
+            solver.set_iteration_callback([&](const miv::math::newton_iteration<T> &it)
+            {
+                trace->write({
+                    .run = static_cast<std::uint32_t>(current),
+                    .iteration = static_cast<std::uint32_t>(it.k),
+                    .fx_norm = static_cast<double>(it.fx_norm),
+                    .step_norm = static_cast<double>(it.step_norm),
+                    .lambda = static_cast<double>(it.lambda),
+                    .iteration_ns = it.iteration_time.count(),
+                    .elapsed_ns = it.elapsed.count(),
+                });
+            });
+        }
+
+        std::ostringstream line;
+        line << std::setprecision(std::numeric_limits<T>::max_digits10);
+
+        problem p;
+        while (queue.pop(p))
+        {
+            current = p.index;
+            line.str({});
+
+            bool ok = false;
+            bool converged = false;
+            bool cache_hit = false;
+            try
+            {
+                const auto result = solver.solve(system, parse_start(p.line, n));
+
+                line << p.index << ',' << miv::math::to_string(result.stop) << ',' << result.iterations << ','
+                     << static_cast<T>(result.residual_norm);
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    line << ',' << result.x[i];
+                }
+                ok = true;
+                converged = result.converged;
+                cache_hit = result.cache_hit;
+            }
+            catch (const std::exception &ex)
+            {
+                line.str({});
+                line << p.index << ",error,0,";
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    line << ',';
+                }
+
+                std::lock_guard<std::mutex> lock(output.mutex);
+                std::cerr << "задача " << p.index << ": " << ex.what() << "\n";
+            }
+            line << '\n';
+
+            std::lock_guard<std::mutex> lock(output.mutex);
+            output.out << line.view() << std::flush;
+            ++output.solved;
+            output.converged += converged ? 1 : 0;
+            output.failed += ok ? 0 : 1;
+            output.cache_hits += cache_hit ? 1 : 0;
+        }
+    }
+
+    /**
+     * @brief Все начальные приближения входа — столбцами матрицы n x starts.
+     */
+    miv::matrix<T> read_starts(std::istream &in, std::size_t n)
+    {
+        std::vector<miv::array<T>> points;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            const std::string_view text = trim(line);
+            if (text.empty() || text.starts_with('#'))
+            {
+                continue;
+            }
+            try
+            {
+                points.push_back(parse_start(line, n));
+            }
+            catch (const std::invalid_argument &ex)
+            {
+                throw std::invalid_argument("start " + std::to_string(points.size() + 1) + ": " + ex.what());
+            }
+        }
+
+        miv::matrix<T> starts(n, points.size(), miv::uninitialized);
+        for (std::size_t s = 0; s < points.size(); ++s)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                starts(i, s) = points[s][i];
+            }
+        }
+        return starts;
+    }
+
+    /**
+     * @brief Пакет SoA: все старты входа одним solve_batch, строки CSV в порядке входа.
+     */
+    template <typename System>
+    int run_soa(const batch_config &config, const System &system, std::size_t n, std::istream &in, std::ostream &out)
+    {
+        const miv::matrix<T> starts = read_starts(in, n);
+
+        // Блоки дорожек — задачи общего пула: --jobs не больше его потоков
+        if (config.jobs > miv::exec::thread_count())
+        {
+            miv::exec::set_thread_count(config.jobs);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto result = miv::math::solve_batch(system, starts, config.options, config.lanes);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (config.header)
+        {
+            out << "index,status,iterations,residual_norm";
+            for (std::size_t i = 1; i <= n; ++i)
+            {
+                out << ",x" << i;
+            }
+            out << '\n';
+        }
+
+        out << std::setprecision(std::numeric_limits<T>::max_digits10);
+        for (std::size_t l = 0; l < result.lanes(); ++l)
+        {
+            out << (l + 1) << ',' << miv::math::to_string(result.status[l]) << ',' << result.iterations[l] << ','
+                << static_cast<T>(result.residual_norm[l]);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                out << ',' << result.x(i, l);
+            }
+            out << '\n';
+        }
+        out << std::flush;
+
+        using miv::math::lane_status;
+        std::cerr << "Задач: " << result.lanes() << ", сошлось: " << result.count(lane_status::converged)
+                  << ", вырождено: " << result.count(lane_status::singular)
+                  << ", расходимость: " << result.count(lane_status::diverged)
+                  << ", потоков: " << miv::exec::thread_count() << ", время: " << std::fixed << std::setprecision(3)
+                  << ms << " мс\n";
+
+        return 0;
+    }
+
+    /**
+     * @brief Мульти-старт: все старты сразу (из входа или сгенерированные), вывод — разные корни.
+     */
+    template <typename System>
+    int run_multi_start(
+        const batch_config &config,
+        const System &system,
+        std::size_t n,
+        const solver_setup &setup,
+        std::istream &in,
+        std::ostream &out)
+    {
+        miv::matrix<T> starts;
+        if (config.starts > 0)
+        {
+            miv::array<T> lower(n);
+            miv::array<T> upper(n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                lower[i] = config.box_lower;
+                upper[i] = config.box_upper;
+            }
+            starts = miv::math::make_uniform_starts(lower, upper, config.starts, config.seed);
+        }
+        else
+        {
+            starts = read_starts(in, n);
+        }
+
+        // Дорожки мульти-старта — задачи общего пула: --jobs не больше его потоков
+        if (config.jobs > miv::exec::thread_count())
+        {
+            miv::exec::set_thread_count(config.jobs);
+        }
+
+        const auto result = miv::math::solve_multi_start(system, starts, config.multi, [&]
+        {
+            return make_solver(config, system, setup);
+        });
+
+        if (config.header)
+        {
+            out << "root,hits,start,residual_norm";
+            for (std::size_t i = 1; i <= n; ++i)
+            {
+                out << ",x" << i;
+            }
+            out << '\n';
+        }
+
+        out << std::setprecision(std::numeric_limits<T>::max_digits10);
+        for (std::size_t r = 0; r < result.roots.size(); ++r)
+        {
+            const auto &root = result.roots[r];
+            out << (r + 1) << ',' << root.hits << ',' << (root.start + 1) << ',' << static_cast<T>(root.residual_norm);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                out << ',' << root.x[i];
+            }
+            out << '\n';
+        }
+        out << std::flush;
+
+        for (std::size_t s = 0; s < result.starts(); ++s)
+        {
+            if (result.status[s] == miv::math::start_status::failed)
+            {
+                std::cerr << "старт " << (s + 1) << ": " << result.errors[s] << "\n";
+            }
+        }
+
+        using miv::math::start_status;
+        const double ms = std::chrono::duration<double, std::milli>(result.elapsed).count();
+        std::cerr << "Стартов: " << result.starts() << ", корней: " << result.roots.size()
+                  << ", повторов: " << result.count(start_status::duplicate)
+                  << ", расходимость: " << result.count(start_status::diverged)
+                  << ", не сошлось: " << result.count(start_status::not_converged)
+                  << ", ошибок: " << result.count(start_status::failed)
+                  << ", отменено: " << result.count(start_status::cancelled) << ", потоков: " << config.jobs
+                  << ", время: " << std::fixed << std::setprecision(3) << ms << " мс\n";
+
+        return 0;
+    }
+
+    template <typename System>
+    int run_problems(
+        const batch_config &config,
+        const System &system,
+        std::size_t n,
+        std::istream &in,
+        std::ostream &out)
+    {
+        if (config.soa)
+        {
+            return run_soa(config, system, n, in, out);
+        }
+
+        solver_setup setup;
+
+        if (config.options.jacobian == JacobianMode::Manual)
+        {
+            setup.J_manual = miv::io::load_matrix<T>(config.jacobian_file);
+            if (setup.J_manual.rows() != n || setup.J_manual.cols() != n)
+            {
+                throw std::invalid_argument("jacobian-file must hold a " + std::to_string(n) + "x" +
+                                            std::to_string(n) + " matrix");
+            }
+        }
+
+        // Шаблон из functions.cpp — общий для всех потоков; иначе каждый найдёт его в своей первой точке
+        if (config.options.jacobian == JacobianMode::Sparse)
+        {
+            if (const auto deps = get_system_sparsity(); !deps.empty())
+            {
+                setup.pattern = miv::math::sparsity_pattern::from_rows(n, deps);
+            }
+        }
+
+        if (config.multi_start)
+        {
+            return run_multi_start(config, system, n, setup, in, out);
+        }
+
+        std::unique_ptr<miv::io::trace_writer> trace;
+        if (const char *env = std::getenv("QM_TRACE"); env && *env != '\0')
+        {
+            trace = std::make_unique<miv::io::trace_writer>(env);
+        }
+
+        if (config.header)
+        {
+            out << "index,status,iterations,residual_norm";
+            for (std::size_t i = 1; i <= n; ++i)
+            {
+                out << ",x" << i;
+            }
+            out << '\n' << std::flush;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        batch_output output(out);
+        problem_queue queue(4 * config.jobs);
+
+        std::vector<std::thread> workers;
+        workers.reserve(config.jobs);
+        for (std::size_t w = 0; w < config.jobs; ++w)
+        {
+            workers.emplace_back([&]
+            {
+                run_worker(config, system, n, setup, queue, output, trace.get());
+            });
+        }
+
+        std::string line;
+        std::size_t index = 0;
+        while (std::getline(in, line))
+        {
+            const std::string_view text = trim(line);
+            if (text.empty() || text.starts_with('#'))
+            {
+                continue;
+            }
+            queue.push({ ++index, line });
+        }
+        queue.close();
+
+        for (auto &t : workers)
+        {
+            t.join();
+        }
+
+        if (trace)
+        {
+            trace->flush();
+        }
+
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cerr << "Задач: " << output.solved << ", сошлось: " << output.converged << ", ошибок: " << output.failed;
+        if (config.options.cache_bytes > 0)
+        {
+            std::cerr << ", из кэша разложений: " << output.cache_hits;
+        }
+        std::cerr << ", потоков: " << config.jobs << ", время: " << std::fixed << std::setprecision(3) << ms
+                  << " мс\n";
+
+        return 0;
+    }
+}
+
+int run_batch(int argc, char **argv)
+{
+    std::optional<batch_config> config;
+    try
+    {
+        config = parse_arguments(argc, argv);
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Ошибка: " << ex.what() << "\n\n";
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    if (!config)
+    {
+        print_usage(argv[0]);
+        return 0;
+    }
+
+    try
+    {
+        const auto functions = get_system_functions();
+        const std::size_t n = functions.size();
+        if (n == 0)
+        {
+            throw std::runtime_error("the system has no functions (get_system_functions)");
+        }
+
+        std::ifstream in_file;
+        std::ofstream out_file;
+
+        if (config->input != "-")
+        {
+            in_file.open(config->input);
+            if (!in_file)
+            {
+                throw std::runtime_error("cannot open input '" + config->input + "'");
+            }
+        }
+        if (config->output != "-")
+        {
+            out_file.open(config->output);
+            if (!out_file)
+            {
+                throw std::runtime_error("cannot open output '" + config->output + "'");
+            }
+        }
+
+        std::istream &in = (config->input != "-") ? static_cast<std::istream &>(in_file) : std::cin;
+        std::ostream &out = (config->output != "-") ? static_cast<std::ostream &>(out_file) : std::cout;
+
+        if constexpr (HasSystemVector)
+        {
+            const auto system = miv::math::make_vector_system(n, [](auto xv, auto values)
+            {
+                system_vector(xv, values);
+            });
+            return run_problems(*config, system, n, in, out);
+        }
+        else
+        {
+            return run_problems(*config, functions, n, in, out);
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Ошибка: " << ex.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef QM_BATCH_HPP
+#define QM_BATCH_HPP
+
+/**
+ * @file batch.hpp
+ * @brief Неинтерактивный режим my_prog: параметры из командной строки и файла
+ *        конфигурации, поток начальных приближений, результаты по мере готовности.
+ *
+ * @details
+ * my_prog без аргументов открывает меню; с любыми аргументами работает пакетно:
+ * @code
+ * my_prog --method newton --jacobian sparse --jobs 8 --input starts.txt --output results.csv
+ * my_prog --config run.conf < starts.txt
+ * @endcode
+ *
+ * Все параметры и их допустимые значения — my_prog --help.
+ */
+
+/**
+ * @brief Выполнить пакетный режим.
+ *
+ * @param argc, argv аргументы my_prog
+ * @return код завершения процесса: 0 — все задачи обработаны, 1 — ошибка
+ *         ввода/вывода, 2 — неверные параметры
+ */
+int run_batch(int argc, char **argv);
+
+#endif // QM_BATCH_HPP
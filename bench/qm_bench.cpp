@@ -0,0 +1,536 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if __has_include(<stdfloat>)
+    #include <stdfloat>
+#endif
+
+#include "containers/array.hpp"
+#include "containers/matrix.hpp"
+#include "exec/thread_pool.hpp"
+#include "math/equation_system.hpp"
+#include "math/jacobian.hpp"
+#include "math/linalg.hpp"
+
+/**
+ * @file qm_bench.cpp
+ * @brief Замеры базовых ядер miv::math в формате JSON (как у Google Benchmark).
+ *
+ * Использование:
+ *   qm_bench [--out FILE] [--filter SUBSTR] [--sizes 4,16,64] [--max-n N] [--min-time SEC]
+ *
+ * Каждое ядро прогоняется для n = 4, 16, 64, 256, 1024, 4096 и типов
+ * float32, float64, float80 (long double) и float128 (если есть std::float128_t).
+ * Число повторов подбирается так, чтобы замер длился не меньше --min-time
+ * (по умолчанию 0.2 с). real_time и cpu_time — на один повтор, в наносекундах;
+ * cpu_time — процессорное время всех потоков. Векторные ядра (norm_l2, dot)
+ * работают с n^2 элементами, чтобы объём данных совпадал с матричными.
+ *
+ * Кубические ядра (matmul, solve_lup) при n = 4096 в long double идут минутами
+ * и требуют ~0.8 ГБ; для быстрых прогонов есть --max-n.
+ */
+
+namespace
+{
+    // ============================================================
+    //                           Харнесс
+    // ============================================================
+
+    /**
+     * @brief Не дать компилятору выбросить вычисление результата.
+     */
+    template <typename V>
+    inline void do_not_optimize(const V &value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+
+    struct bench_options
+    {
+        std::string out;
+        std::string filter;
+        std::vector<std::size_t> sizes = { 4, 16, 64, 256, 1024, 4096 };
+        double min_time = 0.2;
+    };
+
+    struct bench_result
+    {
+        std::string name;
+        std::string kernel;
+        std::string precision;
+        std::size_t n = 0;
+        std::uint64_t iterations = 0;
+        double real_ns = 0;    ///< на один повтор
+        double cpu_ns = 0;     ///< на один повтор
+        double bytes = 0;      ///< байт, затронутых одним повтором (0 — не считается)
+        double items = 0;      ///< операций одного повтора (0 — не считается)
+    };
+
+    /**
+     * @brief Прогнать body() столько раз, чтобы замер занял не меньше min_time.
+     *
+     * Как в Google Benchmark: пробный прогон, затем число повторов растёт по
+     * оценке времени одного повтора (не больше чем в 10 раз за шаг).
+     */
+    template <typename Body>
+    bench_result measure(Body &&body, double min_time)
+    {
+        std::uint64_t iterations = 1;
+
+        while (true)
+        {
+            const std::clock_t cpu_start = std::clock();
+            const auto start = std::chrono::steady_clock::now();
+
+            for (std::uint64_t i = 0; i < iterations; ++i)
+            {
+                body();
+            }
+
+            const double real = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            const double cpu = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+            if (real >= min_time || iterations >= 1'000'000'000)
+            {
+                bench_result r;
+                r.iterations = iterations;
+                r.real_ns = real * 1e9 / static_cast<double>(iterations);
+                r.cpu_ns = cpu * 1e9 / static_cast<double>(iterations);
+                return r;
+            }
+
+            // Долгий одиночный повтор (кубические ядра на больших n) — не повторяем
+            if (iterations == 1 && real >= min_time / 10 && real * 2 >= min_time)
+            {
+                iterations = 2;
+                continue;
+            }
+
+            const double per_iteration = std::max(real / static_cast<double>(iterations), 1e-9);
+            const double wanted = 1.4 * min_time / per_iteration;
+            iterations = std::clamp<std::uint64_t>(static_cast<std::uint64_t>(wanted), iterations + 1, iterations * 10);
+        }
+    }
+
+    class bench_registry
+    {
+    public:
+        explicit bench_registry(const bench_options &options) : m_options(options) {}
+
+        /**
+         * @brief Зарегистрировать и сразу прогнать замер kernel/precision/n.
+         *
+         * make() готовит данные (вне замера) и возвращает тело одного повтора.
+         */
+        template <typename Make>
+        void run(std::string_view kernel, std::string_view precision, std::size_t n, double bytes, double items,
+                 Make &&make)
+        {
+            std::string name = std::string(kernel) + "/" + std::string(precision) + "/" + std::to_string(n);
+            if (!m_options.filter.empty() && name.find(m_options.filter) == std::string::npos)
+            {
+                return;
+            }
+
+            auto body = make();
+            body();   // прогрев: страницы, буферы построителей, пул потоков
+
+            bench_result r = measure(body, m_options.min_time);
+            r.name = std::move(name);
+            r.kernel = kernel;
+            r.precision = precision;
+            r.n = n;
+            r.bytes = bytes;
+            r.items = items;
+
+            std::fprintf(stderr, "%-40s %14.0f ns %14.0f ns cpu %10llu\n", r.name.c_str(), r.real_ns, r.cpu_ns,
+                         static_cast<unsigned long long>(r.iterations));
+            m_results.push_back(std::move(r));
+        }
+
+        const std::vector<bench_result> &results() const { return m_results; }
+
+    private:
+        const bench_options &m_options;
+        std::vector<bench_result> m_results;
+    };
+
+    // ============================================================
+    //                    Данные и тестовая система
+    // ============================================================
+
+    template <typename T>
+    miv::matrix<T> random_matrix(std::size_t rows, std::size_t cols, std::uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+        miv::matrix<T> m(rows, cols, miv::uninitialized);
+        for (std::size_t i = 0; i < m.size(); ++i)
+        {
+            m.data()[i] = static_cast<T>(dist(rng));
+        }
+        return m;
+    }
+
+    /**
+     * @brief Хорошо обусловленная A: случайная плюс n на диагонали.
+     */
+    template <typename T>
+    miv::matrix<T> dominant_matrix(std::size_t n, std::uint32_t seed)
+    {
+        auto a = random_matrix<T>(n, n, seed);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            a(i, i) += static_cast<T>(n);
+        }
+        return a;
+    }
+
+    miv::array<std::size_t> random_permutation(std::size_t n, std::uint32_t seed)
+    {
+        std::vector<std::size_t> p(n);
+        std::iota(p.begin(), p.end(), std::size_t{ 0 });
+        std::shuffle(p.begin(), p.end(), std::mt19937(seed));
+
+        miv::array<std::size_t> perm(n);
+        std::copy(p.begin(), p.end(), perm.begin());
+        return perm;
+    }
+
+    /**
+     * @brief Компонента трёхдиагональной системы: F_i = 3 x_i - x_{i-1} - x_{i+1} + x_i^2 - 1.
+     */
+    template <typename T>
+    struct tridiagonal_component
+    {
+        std::size_t i;
+
+        T operator()(miv::array<T> &x) const
+        {
+            const std::size_t n = x.size();
+            const T left = (i > 0) ? x[i - 1] : T{};
+            const T right = (i + 1 < n) ? x[i + 1] : T{};
+            return static_cast<T>(3) * x[i] - left - right + x[i] * x[i] - static_cast<T>(1);
+        }
+    };
+
+    // ============================================================
+    //                            Ядра
+    // ============================================================
+
+    template <typename T>
+    void run_kernels(bench_registry &bench, std::string_view precision, std::size_t n)
+    {
+        const double elem = sizeof(T);
+        const double nn = static_cast<double>(n) * static_cast<double>(n);
+
+        bench.run("matmul", precision, n, 3 * nn * elem, 2 * nn * static_cast<double>(n), [&]
+        {
+            return [a = random_matrix<T>(n, n, 1), b = random_matrix<T>(n, n, 2), out = miv::matrix<T>()]() mutable
+            {
+                miv::math::matmul_into(a, b, out);
+                do_not_optimize(out.data()[0]);
+            };
+        });
+
+        bench.run("transpose", precision, n, 2 * nn * elem, nn, [&]
+        {
+            return [a = random_matrix<T>(n, n, 3)]
+            {
+                auto t = miv::math::transpose(a);
+                do_not_optimize(t.data()[0]);
+            };
+        });
+
+        bench.run("norm_l2", precision, n, nn * elem, nn, [&]
+        {
+            return [a = random_matrix<T>(n, n, 4)]
+            {
+                do_not_optimize(miv::math::norm_l2(a));
+            };
+        });
+
+        bench.run("dot", precision, n, 2 * nn * elem, nn, [&]
+        {
+            // dot() принимает векторы: столбцы из n^2 элементов, как у norm_l2 выше
+            return [a = random_matrix<T>(n * n, 1, 5), b = random_matrix<T>(n * n, 1, 6)]
+            {
+                do_not_optimize(miv::math::dot(a, b));
+            };
+        });
+
+        for (const auto mode : { miv::math::lup_mode::packed, miv::math::lup_mode::blocked })
+        {
+            const char *kernel = (mode == miv::math::lup_mode::packed) ? "solve_lup_packed" : "solve_lup_blocked";
+            bench.run(kernel, precision, n, nn * elem, 2.0 / 3.0 * nn * static_cast<double>(n), [&]
+            {
+                return [system = miv::math::equation_system<T>(dominant_matrix<T>(n, 7), random_matrix<T>(n, 1, 8)),
+                        mode]
+                {
+                    auto x = system.solve_lup(mode);
+                    do_not_optimize(x.data()[0]);
+                };
+            });
+        }
+
+        bench.run("row_permute", precision, n, 2 * nn * elem, nn, [&]
+        {
+            return [m = random_matrix<T>(n, n, 9), perm = random_permutation(n, 10)]() mutable
+            {
+                m.row_permute(perm);
+                do_not_optimize(m.data()[0]);
+            };
+        });
+
+        bench.run("col_permute", precision, n, 2 * nn * elem, nn, [&]
+        {
+            return [m = random_matrix<T>(n, n, 11), perm = random_permutation(n, 12)]() mutable
+            {
+                m.col_permute(perm);
+                do_not_optimize(m.data()[0]);
+            };
+        });
+
+        // Якобиан: n + 1 (двухузловая) и 2n (трёхузловая) вычислений F по n компонент
+        auto make_jacobian = [&](bool three_point)
+        {
+            return [&, three_point]
+            {
+                std::vector<tridiagonal_component<T>> functions;
+                functions.reserve(n);
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    functions.push_back({ i });
+                }
+
+                miv::array<T> x(n);
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    x[i] = static_cast<T>(0.5) + static_cast<T>(i % 7) / static_cast<T>(10);
+                }
+
+                return [functions = std::move(functions), x = std::move(x), J = miv::matrix<T>(),
+                        builder = miv::math::jacobian_builder<T>(), three_point]() mutable
+                {
+                    if (three_point)
+                    {
+                        builder.build_three_point(x, functions, J);
+                    }
+                    else
+                    {
+                        builder.build_two_point(x, functions, J);
+                    }
+                    do_not_optimize(J.data()[0]);
+                };
+            };
+        };
+
+        bench.run("jacobian_two_point", precision, n, nn * elem, (static_cast<double>(n) + 1) * n, make_jacobian(false));
+        bench.run("jacobian_three_point", precision, n, nn * elem, 2 * nn, make_jacobian(true));
+    }
+
+    // ============================================================
+    //                             JSON
+    // ============================================================
+
+    std::string json_escape(std::string_view s)
+    {
+        std::string out;
+        for (const char c : s)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out;
+    }
+
+    void write_json(std::ostream &out, const bench_options &options, const std::vector<bench_result> &results)
+    {
+        const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+#ifdef NDEBUG
+        const char *build_type = "release";
+#else
+        const char *build_type = "debug";
+#endif
+
+        out << "{\n  \"context\": {\n"
+            << "    \"date\": \"" << date << "\",\n"
+            << "    \"executable\": \"qm_bench\",\n"
+            << "    \"num_threads\": " << miv::exec::thread_count() << ",\n"
+            << "    \"library_build_type\": \"" << build_type << "\",\n"
+            << "    \"min_time\": " << options.min_time << "\n"
+            << "  },\n  \"benchmarks\": [";
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const auto &r = results[i];
+            const double seconds = r.real_ns * 1e-9;
+
+            out << (i == 0 ? "\n" : ",\n")
+                << "    {\n"
+                << "      \"name\": \"" << json_escape(r.name) << "\",\n"
+                << "      \"kernel\": \"" << json_escape(r.kernel) << "\",\n"
+                << "      \"precision\": \"" << json_escape(r.precision) << "\",\n"
+                << "      \"n\": " << r.n << ",\n"
+                << "      \"iterations\": " << r.iterations << ",\n"
+                << "      \"real_time\": " << r.real_ns << ",\n"
+                << "      \"cpu_time\": " << r.cpu_ns << ",\n"
+                << "      \"time_unit\": \"ns\"";
+
+            if (r.bytes > 0 && seconds > 0)
+            {
+                out << ",\n      \"bytes_per_second\": " << r.bytes / seconds;
+            }
+            if (r.items > 0 && seconds > 0)
+            {
+                out << ",\n      \"items_per_second\": " << r.items / seconds;
+            }
+            out << "\n    }";
+        }
+
+        out << "\n  ]\n}\n";
+    }
+
+    void print_usage(const char *program)
+    {
+        std::cerr << "Использование: " << program
+                  << " [--out FILE] [--filter SUBSTR] [--sizes 4,16,64] [--max-n N] [--min-time SEC]\n";
+    }
+
+    std::vector<std::size_t> parse_sizes(const std::string &text)
+    {
+        std::vector<std::size_t> sizes;
+        std::istringstream ss(text);
+        std::string item;
+        while (std::getline(ss, item, ','))
+        {
+            const long long v = std::stoll(item);
+            if (v <= 0)
+            {
+                throw std::invalid_argument("sizes must be positive");
+            }
+            sizes.push_back(static_cast<std::size_t>(v));
+        }
+        return sizes;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bench_options options;
+    std::size_t max_n = 0;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string_view arg = argv[i];
+            if (i + 1 >= argc)
+            {
+                print_usage(argv[0]);
+                return 2;
+            }
+
+            const std::string value = argv[++i];
+            if (arg == "--out")
+            {
+                options.out = value;
+            }
+            else if (arg == "--filter")
+            {
+                options.filter = value;
+            }
+            else if (arg == "--sizes")
+            {
+                options.sizes = parse_sizes(value);
+            }
+            else if (arg == "--max-n")
+            {
+                max_n = static_cast<std::size_t>(std::stoull(value));
+            }
+            else if (arg == "--min-time")
+            {
+                options.min_time = std::stod(value);
+            }
+            else
+            {
+                print_usage(argv[0]);
+                return 2;
+            }
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Ошибка: " << ex.what() << "\n";
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    if (max_n > 0)
+    {
+        std::erase_if(options.sizes, [&](std::size_t n) { return n > max_n; });
+    }
+
+    bench_registry bench(options);
+
+    try
+    {
+        for (const std::size_t n : options.sizes)
+        {
+            run_kernels<float>(bench, "float32", n);
+            run_kernels<double>(bench, "float64", n);
+            run_kernels<long double>(bench, "float80", n);
+#ifdef __STDCPP_FLOAT128_T__
+            run_kernels<std::float128_t>(bench, "float128", n);
+#endif
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Ошибка: " << ex.what() << "\n";
+        return 1;
+    }
+
+    if (options.out.empty())
+    {
+        write_json(std::cout, options, bench.results());
+    }
+    else
+    {
+        std::ofstream out(options.out);
+        if (!out)
+        {
+            std::cerr << "Ошибка: не удалось открыть " << options.out << "\n";
+            return 1;
+        }
+        write_json(out, options, bench.results());
+    }
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#ifndef MIV_CONTAINERS_ALIGNED_ALLOCATOR_H
+#define MIV_CONTAINERS_ALIGNED_ALLOCATOR_H
+
+#include <new>
+#include <cstddef>
+#include <type_traits>
+
+#include "profile.hpp"
+
+namespace miv
+{
+    // Default alignment of container storage: one cache line.
+    //
+    // 64 bytes covers every SIMD width we target (SSE 16, AVX 32, AVX-512 64),
+    // so row 0 of any miv::matrix and every miv::array start on a vector boundary.
+    inline constexpr std::size_t default_alignment = 64;
+
+    // Stateless allocator returning storage aligned to max(alignment, alignof(type)).
+    template <typename type, std::size_t alignment = default_alignment>
+    class aligned_allocator
+    {
+        static_assert(alignment != 0 && (alignment & (alignment - 1)) == 0,
+                      "aligned_allocator: alignment must be a power of two");
+
+    public:
+        using value_type = type;
+
+        using propagate_on_container_move_assignment = std::true_type;
+        using is_always_equal = std::true_type;
+
+        // actual alignment of every allocation
+        static constexpr std::size_t effective_alignment = (alignment > alignof(type)) ? alignment : alignof(type);
+
+        // the non-type parameter makes the default rebind unusable
+        template <typename other_type>
+        struct rebind
+        {
+            using other = aligned_allocator<other_type, alignment>;
+        };
+
+        aligned_allocator() noexcept = default;
+
+        template <typename other>
+        aligned_allocator(const aligned_allocator<other, alignment> &) noexcept;
+
+        type *allocate(std::size_t count);
+        void deallocate(type *ptr, std::size_t count) noexcept;
+
+        template <typename other>
+        bool operator==(const aligned_allocator<other, alignment> &) const noexcept;
+    };
+
+    template <typename type, std::size_t alignment>
+    template <typename other>
+    inline aligned_allocator<type, alignment>::aligned_allocator(const aligned_allocator<other, alignment> &) noexcept {}
+
+    template <typename type, std::size_t alignment>
+    inline type *aligned_allocator<type, alignment>::allocate(std::size_t count)
+    {
+        if (count > static_cast<std::size_t>(-1) / sizeof(type))
+        {
+            throw std::bad_array_new_length();
+        }
+
+        MIV_PROFILE_ALLOCATION(count * sizeof(type));
+        return static_cast<type *>(::operator new(count * sizeof(type), std::align_val_t{ effective_alignment }));
+    }
+
+    template <typename type, std::size_t alignment>
+    inline void aligned_allocator<type, alignment>::deallocate(type *ptr, std::size_t) noexcept
+    {
+        ::operator delete(ptr, std::align_val_t{ effective_alignment });
+    }
+
+    template <typename type, std::size_t alignment>
+    template <typename other>
+    inline bool aligned_allocator<type, alignment>::operator==(const aligned_allocator<other, alignment> &) const noexcept
+    {
+        return true;
+    }
+}
+
+#endif // MIV_CONTAINERS_ALIGNED_ALLOCATOR_H
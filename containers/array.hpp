@@ -2,28 +2,73 @@
 #define MIV_CONTAINERS_ARRAY_H
 
 #include <string>
+#include <memory>
 #include <cstddef>
+#include <utility>
 #include <algorithm>
 #include <stdexcept>
+#include <type_traits>
 #include <initializer_list>
 
+#include "aligned_allocator.hpp"
+#include "profile.hpp"
+
 namespace miv
 {
-    template <typename type>
+    // Tag for constructors that skip element initialization:
+    //
+    //   miv::array<double> tmp(n, miv::uninitialized);   // one pass fewer over memory
+    //
+    // Only for trivially default constructible types; the contents are indeterminate
+    // until written, so use it when every element is overwritten anyway.
+    struct uninitialized_t
+    {
+        explicit uninitialized_t() = default;
+    };
+
+    inline constexpr uninitialized_t uninitialized{};
+
+    // Heap array with a size and a capacity.
+    //
+    // The storage comes from `allocator`. The default miv::aligned_allocator
+    // returns 64-byte aligned memory (see aligned_allocator.hpp), everything else
+    // behaves like the classic new type[size]() array. Passing
+    // miv::workspace_allocator makes the array draw from a per-iteration arena:
+    //
+    //   miv::array<double, miv::workspace_allocator<double>> tmp(n, ws);
+    //
+    // Elements are value-initialized unless the uninitialized tag is used.
+    // resize() within capacity() never reallocates; reserve() grows ahead of time.
+    template <typename type, typename allocator = miv::aligned_allocator<type>>
     class array
     {
     public:
+        using value_type = type;
+        using allocator_type = allocator;
+
         // basic constructors
         array();
         array(std::size_t size);
-        array(const array<type> &obj);
-        array(array<type> &&obj) noexcept;
+        array(const array &obj);
+        array(array &&obj) noexcept;
 
         // extra constructors
         array(std::initializer_list<type> init);
         array(const type *data, std::size_t size);
         array(type *data, std::size_t size); // copy-only, no stealing
 
+        // size elements left uninitialized (trivially default constructible types only)
+        array(std::size_t size, uninitialized_t) requires std::is_trivially_default_constructible_v<type>;
+
+        // allocator-aware constructors
+        explicit array(const allocator &alloc);
+        array(std::size_t size, const allocator &alloc);
+        array(std::size_t size, uninitialized_t, const allocator &alloc)
+            requires std::is_trivially_default_constructible_v<type>;
+        array(const type *data, std::size_t size, const allocator &alloc);
+
+        allocator get_allocator() const;
+
         // methods
         type* data();
         const type* data() const;
@@ -31,9 +76,22 @@ namespace miv
 
         bool empty() const;
 
+        // capacity model:
+        // - capacity() >= size() elements are allocated
+        // - reserve(n) makes capacity() >= n (existing elements are kept)
+        // - resize() within capacity() only constructs/destroys the tail
+        // - shrink_to_fit() drops the unused part
+        std::size_t capacity() const;
+        void reserve(std::size_t new_capacity);
+        void shrink_to_fit();
+
+        // clear() releases the memory (size and capacity become 0)
         void clear();
         void fill(const type &value);
+
+        // new elements are value-initialized (or left uninitialized with the tag)
         void resize(std::size_t new_size);
+        void resize(std::size_t new_size, uninitialized_t) requires std::is_trivially_default_constructible_v<type>;
 
         type &front();
         const type &front() const;
@@ -78,207 +136,402 @@ namespace miv
         const type* cend() const;
 
         // operators
-        array<type> &operator=(const array<type> &obj);
-        array<type> &operator=(array<type> &&obj) noexcept;
+        //
+        // Copy assignment reuses the buffer when obj fits into capacity()
+        // (no allocation), which keeps `x_old = x` cheap in iteration loops.
+        array &operator=(const array &obj);
+        array &operator=(array &&obj) noexcept(std::allocator_traits<allocator>::propagate_on_container_move_assignment::value ||
+                                               std::allocator_traits<allocator>::is_always_equal::value);
 
         type &operator[](std::size_t idx);
         const type &operator[](std::size_t idx) const;
 
-        bool operator==(const array<type> &other) const;
-        bool operator!=(const array<type> &other) const;
+        bool operator==(const array &other) const;
+        bool operator!=(const array &other) const;
 
         ~array();
     
     private:
+        using traits = std::allocator_traits<allocator>;
+
+        enum class init_mode
+        {
+            value,   // type{}
+            none     // default-initialization (no-op for trivial types)
+        };
+
+        // allocate exactly `size` elements and construct them; nothing leaks on throw
+        type *allocate_buffer(std::size_t size, init_mode mode);
+        type *allocate_copy(const type *src, std::size_t size);
+
+        // construct elements [m_size, new_size) inside the current capacity
+        void construct_tail(std::size_t new_size, init_mode mode);
+
+        // move the elements into a fresh buffer of `new_capacity` elements
+        void reallocate(std::size_t new_capacity);
+
+        void resize_impl(std::size_t new_size, init_mode mode);
+
+        // destroy + deallocate the current buffer
+        void release() noexcept;
+
+        [[no_unique_address]] allocator m_alloc;
         type* m_data;
         std::size_t m_size;
+        std::size_t m_capacity;
     };
 
-    // construsctors
-    template <typename type>
-    inline array<type>::array() : m_data(nullptr), m_size(0) {}
-
-    template <typename type>
-    inline array<type>::array(std::size_t size) : m_data(new type[size]), m_size(size) {}
-
-    template <typename type>
-    inline array<type>::array(std::initializer_list<type> init) : m_data(nullptr), m_size(0)
+    // buffer helpers
+    template <typename type, typename allocator>
+    inline type *array<type, allocator>::allocate_buffer(std::size_t size, init_mode mode)
     {
-        if (init.size() == 0)
+        if (size == 0)
         {
-            return;
+            return nullptr;
         }
 
-        type *buffer = new type[init.size()];
+        type *buffer = traits::allocate(m_alloc, size);
 
         try
         {
-            std::copy(init.begin(), init.end(), buffer);
+            if (mode == init_mode::value)
+            {
+                std::uninitialized_value_construct_n(buffer, size);
+            }
+            else
+            {
+                std::uninitialized_default_construct_n(buffer, size);
+            }
         }
         catch (...)
         {
-            delete[] buffer;
+            traits::deallocate(m_alloc, buffer, size);
             throw;
         }
 
-        m_data = buffer;
-        m_size = init.size();
+        return buffer;
     }
 
-    template <typename type>
-    inline array<type>::array(const type *data, std::size_t size) : m_data(nullptr), m_size(0)
+    template <typename type, typename allocator>
+    inline type *array<type, allocator>::allocate_copy(const type *src, std::size_t size)
     {
         if (size == 0)
         {
-            return;
+            return nullptr;
         }
 
-        if (data == nullptr)
+        type *buffer = traits::allocate(m_alloc, size);
+
+        try
         {
-            throw std::invalid_argument("Input pointer is nullptr but size is not zero");
+            std::uninitialized_copy_n(src, size, buffer);
+            MIV_PROFILE_BYTES_MOVED(size * sizeof(type));
+        }
+        catch (...)
+        {
+            traits::deallocate(m_alloc, buffer, size);
+            throw;
+        }
+
+        return buffer;
+    }
+
+    template <typename type, typename allocator>
+    inline void array<type, allocator>::construct_tail(std::size_t new_size, init_mode mode)
+    {
+        if (mode == init_mode::value)
+        {
+            std::uninitialized_value_construct_n(m_data + m_size, new_size - m_size);
+        }
+        else
+        {
+            std::uninitialized_default_construct_n(m_data + m_size, new_size - m_size);
         }
+    }
 
-        type *buffer = new type[size];
+    template <typename type, typename allocator>
+    inline void array<type, allocator>::reallocate(std::size_t new_capacity)
+    {
+        type *buffer = traits::allocate(m_alloc, new_capacity);
 
         try
         {
-            std::copy(data, data + size, buffer);
+            // move when it cannot throw, otherwise copy (the old buffer stays intact on throw)
+            if constexpr (std::is_nothrow_move_constructible_v<type>)
+            {
+                std::uninitialized_move_n(m_data, m_size, buffer);
+            }
+            else
+            {
+                std::uninitialized_copy_n(m_data, m_size, buffer);
+            }
+            MIV_PROFILE_BYTES_MOVED(m_size * sizeof(type));
         }
         catch (...)
         {
-            delete[] buffer;
+            traits::deallocate(m_alloc, buffer, new_capacity);
             throw;
         }
 
+        const std::size_t size = m_size;
+        release();
+
         m_data = buffer;
         m_size = size;
+        m_capacity = new_capacity;
     }
 
-    template <typename type>
-    inline array<type>::array(type *data, std::size_t size) : array(static_cast<const type*>(data), size)
+    template <typename type, typename allocator>
+    inline void array<type, allocator>::release() noexcept
     {
-        // copy-only by design
+        if (m_data != nullptr)
+        {
+            std::destroy_n(m_data, m_size);
+            traits::deallocate(m_alloc, m_data, m_capacity);
+        }
+
+        m_data = nullptr;
+        m_size = 0;
+        m_capacity = 0;
     }
 
-    template <typename type>
-    inline array<type>::~array()
+    // construsctors
+    template <typename type, typename allocator>
+    inline array<type, allocator>::array() : m_alloc(), m_data(nullptr), m_size(0), m_capacity(0) {}
+
+    template <typename type, typename allocator>
+    inline array<type, allocator>::array(std::size_t size) : m_alloc(), m_data(nullptr), m_size(0), m_capacity(0)
     {
-        delete[] m_data;
-        m_size = 0;
-        m_data = nullptr;
+        m_data = allocate_buffer(size, init_mode::value);
+        m_size = size;
+        m_capacity = size;
+    }
+
+    template <typename type, typename allocator>
+    inline array<type, allocator>::array(std::size_t size, uninitialized_t)
+        requires std::is_trivially_default_constructible_v<type>
+        : m_alloc(), m_data(nullptr), m_size(0), m_capacity(0)
+    {
+        m_data = allocate_buffer(size, init_mode::none);
+        m_size = size;
+        m_capacity = size;
     }
 
-    template <typename type>
-    inline array<type>::array(const array<type> &obj)
+    template <typename type, typename allocator>
+    inline array<type, allocator>::array(const allocator &alloc)
+        : m_alloc(alloc), m_data(nullptr), m_size(0), m_capacity(0) {}
+
+    template <typename type, typename allocator>
+    inline array<type, allocator>::array(std::size_t size, const allocator &alloc)
+        : m_alloc(alloc), m_data(nullptr), m_size(0), m_capacity(0)
     {
-        type *buffer = new type[obj.m_size];
+        m_data = allocate_buffer(size, init_mode::value);
+        m_size = size;
+        m_capacity = size;
+    }
 
-        try
+    template <typename type, typename allocator>
+    inline array<type, allocator>::array(std::size_t size, uninitialized_t, const allocator &alloc)
+        requires std::is_trivially_default_constructible_v<type>
+        : m_alloc(alloc), m_data(nullptr), m_size(0), m_capacity(0)
+    {
+        m_data = allocate_buffer(size, init_mode::none);
+        m_size = size;
+        m_capacity = size;
+    }
+
+    template <typename type, typename allocator>
+    inline array<type, allocator>::array(std::initializer_list<type> init)
+        : m_alloc(), m_data(nullptr), m_size(0), m_capacity(0)
+    {
+        if (init.size() == 0)
         {
-            std::copy(obj.m_data, obj.m_data + obj.m_size, buffer);
+            return;
         }
-        catch (...)
+
+        m_data = allocate_copy(init.begin(), init.size());
+        m_size = init.size();
+        m_capacity = init.size();
+    }
+
+    template <typename type, typename allocator>
+    inline array<type, allocator>::array(const type *data, std::size_t size) : array(data, size, allocator()) {}
+
+    template <typename type, typename allocator>
+    inline array<type, allocator>::array(const type *data, std::size_t size, const allocator &alloc)
+        : m_alloc(alloc), m_data(nullptr), m_size(0), m_capacity(0)
+    {
+        if (size == 0)
         {
-            delete[] buffer;
-            throw;
+            return;
         }
 
-        m_data = buffer;
-        m_size = obj.m_size;
+        if (data == nullptr)
+        {
+            throw std::invalid_argument("Input pointer is nullptr but size is not zero");
+        }
+
+        m_data = allocate_copy(data, size);
+        m_size = size;
+        m_capacity = size;
     }
 
-    template <typename type>
-    inline array<type>::array(array<type> &&obj) noexcept
+    template <typename type, typename allocator>
+    inline array<type, allocator>::array(type *data, std::size_t size) : array(static_cast<const type*>(data), size)
     {
-        m_data = obj.m_data;
+        // copy-only by design
+    }
+
+    template <typename type, typename allocator>
+    inline array<type, allocator>::~array()
+    {
+        release();
+    }
+
+    template <typename type, typename allocator>
+    inline array<type, allocator>::array(const array &obj)
+        : m_alloc(traits::select_on_container_copy_construction(obj.m_alloc)),
+          m_data(nullptr), m_size(0), m_capacity(0)
+    {
+        m_data = allocate_copy(obj.m_data, obj.m_size);
         m_size = obj.m_size;
+        m_capacity = obj.m_size;
+    }
 
+    template <typename type, typename allocator>
+    inline array<type, allocator>::array(array &&obj) noexcept
+        : m_alloc(std::move(obj.m_alloc)), m_data(obj.m_data), m_size(obj.m_size), m_capacity(obj.m_capacity)
+    {
         obj.m_data = nullptr;
         obj.m_size = 0;
+        obj.m_capacity = 0;
+    }
+
+    template <typename type, typename allocator>
+    inline allocator array<type, allocator>::get_allocator() const
+    {
+        return m_alloc;
     }
 
     // methods
-    template <typename type>
-    type *array<type>::data()
+    template <typename type, typename allocator>
+    type *array<type, allocator>::data()
     {
         return m_data;
     }
 
-    template <typename type>
-    const type *array<type>::data() const
+    template <typename type, typename allocator>
+    const type *array<type, allocator>::data() const
     {
         return m_data;
     }
 
-    template <typename type>
-    std::size_t array<type>::size() const
+    template <typename type, typename allocator>
+    std::size_t array<type, allocator>::size() const
     {
         return m_size;
     }
 
-    template <typename type>
-    bool array<type>::empty() const
+    template <typename type, typename allocator>
+    bool array<type, allocator>::empty() const
     {
         return m_size == 0;
     }
 
-    template <typename type>
-    void array<type>::clear()
+    // capacity
+    template <typename type, typename allocator>
+    std::size_t array<type, allocator>::capacity() const
     {
-        delete[] m_data;
-        m_data = nullptr;
-        m_size = 0;
+        return m_capacity;
     }
 
-    template <typename type>
-    void array<type>::fill(const type &value)
+    template <typename type, typename allocator>
+    void array<type, allocator>::reserve(std::size_t new_capacity)
     {
-        if (m_size == 0 || m_data == nullptr)
+        if (new_capacity <= m_capacity)
         {
             return;
         }
 
-        std::fill(m_data, m_data + m_size, value);
+        reallocate(new_capacity);
     }
 
-    template <typename type>
-    void array<type>::resize(std::size_t new_size)
+    template <typename type, typename allocator>
+    void array<type, allocator>::shrink_to_fit()
     {
-        if (new_size == m_size)
+        if (m_capacity == m_size)
         {
             return;
         }
 
-        if (new_size == 0)
+        if (m_size == 0)
         {
-            clear();
+            release();
             return;
         }
 
-        type *buffer = new type[new_size];
+        reallocate(m_size);
+    }
 
-        std::size_t copy_size = (new_size < m_size) ? new_size : m_size;
+    template <typename type, typename allocator>
+    void array<type, allocator>::clear()
+    {
+        release();
+    }
 
-        try
+    template <typename type, typename allocator>
+    void array<type, allocator>::fill(const type &value)
+    {
+        if (m_size == 0 || m_data == nullptr)
         {
-            if (copy_size > 0 && m_data != nullptr)
-            {
-                std::copy(m_data, m_data + copy_size, buffer);
-            }
+            return;
         }
-        catch (...)
+
+        std::fill(m_data, m_data + m_size, value);
+    }
+
+    template <typename type, typename allocator>
+    void array<type, allocator>::resize(std::size_t new_size)
+    {
+        resize_impl(new_size, init_mode::value);
+    }
+
+    template <typename type, typename allocator>
+    void array<type, allocator>::resize(std::size_t new_size, uninitialized_t)
+        requires std::is_trivially_default_constructible_v<type>
+    {
+        resize_impl(new_size, init_mode::none);
+    }
+
+    template <typename type, typename allocator>
+    inline void array<type, allocator>::resize_impl(std::size_t new_size, init_mode mode)
+    {
+        if (new_size == m_size)
         {
-            delete[] buffer;
-            throw;
+            return;
         }
 
-        delete[] m_data;
-        m_data = buffer;
+        if (new_size < m_size)
+        {
+            // shrinking keeps the capacity: growing back is free
+            std::destroy_n(m_data + new_size, m_size - new_size);
+            m_size = new_size;
+            return;
+        }
+
+        if (new_size > m_capacity)
+        {
+            // exact fit: resize() is "set the size", reserve() is for growth ahead
+            reallocate(new_size);
+        }
+
+        construct_tail(new_size, mode);
         m_size = new_size;
     }
 
-    template <typename type>
-    type &array<type>::front()
+
+    template <typename type, typename allocator>
+    type &array<type, allocator>::front()
     {
         if (m_size == 0)
         {
@@ -288,8 +541,8 @@ namespace miv
         return m_data[0];
     }
 
-    template <typename type>
-    const type &array<type>::front() const
+    template <typename type, typename allocator>
+    const type &array<type, allocator>::front() const
     {
         if (m_size == 0)
         {
@@ -299,8 +552,8 @@ namespace miv
         return m_data[0];
     }
 
-    template <typename type>
-    type &array<type>::back()
+    template <typename type, typename allocator>
+    type &array<type, allocator>::back()
     {
         if (m_size == 0)
         {
@@ -310,8 +563,8 @@ namespace miv
         return m_data[m_size - 1];
     }
 
-    template <typename type>
-    const type &array<type>::back() const
+    template <typename type, typename allocator>
+    const type &array<type, allocator>::back() const
     {
         if (m_size == 0)
         {
@@ -321,8 +574,8 @@ namespace miv
         return m_data[m_size - 1];
     }
 
-    template <typename type>
-    std::size_t array<type>::find(const type &value) const
+    template <typename type, typename allocator>
+    std::size_t array<type, allocator>::find(const type &value) const
     {
         // Empty array: nothing can be found.
         if (m_size == 0 || m_data == nullptr)
@@ -343,22 +596,22 @@ namespace miv
         return static_cast<std::size_t>(it - m_data);
     }
 
-    template <typename type>
-    bool array<type>::contains(const type &value) const
+    template <typename type, typename allocator>
+    bool array<type, allocator>::contains(const type &value) const
     {
         // contains is just a convenient wrapper around find().
         return find(value) != npos;
     }
 
     // iterators
-    template <typename type>
-    type *array<type>::begin()
+    template <typename type, typename allocator>
+    type *array<type, allocator>::begin()
     {
         return m_data;
     }
 
-    template <typename type>
-    type *array<type>::end()
+    template <typename type, typename allocator>
+    type *array<type, allocator>::end()
     {
         if (m_data == nullptr)
         {
@@ -368,14 +621,14 @@ namespace miv
         return m_data + m_size;
     }
 
-    template <typename type>
-    const type *array<type>::begin() const
+    template <typename type, typename allocator>
+    const type *array<type, allocator>::begin() const
     {
         return m_data;
     }
 
-    template <typename type>
-    const type *array<type>::end() const
+    template <typename type, typename allocator>
+    const type *array<type, allocator>::end() const
     {
         if (m_data == nullptr)
         {
@@ -385,60 +638,107 @@ namespace miv
         return m_data + m_size;
     }
 
-    template <typename type>
-    const type *array<type>::cbegin() const
+    template <typename type, typename allocator>
+    const type *array<type, allocator>::cbegin() const
     {
         return begin();
     }
 
-    template <typename type>
-    const type *array<type>::cend() const
+    template <typename type, typename allocator>
+    const type *array<type, allocator>::cend() const
     {
         return end();
     }
-
     // operators
-    template <typename type>
-    array<type> &array<type>::operator=(const array<type> &obj)
+    template <typename type, typename allocator>
+    array<type, allocator> &array<type, allocator>::operator=(const array &obj)
     {
-        type *buffer = new type[obj.m_size];
-        
-        try
+        if (this == &obj)
         {
-            std::copy(obj.m_data, obj.m_data + obj.m_size, buffer);
+            return *this;
         }
-        catch (...)
+
+        if constexpr (traits::propagate_on_container_copy_assignment::value)
         {
-            delete[] buffer;
-            throw;
+            if (!traits::is_always_equal::value && m_alloc != obj.m_alloc)
+            {
+                // memory of the old allocator must go back to it
+                release();
+            }
+            m_alloc = obj.m_alloc;
+        }
+
+        if (obj.m_size <= m_capacity && m_data != nullptr)
+        {
+            // fits: reuse the buffer
+            const std::size_t common = std::min(m_size, obj.m_size);
+            std::copy(obj.m_data, obj.m_data + common, m_data);
+
+            if (obj.m_size > m_size)
+            {
+                std::uninitialized_copy(obj.m_data + m_size, obj.m_data + obj.m_size, m_data + m_size);
+            }
+            else
+            {
+                std::destroy(m_data + obj.m_size, m_data + m_size);
+            }
+
+            m_size = obj.m_size;
+            MIV_PROFILE_BYTES_MOVED(obj.m_size * sizeof(type));
+            return *this;
         }
 
-        delete[] m_data;
+        type *buffer = allocate_copy(obj.m_data, obj.m_size);
+
+        release();
         m_data = buffer;
         m_size = obj.m_size;
+        m_capacity = obj.m_size;
 
         return *this;
     }
 
-    template <typename type>
-    array<type> &array<type>::operator=(array<type> &&obj) noexcept
+    template <typename type, typename allocator>
+    array<type, allocator> &array<type, allocator>::operator=(array &&obj)
+        noexcept(std::allocator_traits<allocator>::propagate_on_container_move_assignment::value ||
+                 std::allocator_traits<allocator>::is_always_equal::value)
     {
-        if (this != &obj) 
+        if (this == &obj)
         {
-            delete[] m_data;
+            return *this;
+        }
 
-            m_data = obj.m_data;
-            m_size = obj.m_size;
+        if constexpr (!traits::propagate_on_container_move_assignment::value && !traits::is_always_equal::value)
+        {
+            if (m_alloc != obj.m_alloc)
+            {
+                // foreign memory cannot be stolen: copy the elements
+                *this = static_cast<const array &>(obj);
+                obj.release();
+                return *this;
+            }
+        }
 
-            obj.m_data = nullptr;
-            obj.m_size = 0;
+        release();
+
+        if constexpr (traits::propagate_on_container_move_assignment::value)
+        {
+            m_alloc = std::move(obj.m_alloc);
         }
 
+        m_data = obj.m_data;
+        m_size = obj.m_size;
+        m_capacity = obj.m_capacity;
+
+        obj.m_data = nullptr;
+        obj.m_size = 0;
+        obj.m_capacity = 0;
+
         return *this;
     }
 
-    template <typename type>
-    type &array<type>::operator[](std::size_t idx)
+    template <typename type, typename allocator>
+    type &array<type, allocator>::operator[](std::size_t idx)
     {
         // In case if negative idx is given size_t convert it to SIZE_MAX and error will be thrown
         if (idx >= m_size)
@@ -449,8 +749,8 @@ namespace miv
         return m_data[idx];
     }
 
-    template <typename type>
-    const type &array<type>::operator[](std::size_t idx) const
+    template <typename type, typename allocator>
+    const type &array<type, allocator>::operator[](std::size_t idx) const
     {
         // In case if negative idx is given size_t convert it to SIZE_MAX and error will be thrown
         if (idx >= m_size)
@@ -461,8 +761,8 @@ namespace miv
         return m_data[idx];
     }
 
-    template <typename type>
-    bool array<type>::operator==(const array<type> &other) const
+    template <typename type, typename allocator>
+    bool array<type, allocator>::operator==(const array &other) const
     {
         if (m_size != other.m_size)
         {
@@ -477,8 +777,8 @@ namespace miv
         return std::equal(m_data, m_data + m_size, other.m_data);
     }
 
-    template <typename type>
-    bool array<type>::operator!=(const array<type> &other) const
+    template <typename type, typename allocator>
+    bool array<type, allocator>::operator!=(const array &other) const
     {
         return !(*this == other);
     }
@@ -0,0 +1,23 @@
+#ifndef MIV_CONTAINERS_BOUNDS_CHECK_H
+#define MIV_CONTAINERS_BOUNDS_CHECK_H
+
+// Bounds checking of the views and fixed-size containers.
+//
+// MIV_BOUNDS_CHECK = 1 -> every view access is checked (throws std::out_of_range)
+// MIV_BOUNDS_CHECK = 0 -> unchecked fast path for inner loops
+//
+// The build sets it through the MIV_BOUNDS_CHECK CMake option
+// (default: checked in Debug, unchecked otherwise). Without the build
+// system it follows NDEBUG.
+//
+// miv::array::operator[] and miv::matrix::operator() are always checked;
+// the views and miv::fixed_array / miv::fixed_matrix are the opt-in fast path.
+#ifndef MIV_BOUNDS_CHECK
+    #ifdef NDEBUG
+        #define MIV_BOUNDS_CHECK 0
+    #else
+        #define MIV_BOUNDS_CHECK 1
+    #endif
+#endif
+
+#endif // MIV_CONTAINERS_BOUNDS_CHECK_H
@@ -0,0 +1,224 @@
+#ifndef MIV_CONTAINERS_FIXED_ARRAY_H
+#define MIV_CONTAINERS_FIXED_ARRAY_H
+
+#include <string>
+#include <cstddef>
+#include <stdexcept>
+#include <initializer_list>
+
+#include "array.hpp"
+#include "bounds_check.hpp"
+
+namespace miv
+{
+    // Array with the size fixed at compile time and inline (stack) storage.
+    //
+    // For tiny systems (n <= 8) where the heap allocation of miv::array costs
+    // more than the arithmetic. Everything is constexpr; elements are
+    // value-initialized. operator[] is checked only when MIV_BOUNDS_CHECK
+    // (see bounds_check.hpp), like the views.
+    template <typename type, std::size_t N>
+    class fixed_array
+    {
+        static_assert(N > 0, "fixed_array: N must be positive");
+
+    public:
+        using value_type = type;
+
+        // basic constructors
+        constexpr fixed_array();
+        constexpr fixed_array(std::initializer_list<type> init);
+
+        // copy N elements from a buffer
+        constexpr explicit fixed_array(const type *data);
+
+        // from a dynamic array of the same size
+        template <typename allocator>
+        explicit fixed_array(const miv::array<type, allocator> &arr);
+
+        // methods
+        static constexpr std::size_t size() { return N; }
+        static constexpr bool empty() { return false; }
+
+        constexpr type *data();
+        constexpr const type *data() const;
+
+        constexpr void fill(const type &value);
+
+        // copy to a dynamic array (resized to N)
+        template <typename allocator>
+        void copy_to(miv::array<type, allocator> &arr) const;
+
+        // iterators
+        constexpr type *begin();
+        constexpr type *end();
+        constexpr const type *begin() const;
+        constexpr const type *end() const;
+
+        // operators
+        constexpr type &operator[](std::size_t idx);
+        constexpr const type &operator[](std::size_t idx) const;
+
+        constexpr bool operator==(const fixed_array &other) const;
+        constexpr bool operator!=(const fixed_array &other) const;
+
+    private:
+        type m_data[N];
+    };
+
+    // constructors
+    template <typename type, std::size_t N>
+    inline constexpr fixed_array<type, N>::fixed_array() : m_data() {}
+
+    template <typename type, std::size_t N>
+    inline constexpr fixed_array<type, N>::fixed_array(std::initializer_list<type> init) : m_data()
+    {
+        if (init.size() != N)
+        {
+            throw std::invalid_argument("fixed_array: expected " + std::to_string(N) +
+                                        " values, but got " + std::to_string(init.size()));
+        }
+
+        std::size_t i = 0;
+        for (const type &value : init)
+        {
+            m_data[i++] = value;
+        }
+    }
+
+    template <typename type, std::size_t N>
+    inline constexpr fixed_array<type, N>::fixed_array(const type *data) : m_data()
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            m_data[i] = data[i];
+        }
+    }
+
+    template <typename type, std::size_t N>
+    template <typename allocator>
+    inline fixed_array<type, N>::fixed_array(const miv::array<type, allocator> &arr) : m_data()
+    {
+        if (arr.size() != N)
+        {
+            throw std::invalid_argument("fixed_array: expected an array of size " + std::to_string(N) +
+                                        ", but got " + std::to_string(arr.size()));
+        }
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            m_data[i] = arr.data()[i];
+        }
+    }
+
+    // methods
+    template <typename type, std::size_t N>
+    inline constexpr type *fixed_array<type, N>::data()
+    {
+        return m_data;
+    }
+
+    template <typename type, std::size_t N>
+    inline constexpr const type *fixed_array<type, N>::data() const
+    {
+        return m_data;
+    }
+
+    template <typename type, std::size_t N>
+    inline constexpr void fixed_array<type, N>::fill(const type &value)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            m_data[i] = value;
+        }
+    }
+
+    template <typename type, std::size_t N>
+    template <typename allocator>
+    inline void fixed_array<type, N>::copy_to(miv::array<type, allocator> &arr) const
+    {
+        if (arr.size() != N)
+        {
+            arr.resize(N);
+        }
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            arr.data()[i] = m_data[i];
+        }
+    }
+
+    // iterators
+    template <typename type, std::size_t N>
+    inline constexpr type *fixed_array<type, N>::begin()
+    {
+        return m_data;
+    }
+
+    template <typename type, std::size_t N>
+    inline constexpr type *fixed_array<type, N>::end()
+    {
+        return m_data + N;
+    }
+
+    template <typename type, std::size_t N>
+    inline constexpr const type *fixed_array<type, N>::begin() const
+    {
+        return m_data;
+    }
+
+    template <typename type, std::size_t N>
+    inline constexpr const type *fixed_array<type, N>::end() const
+    {
+        return m_data + N;
+    }
+
+    // operators
+    template <typename type, std::size_t N>
+    inline constexpr type &fixed_array<type, N>::operator[](std::size_t idx)
+    {
+#if MIV_BOUNDS_CHECK
+        if (idx >= N)
+        {
+            throw std::out_of_range("Index " + std::to_string(idx) + " is out of range");
+        }
+#endif
+
+        return m_data[idx];
+    }
+
+    template <typename type, std::size_t N>
+    inline constexpr const type &fixed_array<type, N>::operator[](std::size_t idx) const
+    {
+#if MIV_BOUNDS_CHECK
+        if (idx >= N)
+        {
+            throw std::out_of_range("Index " + std::to_string(idx) + " is out of range");
+        }
+#endif
+
+        return m_data[idx];
+    }
+
+    template <typename type, std::size_t N>
+    inline constexpr bool fixed_array<type, N>::operator==(const fixed_array &other) const
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (!(m_data[i] == other.m_data[i]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename type, std::size_t N>
+    inline constexpr bool fixed_array<type, N>::operator!=(const fixed_array &other) const
+    {
+        return !(*this == other);
+    }
+}
+
+#endif // MIV_CONTAINERS_FIXED_ARRAY_H
@@ -0,0 +1,261 @@
+#ifndef MIV_CONTAINERS_FIXED_MATRIX_H
+#define MIV_CONTAINERS_FIXED_MATRIX_H
+
+#include <string>
+#include <cstddef>
+#include <stdexcept>
+#include <initializer_list>
+
+#include "matrix.hpp"
+#include "fixed_array.hpp"
+#include "bounds_check.hpp"
+
+namespace miv
+{
+    // Row-major matrix with the shape fixed at compile time and inline (stack) storage.
+    //
+    // Same layout as miv::matrix, so data() can be handed to the packed kernels.
+    // Everything is constexpr; elements are value-initialized. operator() is
+    // checked only when MIV_BOUNDS_CHECK (see bounds_check.hpp).
+    template <typename type, std::size_t R, std::size_t C>
+    class fixed_matrix
+    {
+        static_assert(R > 0 && C > 0, "fixed_matrix: R and C must be positive");
+
+    public:
+        using value_type = type;
+
+        // basic constructors
+        constexpr fixed_matrix();
+
+        // R * C values in row-major order
+        constexpr fixed_matrix(std::initializer_list<type> init);
+
+        // from a dynamic matrix of the same shape
+        explicit fixed_matrix(const miv::matrix<type> &m);
+
+        static constexpr fixed_matrix identity() requires (R == C);
+
+        // state methods
+        static constexpr std::size_t rows() { return R; }
+        static constexpr std::size_t cols() { return C; }
+        static constexpr std::size_t size() { return R * C; }
+
+        // access methods
+        constexpr type *data();
+        constexpr const type *data() const;
+
+        constexpr type *row_ptr(std::size_t r);
+        constexpr const type *row_ptr(std::size_t r) const;
+
+        constexpr void fill(const type &value);
+
+        constexpr fixed_matrix<type, C, R> transpose() const;
+
+        // copy to a dynamic matrix (reshaped to R x C)
+        void copy_to(miv::matrix<type> &m) const;
+
+        // element access
+        constexpr type &operator()(std::size_t r, std::size_t c);
+        constexpr const type &operator()(std::size_t r, std::size_t c) const;
+
+        // matrix-vector product
+        constexpr fixed_array<type, R> operator*(const fixed_array<type, C> &v) const;
+
+        constexpr bool operator==(const fixed_matrix &other) const;
+        constexpr bool operator!=(const fixed_matrix &other) const;
+
+    private:
+        type m_data[R * C];
+    };
+
+    // constructors
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr fixed_matrix<type, R, C>::fixed_matrix() : m_data() {}
+
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr fixed_matrix<type, R, C>::fixed_matrix(std::initializer_list<type> init) : m_data()
+    {
+        if (init.size() != R * C)
+        {
+            throw std::invalid_argument("fixed_matrix: expected " + std::to_string(R * C) +
+                                        " values, but got " + std::to_string(init.size()));
+        }
+
+        std::size_t i = 0;
+        for (const type &value : init)
+        {
+            m_data[i++] = value;
+        }
+    }
+
+    template <typename type, std::size_t R, std::size_t C>
+    inline fixed_matrix<type, R, C>::fixed_matrix(const miv::matrix<type> &m) : m_data()
+    {
+        if (m.rows() != R || m.cols() != C)
+        {
+            throw std::invalid_argument("fixed_matrix: expected a " + std::to_string(R) + "x" + std::to_string(C) +
+                                        " matrix, but got " + std::to_string(m.rows()) + "x" + std::to_string(m.cols()));
+        }
+
+        for (std::size_t i = 0; i < R * C; ++i)
+        {
+            m_data[i] = m.data()[i];
+        }
+    }
+
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr fixed_matrix<type, R, C> fixed_matrix<type, R, C>::identity() requires (R == C)
+    {
+        fixed_matrix out;
+        for (std::size_t i = 0; i < R; ++i)
+        {
+            out.m_data[i * C + i] = type(1);
+        }
+
+        return out;
+    }
+
+    // access methods
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr type *fixed_matrix<type, R, C>::data()
+    {
+        return m_data;
+    }
+
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr const type *fixed_matrix<type, R, C>::data() const
+    {
+        return m_data;
+    }
+
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr type *fixed_matrix<type, R, C>::row_ptr(std::size_t r)
+    {
+#if MIV_BOUNDS_CHECK
+        if (r >= R)
+        {
+            throw std::out_of_range("Row " + std::to_string(r) + " is out of range");
+        }
+#endif
+
+        return m_data + r * C;
+    }
+
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr const type *fixed_matrix<type, R, C>::row_ptr(std::size_t r) const
+    {
+#if MIV_BOUNDS_CHECK
+        if (r >= R)
+        {
+            throw std::out_of_range("Row " + std::to_string(r) + " is out of range");
+        }
+#endif
+
+        return m_data + r * C;
+    }
+
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr void fixed_matrix<type, R, C>::fill(const type &value)
+    {
+        for (std::size_t i = 0; i < R * C; ++i)
+        {
+            m_data[i] = value;
+        }
+    }
+
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr fixed_matrix<type, C, R> fixed_matrix<type, R, C>::transpose() const
+    {
+        fixed_matrix<type, C, R> out;
+        for (std::size_t r = 0; r < R; ++r)
+        {
+            for (std::size_t c = 0; c < C; ++c)
+            {
+                out.data()[c * R + r] = m_data[r * C + c];
+            }
+        }
+
+        return out;
+    }
+
+    template <typename type, std::size_t R, std::size_t C>
+    inline void fixed_matrix<type, R, C>::copy_to(miv::matrix<type> &m) const
+    {
+        if (m.rows() != R || m.cols() != C)
+        {
+            m = miv::matrix<type>(R, C);
+        }
+
+        for (std::size_t i = 0; i < R * C; ++i)
+        {
+            m.data()[i] = m_data[i];
+        }
+    }
+
+    // element access
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr type &fixed_matrix<type, R, C>::operator()(std::size_t r, std::size_t c)
+    {
+#if MIV_BOUNDS_CHECK
+        if (r >= R || c >= C)
+        {
+            throw std::out_of_range("Index (" + std::to_string(r) + "," + std::to_string(c) + ") is out of range");
+        }
+#endif
+
+        return m_data[r * C + c];
+    }
+
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr const type &fixed_matrix<type, R, C>::operator()(std::size_t r, std::size_t c) const
+    {
+#if MIV_BOUNDS_CHECK
+        if (r >= R || c >= C)
+        {
+            throw std::out_of_range("Index (" + std::to_string(r) + "," + std::to_string(c) + ") is out of range");
+        }
+#endif
+
+        return m_data[r * C + c];
+    }
+
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr fixed_array<type, R> fixed_matrix<type, R, C>::operator*(const fixed_array<type, C> &v) const
+    {
+        fixed_array<type, R> out;
+        for (std::size_t r = 0; r < R; ++r)
+        {
+            type sum{};
+            for (std::size_t c = 0; c < C; ++c)
+            {
+                sum += m_data[r * C + c] * v.data()[c];
+            }
+            out.data()[r] = sum;
+        }
+
+        return out;
+    }
+
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr bool fixed_matrix<type, R, C>::operator==(const fixed_matrix &other) const
+    {
+        for (std::size_t i = 0; i < R * C; ++i)
+        {
+            if (!(m_data[i] == other.m_data[i]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename type, std::size_t R, std::size_t C>
+    inline constexpr bool fixed_matrix<type, R, C>::operator!=(const fixed_matrix &other) const
+    {
+        return !(*this == other);
+    }
+}
+
+#endif // MIV_CONTAINERS_FIXED_MATRIX_H
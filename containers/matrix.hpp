@@ -4,13 +4,25 @@
 #include <cstddef>
 #include <string>
 #include <algorithm>
+#include <concepts>
 #include <stdexcept>
+#include <type_traits>
 #include <initializer_list>
 
 #include "array.hpp"
 
 namespace miv
 {
+    // Lazy matrix expression (see math/expression.hpp): anything that knows
+    // its shape and can write its elements into a row-major buffer of type.
+    template <typename expr, typename type>
+    concept matrix_expression = requires(const expr &e, type *out)
+    {
+        { e.rows() } -> std::convertible_to<std::size_t>;
+        { e.cols() } -> std::convertible_to<std::size_t>;
+        e.eval_into(out);
+    };
+
     template <typename type>
     class matrix
     {
@@ -19,6 +31,14 @@ namespace miv
         matrix();
         matrix(std::size_t rows, std::size_t cols);
 
+        // all elements set to value in one pass (instead of matrix(r, c) + fill())
+        matrix(std::size_t rows, std::size_t cols, const type &value);
+
+        // elements left uninitialized, for results that are fully overwritten
+        // (trivially default constructible types only, see miv::uninitialized)
+        matrix(std::size_t rows, std::size_t cols, uninitialized_t)
+            requires std::is_trivially_default_constructible_v<type>;
+
         matrix(const matrix<type> &obj);
         matrix(matrix<type> &&obj) noexcept;
 
@@ -36,6 +56,11 @@ namespace miv
         // all rows must have the same size
         matrix(std::initializer_list<miv::array<type>> rows);
 
+        // evaluate a lazy expression in one pass
+        template <typename expr>
+            requires matrix_expression<expr, type>
+        matrix(const expr &e);
+
         // state methods
         bool empty() const;
         std::size_t rows() const;
@@ -91,6 +116,13 @@ namespace miv
         matrix<type> &operator=(const matrix<type> &obj);
         matrix<type> &operator=(matrix<type> &&obj) noexcept;
 
+        // evaluate a lazy expression into this matrix
+        // (same shape -> in place, the buffer is reused; expressions are element-wise,
+        // so the expression may read this matrix itself)
+        template <typename expr>
+            requires matrix_expression<expr, type>
+        matrix<type> &operator=(const expr &e);
+
         // element access (checked, same philosophy as your array)
         type &operator()(std::size_t r, std::size_t c);
         const type &operator()(std::size_t r, std::size_t c) const;
@@ -104,6 +136,14 @@ namespace miv
         // index helpers
         std::size_t linear_index(std::size_t r, std::size_t c) const;
 
+        // storage that is about to be overwritten completely
+        // (uninitialized when the element type allows it)
+        static miv::array<type> scratch_storage(std::size_t size);
+
+        // throws unless perm is a permutation of [0, extent); O(extent)
+        static void require_permutation(const miv::array<std::size_t> &perm, std::size_t extent,
+                                        const char *func, const char *what);
+
         miv::array<type> m_data;
         std::size_t m_rows;
         std::size_t m_cols;
@@ -121,6 +161,62 @@ namespace miv
         // user responsibility for sane sizes (like STL containers).
     }
 
+    template <typename type>
+    inline matrix<type>::matrix(std::size_t rows, std::size_t cols, const type &value)
+        : m_data(scratch_storage(rows * cols)), m_rows(rows), m_cols(cols)
+    {
+        std::fill(m_data.begin(), m_data.end(), value);
+    }
+
+    template <typename type>
+    inline matrix<type>::matrix(std::size_t rows, std::size_t cols, uninitialized_t)
+        requires std::is_trivially_default_constructible_v<type>
+        : m_data(rows * cols, uninitialized), m_rows(rows), m_cols(cols) {}
+
+    template <typename type>
+    inline miv::array<type> matrix<type>::scratch_storage(std::size_t size)
+    {
+        if constexpr (std::is_trivially_default_constructible_v<type>)
+        {
+            return miv::array<type>(size, uninitialized);
+        }
+        else
+        {
+            return miv::array<type>(size);
+        }
+    }
+
+    template <typename type>
+    inline void matrix<type>::require_permutation(const miv::array<std::size_t> &perm, std::size_t extent,
+                                                  const char *func, const char *what)
+    {
+        if (perm.size() != extent)
+        {
+            throw std::invalid_argument(std::string(func) + ": perm size must match number of " + what + "s");
+        }
+
+        // Validate indices are in range
+        for (std::size_t i = 0; i < perm.size(); ++i)
+        {
+            if (perm[i] >= extent)
+            {
+                throw std::out_of_range(std::string(func) + ": " + what + " index " + std::to_string(perm[i]) +
+                                        " is out of range");
+            }
+        }
+
+        // Validate uniqueness (true permutation): one flag per index instead of comparing all pairs
+        miv::array<unsigned char> seen(extent);
+        for (std::size_t i = 0; i < perm.size(); ++i)
+        {
+            if (seen[perm[i]] != 0)
+            {
+                throw std::invalid_argument(std::string(func) + ": permutation contains duplicate indices");
+            }
+            seen[perm[i]] = 1;
+        }
+    }
+
     template <typename type>
     inline matrix<type>::matrix(const matrix<type> &obj)
         : m_data(obj.m_data), m_rows(obj.m_rows), m_cols(obj.m_cols) {}
@@ -279,6 +375,19 @@ namespace miv
         }
     }
 
+    template <typename type>
+    template <typename expr>
+        requires matrix_expression<expr, type>
+    inline matrix<type>::matrix(const expr &e)
+        : m_data(scratch_storage(static_cast<std::size_t>(e.rows()) * static_cast<std::size_t>(e.cols()))),
+          m_rows(e.rows()), m_cols(e.cols())
+    {
+        if (!m_data.empty())
+        {
+            e.eval_into(m_data.data());
+        }
+    }
+
     template <typename type>
     inline matrix<type>::~matrix()
     {
@@ -381,9 +490,12 @@ namespace miv
 
         miv::array<type> out(m_rows);
 
+        // one element per row: a strided walk without per-element checks
+        const type *src = m_data.data() + c;
+        type *dst = out.data();
         for (std::size_t r = 0; r < m_rows; ++r)
         {
-            out[r] = (*this)(r, c);
+            dst[r] = src[r * m_cols];
         }
 
         return out;
@@ -435,9 +547,11 @@ namespace miv
             return out;
         }
 
+        const type *src = m_data.data() + c;
+        type *dst = out.data();
         for (std::size_t r = 0; r < m_rows; ++r)
         {
-            out(r, 0) = (*this)(r, c);
+            dst[r] = src[r * m_cols];
         }
 
         return out;
@@ -502,38 +616,14 @@ namespace miv
     template <typename type>
     inline void matrix<type>::row_permute(const miv::array<std::size_t> &perm)
     {
-        if (perm.size() != m_rows)
-        {
-            throw std::invalid_argument("row_permute(): perm size must match number of rows");
-        }
-
-        // Validate indices are in range
-        for (std::size_t i = 0; i < perm.size(); ++i)
-        {
-            if (perm[i] >= m_rows)
-            {
-                throw std::out_of_range("row_permute(): row index " + std::to_string(perm[i]) + " is out of range");
-            }
-        }
-
-        // Validate uniqueness (true permutation)
-        for (std::size_t i = 0; i < perm.size(); ++i)
-        {
-            for (std::size_t j = i + 1; j < perm.size(); ++j)
-            {
-                if (perm[i] == perm[j])
-                {
-                    throw std::invalid_argument("row_permute(): permutation contains duplicate indices");
-                }
-            }
-        }
+        require_permutation(perm, m_rows, "row_permute()", "row");
 
         if (m_rows == 0 || m_cols == 0)
         {
             return;
         }
 
-        miv::array<type> new_data(m_rows * m_cols);
+        miv::array<type> new_data = scratch_storage(m_rows * m_cols);
 
         try
         {
@@ -556,47 +646,28 @@ namespace miv
     template <typename type>
     inline void matrix<type>::col_permute(const miv::array<std::size_t> &perm)
     {
-        if (perm.size() != m_cols)
-        {
-            throw std::invalid_argument("col_permute(): perm size must match number of cols");
-        }
-
-        // Validate indices are in range
-        for (std::size_t i = 0; i < perm.size(); ++i)
-        {
-            if (perm[i] >= m_cols)
-            {
-                throw std::out_of_range("col_permute(): col index " + std::to_string(perm[i]) + " is out of range");
-            }
-        }
-
-        // Validate uniqueness (true permutation)
-        for (std::size_t i = 0; i < perm.size(); ++i)
-        {
-            for (std::size_t j = i + 1; j < perm.size(); ++j)
-            {
-                if (perm[i] == perm[j])
-                {
-                    throw std::invalid_argument("col_permute(): permutation contains duplicate indices");
-                }
-            }
-        }
+        require_permutation(perm, m_cols, "col_permute()", "col");
 
         if (m_rows == 0 || m_cols == 0)
         {
             return;
         }
 
-        miv::array<type> new_data(m_rows * m_cols);
+        miv::array<type> new_data = scratch_storage(m_rows * m_cols);
 
         try
         {
+            // Row by row: the gather new(r, c) = old(r, perm[c]) stays inside one
+            // source row, and the destination is written contiguously
+            const std::size_t *p = perm.data();
             for (std::size_t r = 0; r < m_rows; ++r)
             {
+                const type *src = m_data.data() + r * m_cols;
+                type *dst = new_data.data() + r * m_cols;
+
                 for (std::size_t c = 0; c < m_cols; ++c)
                 {
-                    // new(r, c) = old(r, perm[c])
-                    new_data[r * m_cols + c] = (*this)(r, perm[c]);
+                    dst[c] = src[p[c]];
                 }
             }
         }
@@ -675,6 +746,29 @@ namespace miv
         return *this;
     }
 
+    template <typename type>
+    template <typename expr>
+        requires matrix_expression<expr, type>
+    inline matrix<type> &matrix<type>::operator=(const expr &e)
+    {
+        const std::size_t rows = e.rows();
+        const std::size_t cols = e.cols();
+
+        if (rows == m_rows && cols == m_cols)
+        {
+            if (!m_data.empty())
+            {
+                e.eval_into(m_data.data());
+            }
+            return *this;
+        }
+
+        // new shape: evaluate into a fresh buffer first (e may still read the old one)
+        matrix<type> tmp(e);
+        *this = std::move(tmp);
+        return *this;
+    }
+
     template <typename type>
     inline std::size_t matrix<type>::linear_index(std::size_t r, std::size_t c) const
     {
@@ -0,0 +1,385 @@
+#ifndef MIV_CONTAINERS_MATRIX_VIEW_H
+#define MIV_CONTAINERS_MATRIX_VIEW_H
+
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+
+#if __has_include(<mdspan>)
+    #include <array>
+    #include <mdspan>
+#endif
+
+#include "array.hpp"
+#include "matrix.hpp"
+#include "bounds_check.hpp"
+
+namespace miv
+{
+    // Non-owning view of a contiguous 1D range: pointer + size.
+    //
+    // array_view<const T> is the read-only flavour.
+    template <typename type>
+    class array_view
+    {
+    public:
+        using value_type = std::remove_const_t<type>;
+
+        // basic constructors
+        array_view();
+        array_view(type *data, std::size_t size);
+
+        // from containers (const element type required for const containers)
+        array_view(miv::array<value_type> &arr);
+        array_view(const miv::array<value_type> &arr) requires std::is_const_v<type>;
+
+        // array_view<T> -> array_view<const T>
+        template <typename other>
+            requires std::is_convertible_v<other (*)[], type (*)[]>
+        array_view(const array_view<other> &obj);
+
+        // state methods
+        bool empty() const;
+        std::size_t size() const;
+
+        // access methods
+        type *data() const;
+
+        // sub-range [offset, offset + count)
+        array_view<type> subview(std::size_t offset, std::size_t count) const;
+
+        // iterators (pointers)
+        type *begin() const;
+        type *end() const;
+
+        // element access (checked only when MIV_BOUNDS_CHECK)
+        type &operator[](std::size_t i) const;
+
+    private:
+        type *m_data;
+        std::size_t m_size;
+    };
+
+    // Non-owning row-major 2D view: pointer + rows, cols and a row stride.
+    //
+    // The stride lets a view address a sub-block of a larger matrix
+    // (for example the trailing block in LU). Layout matches
+    // std::mdspan<T, std::dextents<size_t, 2>, std::layout_stride>.
+    template <typename type>
+    class matrix_view
+    {
+    public:
+        using value_type = std::remove_const_t<type>;
+
+        // basic constructors
+        matrix_view();
+        matrix_view(type *data, std::size_t rows, std::size_t cols);
+        matrix_view(type *data, std::size_t rows, std::size_t cols, std::size_t stride);
+
+        // from containers (const element type required for const containers)
+        matrix_view(miv::matrix<value_type> &m);
+        matrix_view(const miv::matrix<value_type> &m) requires std::is_const_v<type>;
+
+        // matrix_view<T> -> matrix_view<const T>
+        template <typename other>
+            requires std::is_convertible_v<other (*)[], type (*)[]>
+        matrix_view(const matrix_view<other> &obj);
+
+        // state methods
+        bool empty() const;
+        std::size_t rows() const;
+        std::size_t cols() const;
+        std::size_t stride() const;
+        std::size_t size() const;
+
+        // true if rows are packed back to back (stride == cols)
+        bool is_contiguous() const;
+
+        // access methods
+        type *data() const;
+
+        // row helpers
+        type *row_ptr(std::size_t r) const;
+        array_view<type> row(std::size_t r) const;
+
+        // rectangular block starting at (r0, c0), same stride
+        matrix_view<type> submatrix(std::size_t r0, std::size_t c0, std::size_t rows, std::size_t cols) const;
+
+        // element access (checked only when MIV_BOUNDS_CHECK)
+        type &operator()(std::size_t r, std::size_t c) const;
+
+#if defined(__cpp_lib_mdspan)
+        // interop with the standard library
+        std::mdspan<type, std::dextents<std::size_t, 2>, std::layout_stride> to_mdspan() const;
+#endif
+
+    private:
+        type *m_data;
+        std::size_t m_rows;
+        std::size_t m_cols;
+        std::size_t m_stride;
+    };
+
+    // helpers: view of a whole container
+    template <typename type>
+    matrix_view<type> make_view(miv::matrix<type> &m);
+
+    template <typename type>
+    matrix_view<const type> make_view(const miv::matrix<type> &m);
+
+    template <typename type>
+    array_view<type> make_view(miv::array<type> &arr);
+
+    template <typename type>
+    array_view<const type> make_view(const miv::array<type> &arr);
+
+    // ============================================================
+    //                         array_view
+    // ============================================================
+
+    // constructors
+    template <typename type>
+    inline array_view<type>::array_view() : m_data(nullptr), m_size(0) {}
+
+    template <typename type>
+    inline array_view<type>::array_view(type *data, std::size_t size) : m_data(data), m_size(size) {}
+
+    template <typename type>
+    inline array_view<type>::array_view(miv::array<value_type> &arr) : m_data(arr.data()), m_size(arr.size()) {}
+
+    template <typename type>
+    inline array_view<type>::array_view(const miv::array<value_type> &arr) requires std::is_const_v<type>
+        : m_data(arr.data()), m_size(arr.size()) {}
+
+    template <typename type>
+    template <typename other>
+        requires std::is_convertible_v<other (*)[], type (*)[]>
+    inline array_view<type>::array_view(const array_view<other> &obj) : m_data(obj.data()), m_size(obj.size()) {}
+
+    // state methods
+    template <typename type>
+    inline bool array_view<type>::empty() const
+    {
+        return m_size == 0;
+    }
+
+    template <typename type>
+    inline std::size_t array_view<type>::size() const
+    {
+        return m_size;
+    }
+
+    // access methods
+    template <typename type>
+    inline type *array_view<type>::data() const
+    {
+        return m_data;
+    }
+
+    template <typename type>
+    inline array_view<type> array_view<type>::subview(std::size_t offset, std::size_t count) const
+    {
+        if (offset > m_size || count > m_size - offset)
+        {
+            throw std::out_of_range("subview(): range [" + std::to_string(offset) + ", " +
+                                    std::to_string(offset + count) + ") is out of range");
+        }
+
+        return array_view<type>(m_data + offset, count);
+    }
+
+    // iterators
+    template <typename type>
+    inline type *array_view<type>::begin() const
+    {
+        return m_data;
+    }
+
+    template <typename type>
+    inline type *array_view<type>::end() const
+    {
+        return m_data + m_size;
+    }
+
+    // element access
+    template <typename type>
+    inline type &array_view<type>::operator[](std::size_t i) const
+    {
+#if MIV_BOUNDS_CHECK
+        if (i >= m_size)
+        {
+            throw std::out_of_range("Index " + std::to_string(i) + " is out of range");
+        }
+#endif
+
+        return m_data[i];
+    }
+
+    // ============================================================
+    //                         matrix_view
+    // ============================================================
+
+    // constructors
+    template <typename type>
+    inline matrix_view<type>::matrix_view() : m_data(nullptr), m_rows(0), m_cols(0), m_stride(0) {}
+
+    template <typename type>
+    inline matrix_view<type>::matrix_view(type *data, std::size_t rows, std::size_t cols)
+        : m_data(data), m_rows(rows), m_cols(cols), m_stride(cols) {}
+
+    template <typename type>
+    inline matrix_view<type>::matrix_view(type *data, std::size_t rows, std::size_t cols, std::size_t stride)
+        : m_data(data), m_rows(rows), m_cols(cols), m_stride(stride)
+    {
+        if (rows > 1 && stride < cols)
+        {
+            throw std::invalid_argument("matrix_view: stride must be >= cols");
+        }
+    }
+
+    template <typename type>
+    inline matrix_view<type>::matrix_view(miv::matrix<value_type> &m)
+        : m_data(m.data()), m_rows(m.rows()), m_cols(m.cols()), m_stride(m.cols()) {}
+
+    template <typename type>
+    inline matrix_view<type>::matrix_view(const miv::matrix<value_type> &m) requires std::is_const_v<type>
+        : m_data(m.data()), m_rows(m.rows()), m_cols(m.cols()), m_stride(m.cols()) {}
+
+    template <typename type>
+    template <typename other>
+        requires std::is_convertible_v<other (*)[], type (*)[]>
+    inline matrix_view<type>::matrix_view(const matrix_view<other> &obj)
+        : m_data(obj.data()), m_rows(obj.rows()), m_cols(obj.cols()), m_stride(obj.stride()) {}
+
+    // state methods
+    template <typename type>
+    inline bool matrix_view<type>::empty() const
+    {
+        return m_rows == 0 || m_cols == 0;
+    }
+
+    template <typename type>
+    inline std::size_t matrix_view<type>::rows() const
+    {
+        return m_rows;
+    }
+
+    template <typename type>
+    inline std::size_t matrix_view<type>::cols() const
+    {
+        return m_cols;
+    }
+
+    template <typename type>
+    inline std::size_t matrix_view<type>::stride() const
+    {
+        return m_stride;
+    }
+
+    template <typename type>
+    inline std::size_t matrix_view<type>::size() const
+    {
+        return m_rows * m_cols;
+    }
+
+    template <typename type>
+    inline bool matrix_view<type>::is_contiguous() const
+    {
+        return m_stride == m_cols || m_rows <= 1;
+    }
+
+    // access methods
+    template <typename type>
+    inline type *matrix_view<type>::data() const
+    {
+        return m_data;
+    }
+
+    template <typename type>
+    inline type *matrix_view<type>::row_ptr(std::size_t r) const
+    {
+#if MIV_BOUNDS_CHECK
+        if (r >= m_rows)
+        {
+            throw std::out_of_range("Row " + std::to_string(r) + " is out of range");
+        }
+#endif
+
+        return m_data + r * m_stride;
+    }
+
+    template <typename type>
+    inline array_view<type> matrix_view<type>::row(std::size_t r) const
+    {
+        return array_view<type>(row_ptr(r), m_cols);
+    }
+
+    template <typename type>
+    inline matrix_view<type> matrix_view<type>::submatrix(std::size_t r0, std::size_t c0,
+                                                          std::size_t rows, std::size_t cols) const
+    {
+        if (r0 > m_rows || c0 > m_cols || rows > m_rows - r0 || cols > m_cols - c0)
+        {
+            throw std::out_of_range("submatrix(): block (" + std::to_string(r0) + "," + std::to_string(c0) +
+                                    ") of " + std::to_string(rows) + "x" + std::to_string(cols) +
+                                    " is out of range");
+        }
+
+        return matrix_view<type>(m_data + r0 * m_stride + c0, rows, cols, m_stride);
+    }
+
+    // element access
+    template <typename type>
+    inline type &matrix_view<type>::operator()(std::size_t r, std::size_t c) const
+    {
+#if MIV_BOUNDS_CHECK
+        if (r >= m_rows || c >= m_cols)
+        {
+            throw std::out_of_range("Index (" + std::to_string(r) + "," + std::to_string(c) + ") is out of range");
+        }
+#endif
+
+        return m_data[r * m_stride + c];
+    }
+
+#if defined(__cpp_lib_mdspan)
+    template <typename type>
+    inline std::mdspan<type, std::dextents<std::size_t, 2>, std::layout_stride> matrix_view<type>::to_mdspan() const
+    {
+        using extents_t = std::dextents<std::size_t, 2>;
+        const std::layout_stride::mapping<extents_t> mapping(
+            extents_t(m_rows, m_cols),
+            std::array<std::size_t, 2>{ m_stride, 1 });
+
+        return std::mdspan<type, extents_t, std::layout_stride>(m_data, mapping);
+    }
+#endif
+
+    // helpers
+    template <typename type>
+    inline matrix_view<type> make_view(miv::matrix<type> &m)
+    {
+        return matrix_view<type>(m);
+    }
+
+    template <typename type>
+    inline matrix_view<const type> make_view(const miv::matrix<type> &m)
+    {
+        return matrix_view<const type>(m);
+    }
+
+    template <typename type>
+    inline array_view<type> make_view(miv::array<type> &arr)
+    {
+        return array_view<type>(arr);
+    }
+
+    template <typename type>
+    inline array_view<const type> make_view(const miv::array<type> &arr)
+    {
+        return array_view<const type>(arr);
+    }
+}
+
+#endif // MIV_CONTAINERS_MATRIX_VIEW_H
@@ -0,0 +1,252 @@
+#ifndef MIV_CONTAINERS_PROFILE_H
+#define MIV_CONTAINERS_PROFILE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Lightweight instrumentation of the solver hot paths: scoped timers and counters.
+//
+// MIV_PROFILE = 1 -> MIV_PROFILE_SCOPE and the counting macros record into the
+//                    profile_counters installed on the calling thread
+// MIV_PROFILE = 0 -> the macros expand to nothing, no clock reads, no thread_local
+//
+// The build sets it through the MIV_PROFILE CMake option (default OFF).
+//
+// Nothing is recorded until a caller installs a target with MIV_PROFILE_RECORD_INTO
+// (newton_solver::solve records into newton_result::profile). Sections nest:
+// only the outermost scope of a section on a thread is timed and counted, so
+// lu_factorization::factorize -> lu_decompose_lup_blocked -> lu_decompose_lup_packed
+// is one factorization. Different sections overlap (an F evaluation inside a
+// Jacobian build is counted in both). Worker threads of a parallel kernel attach to
+// the caller's target (MIV_PROFILE_CAPTURE + MIV_PROFILE_RECORD_INTO), so their
+// section times are summed over threads, like CPU time.
+#ifndef MIV_PROFILE
+    #define MIV_PROFILE 0
+#endif
+
+namespace miv
+{
+    inline constexpr bool profile_enabled = (MIV_PROFILE != 0);
+
+    // what a scoped timer measures
+    enum class profile_section : std::size_t
+    {
+        evaluate,    // F(x): one evaluation of the whole system (evaluate_system)
+        jacobian,    // Jacobian assembly (numeric, sparse or automatic builders)
+        factorize,   // LU factorization (dense, small fixed-size or sparse)
+        substitute,  // forward / backward substitution with a factorization
+        callback,    // user iteration callback (logging, tracing)
+        count_       // number of sections
+    };
+
+    inline constexpr std::size_t profile_section_count = static_cast<std::size_t>(profile_section::count_);
+
+    // Counters of one profiled run; plain integers, updated with relaxed atomic_ref
+    // so that attached worker threads can add to the same object.
+    struct profile_counters
+    {
+        std::array<std::uint64_t, profile_section_count> calls{};
+        std::array<std::uint64_t, profile_section_count> nanoseconds{};
+
+        std::uint64_t allocations = 0;      // heap allocations of miv containers and workspaces
+        std::uint64_t allocated_bytes = 0;
+        std::uint64_t bytes_moved = 0;      // bytes copied between miv::array buffers
+
+        // state methods
+        std::uint64_t count(profile_section section) const;
+        std::chrono::nanoseconds time(profile_section section) const;
+
+        profile_counters &operator+=(const profile_counters &other);
+    };
+
+    // Installs `target` as the profile of the calling thread for the lifetime of the
+    // object; the previous target is restored on destruction. nullptr disables recording.
+    class profile_scope
+    {
+    public:
+        explicit profile_scope(profile_counters *target) noexcept;
+        ~profile_scope();
+
+        profile_scope(const profile_scope &) = delete;
+        profile_scope &operator=(const profile_scope &) = delete;
+
+    private:
+        profile_counters *m_previous;
+    };
+
+    // Times the enclosing block as one call of `section` (outermost scope only).
+    class scoped_timer
+    {
+    public:
+        explicit scoped_timer(profile_section section) noexcept;
+        ~scoped_timer();
+
+        scoped_timer(const scoped_timer &) = delete;
+        scoped_timer &operator=(const scoped_timer &) = delete;
+
+    private:
+        profile_counters *m_target;   // nullptr: nothing to record (no target or nested)
+        std::size_t m_section;
+        bool m_tracked;               // depth of the section was incremented
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    // profile of the calling thread (nullptr if none)
+    profile_counters *current_profile() noexcept;
+
+    void profile_count_allocation(std::size_t bytes) noexcept;
+    void profile_count_bytes_moved(std::size_t bytes) noexcept;
+
+    namespace detail
+    {
+        struct profile_thread_state
+        {
+            profile_counters *target = nullptr;
+            std::array<unsigned, profile_section_count> depth{};
+        };
+
+        profile_thread_state &profile_state() noexcept;
+
+        void profile_add(std::uint64_t &counter, std::uint64_t value) noexcept;
+    }
+
+    // profile_counters
+    inline std::uint64_t profile_counters::count(profile_section section) const
+    {
+        return calls[static_cast<std::size_t>(section)];
+    }
+
+    inline std::chrono::nanoseconds profile_counters::time(profile_section section) const
+    {
+        return std::chrono::nanoseconds(static_cast<std::int64_t>(nanoseconds[static_cast<std::size_t>(section)]));
+    }
+
+    inline profile_counters &profile_counters::operator+=(const profile_counters &other)
+    {
+        for (std::size_t s = 0; s < profile_section_count; ++s)
+        {
+            calls[s] += other.calls[s];
+            nanoseconds[s] += other.nanoseconds[s];
+        }
+
+        allocations += other.allocations;
+        allocated_bytes += other.allocated_bytes;
+        bytes_moved += other.bytes_moved;
+
+        return *this;
+    }
+
+    // thread state
+    inline detail::profile_thread_state &detail::profile_state() noexcept
+    {
+        thread_local profile_thread_state state;
+        return state;
+    }
+
+    inline void detail::profile_add(std::uint64_t &counter, std::uint64_t value) noexcept
+    {
+        std::atomic_ref<std::uint64_t>(counter).fetch_add(value, std::memory_order_relaxed);
+    }
+
+    inline profile_counters *current_profile() noexcept
+    {
+        return detail::profile_state().target;
+    }
+
+    // profile_scope
+    inline profile_scope::profile_scope(profile_counters *target) noexcept
+        : m_previous(detail::profile_state().target)
+    {
+        detail::profile_state().target = target;
+    }
+
+    inline profile_scope::~profile_scope()
+    {
+        detail::profile_state().target = m_previous;
+    }
+
+    // scoped_timer
+    inline scoped_timer::scoped_timer(profile_section section) noexcept
+        : m_target(nullptr), m_section(static_cast<std::size_t>(section)), m_tracked(false), m_start()
+    {
+        auto &state = detail::profile_state();
+        if (state.target == nullptr)
+        {
+            return;
+        }
+
+        m_tracked = true;
+        if (state.depth[m_section]++ == 0)
+        {
+            m_target = state.target;
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    inline scoped_timer::~scoped_timer()
+    {
+        if (!m_tracked)
+        {
+            return;
+        }
+
+        --detail::profile_state().depth[m_section];
+
+        if (m_target != nullptr)
+        {
+            const auto elapsed = std::chrono::steady_clock::now() - m_start;
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+
+            detail::profile_add(m_target->calls[m_section], 1);
+            detail::profile_add(m_target->nanoseconds[m_section], static_cast<std::uint64_t>(ns));
+        }
+    }
+
+    // counters
+    inline void profile_count_allocation(std::size_t bytes) noexcept
+    {
+        if (profile_counters *target = current_profile())
+        {
+            detail::profile_add(target->allocations, 1);
+            detail::profile_add(target->allocated_bytes, bytes);
+        }
+    }
+
+    inline void profile_count_bytes_moved(std::size_t bytes) noexcept
+    {
+        if (profile_counters *target = current_profile())
+        {
+            detail::profile_add(target->bytes_moved, bytes);
+        }
+    }
+}
+
+#define MIV_PROFILE_CONCAT_IMPL(a, b) a##b
+#define MIV_PROFILE_CONCAT(a, b) MIV_PROFILE_CONCAT_IMPL(a, b)
+
+#if MIV_PROFILE
+    // time the enclosing block as one call of miv::profile_section::section
+    #define MIV_PROFILE_SCOPE(section) \
+        const ::miv::scoped_timer MIV_PROFILE_CONCAT(miv_profile_timer_, __LINE__)(::miv::profile_section::section)
+
+    // record into `target` (profile_counters *) until the end of the enclosing block
+    #define MIV_PROFILE_RECORD_INTO(target) \
+        const ::miv::profile_scope MIV_PROFILE_CONCAT(miv_profile_scope_, __LINE__)(target)
+
+    // remember the caller's target as `name` (to attach worker threads to it)
+    #define MIV_PROFILE_CAPTURE(name) ::miv::profile_counters *const name = ::miv::current_profile()
+
+    #define MIV_PROFILE_ALLOCATION(bytes) ::miv::profile_count_allocation(bytes)
+    #define MIV_PROFILE_BYTES_MOVED(bytes) ::miv::profile_count_bytes_moved(bytes)
+#else
+    #define MIV_PROFILE_SCOPE(section) static_cast<void>(0)
+    #define MIV_PROFILE_RECORD_INTO(target) static_cast<void>(0)
+    #define MIV_PROFILE_CAPTURE(name) static_cast<void>(0)
+    #define MIV_PROFILE_ALLOCATION(bytes) static_cast<void>(0)
+    #define MIV_PROFILE_BYTES_MOVED(bytes) static_cast<void>(0)
+#endif
+
+#endif // MIV_CONTAINERS_PROFILE_H
@@ -0,0 +1,321 @@
+#ifndef MIV_CONTAINERS_SPARSE_MATRIX_H
+#define MIV_CONTAINERS_SPARSE_MATRIX_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "array.hpp"
+#include "matrix.hpp"
+
+namespace miv
+{
+    // Sparse matrix in CSR (compressed sparse row) format.
+    //
+    // Row r owns the half-open range [row_offsets[r], row_offsets[r + 1])
+    // of col_indices/values. Column indices inside a row are strictly increasing.
+    //
+    // The structure (row_offsets + col_indices) is fixed after construction;
+    // values can be rewritten in place, which is how Jacobians with a known
+    // sparsity pattern are refreshed between Newton iterations.
+    template <typename type>
+    class sparse_matrix
+    {
+    public:
+        // basic constructors
+        sparse_matrix();
+
+        // build from ready CSR arrays (validated: sizes, ranges, sorted unique columns)
+        sparse_matrix(std::size_t rows, std::size_t cols,
+                      miv::array<std::size_t> row_offsets,
+                      miv::array<std::size_t> col_indices,
+                      miv::array<type> values);
+
+        // build from CSR structure with all values set to type{}
+        sparse_matrix(std::size_t rows, std::size_t cols,
+                      miv::array<std::size_t> row_offsets,
+                      miv::array<std::size_t> col_indices);
+
+        // keep only the non-zero entries of a dense matrix
+        static sparse_matrix<type> from_dense(const miv::matrix<type> &dense);
+
+        // state methods
+        bool empty() const;
+        std::size_t rows() const;
+        std::size_t cols() const;
+        std::size_t nnz() const;
+
+        // raw CSR access
+        const miv::array<std::size_t> &row_offsets() const;
+        const miv::array<std::size_t> &col_indices() const;
+
+        miv::array<type> &values();
+        const miv::array<type> &values() const;
+
+        // number of stored entries in row r
+        std::size_t row_nnz(std::size_t r) const;
+
+        // position of (r, c) inside values(), or npos if (r, c) is not stored
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+        std::size_t find(std::size_t r, std::size_t c) const;
+
+        // value at (r, c); entries outside the pattern are type{}
+        type at(std::size_t r, std::size_t c) const;
+
+        // dense copy
+        miv::matrix<type> to_dense() const;
+
+        bool operator==(const sparse_matrix<type> &other) const;
+        bool operator!=(const sparse_matrix<type> &other) const;
+
+    private:
+        void validate() const;
+
+        std::size_t m_rows;
+        std::size_t m_cols;
+        miv::array<std::size_t> m_row_offsets;
+        miv::array<std::size_t> m_col_indices;
+        miv::array<type> m_values;
+    };
+
+    // constructors
+    template <typename type>
+    inline sparse_matrix<type>::sparse_matrix()
+        : m_rows(0), m_cols(0), m_row_offsets(), m_col_indices(), m_values() {}
+
+    template <typename type>
+    inline sparse_matrix<type>::sparse_matrix(std::size_t rows, std::size_t cols,
+                                              miv::array<std::size_t> row_offsets,
+                                              miv::array<std::size_t> col_indices,
+                                              miv::array<type> values)
+        : m_rows(rows), m_cols(cols),
+          m_row_offsets(std::move(row_offsets)),
+          m_col_indices(std::move(col_indices)),
+          m_values(std::move(values))
+    {
+        validate();
+    }
+
+    template <typename type>
+    inline sparse_matrix<type>::sparse_matrix(std::size_t rows, std::size_t cols,
+                                              miv::array<std::size_t> row_offsets,
+                                              miv::array<std::size_t> col_indices)
+        : m_rows(rows), m_cols(cols),
+          m_row_offsets(std::move(row_offsets)),
+          m_col_indices(std::move(col_indices)),
+          m_values(m_col_indices.size())
+    {
+        m_values.fill(type{});
+        validate();
+    }
+
+    template <typename type>
+    inline sparse_matrix<type> sparse_matrix<type>::from_dense(const miv::matrix<type> &dense)
+    {
+        const std::size_t rows = dense.rows();
+        const std::size_t cols = dense.cols();
+
+        std::size_t count = 0;
+        for (const auto &v : dense)
+        {
+            if (v != type{})
+            {
+                ++count;
+            }
+        }
+
+        miv::array<std::size_t> offsets(rows + 1);
+        miv::array<std::size_t> indices(count);
+        miv::array<type> values(count);
+
+        std::size_t pos = 0;
+        for (std::size_t r = 0; r < rows; ++r)
+        {
+            offsets[r] = pos;
+            const type *src = dense.row_ptr(r);
+
+            for (std::size_t c = 0; c < cols; ++c)
+            {
+                if (src[c] != type{})
+                {
+                    indices[pos] = c;
+                    values[pos] = src[c];
+                    ++pos;
+                }
+            }
+        }
+        offsets[rows] = pos;
+
+        return sparse_matrix<type>(rows, cols, std::move(offsets), std::move(indices), std::move(values));
+    }
+
+    template <typename type>
+    inline void sparse_matrix<type>::validate() const
+    {
+        if (m_row_offsets.size() != m_rows + 1)
+        {
+            throw std::invalid_argument("sparse_matrix: row_offsets must have rows + 1 elements");
+        }
+
+        if (m_row_offsets[0] != 0 || m_row_offsets[m_rows] != m_col_indices.size())
+        {
+            throw std::invalid_argument("sparse_matrix: row_offsets must start at 0 and end at nnz");
+        }
+
+        if (m_values.size() != m_col_indices.size())
+        {
+            throw std::invalid_argument("sparse_matrix: values and col_indices must have the same size");
+        }
+
+        for (std::size_t r = 0; r < m_rows; ++r)
+        {
+            const std::size_t begin = m_row_offsets[r];
+            const std::size_t end = m_row_offsets[r + 1];
+
+            if (begin > end)
+            {
+                throw std::invalid_argument("sparse_matrix: row_offsets must be non-decreasing");
+            }
+
+            for (std::size_t p = begin; p < end; ++p)
+            {
+                if (m_col_indices[p] >= m_cols)
+                {
+                    throw std::out_of_range("sparse_matrix: column index " + std::to_string(m_col_indices[p]) +
+                                            " is out of range in row " + std::to_string(r));
+                }
+
+                if (p > begin && m_col_indices[p] <= m_col_indices[p - 1])
+                {
+                    throw std::invalid_argument("sparse_matrix: column indices in row " + std::to_string(r) +
+                                                " must be strictly increasing");
+                }
+            }
+        }
+    }
+
+    // state methods
+    template <typename type>
+    inline bool sparse_matrix<type>::empty() const
+    {
+        return m_rows == 0 || m_cols == 0;
+    }
+
+    template <typename type>
+    inline std::size_t sparse_matrix<type>::rows() const
+    {
+        return m_rows;
+    }
+
+    template <typename type>
+    inline std::size_t sparse_matrix<type>::cols() const
+    {
+        return m_cols;
+    }
+
+    template <typename type>
+    inline std::size_t sparse_matrix<type>::nnz() const
+    {
+        return m_values.size();
+    }
+
+    // raw CSR access
+    template <typename type>
+    inline const miv::array<std::size_t> &sparse_matrix<type>::row_offsets() const
+    {
+        return m_row_offsets;
+    }
+
+    template <typename type>
+    inline const miv::array<std::size_t> &sparse_matrix<type>::col_indices() const
+    {
+        return m_col_indices;
+    }
+
+    template <typename type>
+    inline miv::array<type> &sparse_matrix<type>::values()
+    {
+        return m_values;
+    }
+
+    template <typename type>
+    inline const miv::array<type> &sparse_matrix<type>::values() const
+    {
+        return m_values;
+    }
+
+    template <typename type>
+    inline std::size_t sparse_matrix<type>::row_nnz(std::size_t r) const
+    {
+        if (r >= m_rows)
+        {
+            throw std::out_of_range("Row " + std::to_string(r) + " is out of range");
+        }
+
+        return m_row_offsets[r + 1] - m_row_offsets[r];
+    }
+
+    template <typename type>
+    inline std::size_t sparse_matrix<type>::find(std::size_t r, std::size_t c) const
+    {
+        if (r >= m_rows || c >= m_cols)
+        {
+            throw std::out_of_range("Index (" + std::to_string(r) + "," + std::to_string(c) + ") is out of range");
+        }
+
+        // columns are sorted inside a row -> binary search
+        const std::size_t *first = m_col_indices.data() + m_row_offsets[r];
+        const std::size_t *last = m_col_indices.data() + m_row_offsets[r + 1];
+        const std::size_t *it = std::lower_bound(first, last, c);
+
+        if (it == last || *it != c)
+        {
+            return npos;
+        }
+
+        return static_cast<std::size_t>(it - m_col_indices.data());
+    }
+
+    template <typename type>
+    inline type sparse_matrix<type>::at(std::size_t r, std::size_t c) const
+    {
+        const std::size_t pos = find(r, c);
+        return (pos == npos) ? type{} : m_values[pos];
+    }
+
+    template <typename type>
+    inline miv::matrix<type> sparse_matrix<type>::to_dense() const
+    {
+        miv::matrix<type> out(m_rows, m_cols, type{});
+
+        for (std::size_t r = 0; r < m_rows; ++r)
+        {
+            type *dst = out.row_ptr(r);
+            for (std::size_t p = m_row_offsets[r]; p < m_row_offsets[r + 1]; ++p)
+            {
+                dst[m_col_indices[p]] = m_values[p];
+            }
+        }
+
+        return out;
+    }
+
+    template <typename type>
+    inline bool sparse_matrix<type>::operator==(const sparse_matrix<type> &other) const
+    {
+        return m_rows == other.m_rows && m_cols == other.m_cols &&
+               m_row_offsets == other.m_row_offsets &&
+               m_col_indices == other.m_col_indices &&
+               m_values == other.m_values;
+    }
+
+    template <typename type>
+    inline bool sparse_matrix<type>::operator!=(const sparse_matrix<type> &other) const
+    {
+        return !(*this == other);
+    }
+}
+
+#endif // MIV_CONTAINERS_SPARSE_MATRIX_H
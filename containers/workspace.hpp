@@ -0,0 +1,395 @@
+#ifndef MIV_CONTAINERS_WORKSPACE_H
+#define MIV_CONTAINERS_WORKSPACE_H
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+
+#include "profile.hpp"
+
+namespace miv
+{
+    // Bump (arena) allocator for short-lived scratch memory.
+    //
+    // Typical use: one workspace per solver, reset() at the start of every
+    // iteration, all temporaries of the iteration are taken from it:
+    //
+    //   miv::workspace ws;
+    //   for (...)
+    //   {
+    //       ws.reset();
+    //       miv::array<T, miv::workspace_allocator<T>> tmp(n, ws);
+    //       ...
+    //   }
+    //
+    // allocate() only moves a pointer inside the current block. When a block
+    // is exhausted a new (bigger) block is added; reset() then merges all blocks
+    // into one block of the high-water size, so after the first iteration
+    // (warm-up) the workspace never touches the heap again.
+    //
+    // Memory is never freed individually and no destructors are run:
+    // everything taken since the last reset() becomes invalid on reset().
+    // Blocks are 64-byte aligned (a cache line, enough for any SIMD load).
+    class workspace
+    {
+    public:
+        static constexpr std::size_t block_alignment = 64;
+        static constexpr std::size_t default_block_size = 64 * 1024;
+
+        // basic constructors
+        workspace();
+        explicit workspace(std::size_t initial_bytes);
+
+        workspace(const workspace &) = delete;
+        workspace &operator=(const workspace &) = delete;
+
+        workspace(workspace &&obj) noexcept;
+        workspace &operator=(workspace &&obj) noexcept;
+
+        ~workspace();
+
+        // raw storage of `bytes` bytes aligned to `alignment` (power of two)
+        void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+        // uninitialized storage for `count` objects of a trivially destructible type
+        template <typename type>
+        type *allocate(std::size_t count);
+
+        // forget everything taken so far (pointers become invalid),
+        // merge blocks so the next round fits into one block
+        void reset();
+
+        // make sure at least `bytes` are available without growing
+        void reserve(std::size_t bytes);
+
+        // state methods
+        std::size_t used() const;        // bytes taken since the last reset()
+        std::size_t capacity() const;    // bytes owned in all blocks
+        std::size_t high_water() const;  // max used() ever seen
+        std::size_t block_count() const;
+
+    private:
+        struct block
+        {
+            std::byte *data;
+            std::size_t size;
+        };
+
+        static std::byte *allocate_block(std::size_t size);
+        static void free_block(block &b);
+
+        void add_block(std::size_t min_bytes);
+        void release();
+
+        std::vector<block> m_blocks;
+        std::size_t m_current;   // index of the block being filled
+        std::size_t m_offset;    // first free byte in the current block
+        std::size_t m_used;      // bytes taken in blocks before m_current
+        std::size_t m_high_water;
+    };
+
+    // Standard allocator on top of miv::workspace (for miv::array and std containers).
+    //
+    // deallocate() is a no-op: memory goes back only with workspace::reset().
+    // The allocator propagates on copy/move/swap, so moving a workspace-backed
+    // container never copies elements.
+    template <typename type>
+    class workspace_allocator
+    {
+    public:
+        using value_type = type;
+
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+        using is_always_equal = std::false_type;
+
+        workspace_allocator(workspace &ws) noexcept;
+
+        template <typename other>
+        workspace_allocator(const workspace_allocator<other> &obj) noexcept;
+
+        type *allocate(std::size_t count);
+        void deallocate(type *ptr, std::size_t count) noexcept;
+
+        workspace *resource() const noexcept;
+
+        template <typename other>
+        bool operator==(const workspace_allocator<other> &other_alloc) const noexcept;
+
+    private:
+        workspace *m_ws;
+    };
+
+    // ============================================================
+    //                         workspace
+    // ============================================================
+
+    // constructors
+    inline workspace::workspace() : m_blocks(), m_current(0), m_offset(0), m_used(0), m_high_water(0) {}
+
+    inline workspace::workspace(std::size_t initial_bytes) : workspace()
+    {
+        reserve(initial_bytes);
+    }
+
+    inline workspace::workspace(workspace &&obj) noexcept
+        : m_blocks(std::move(obj.m_blocks)),
+          m_current(obj.m_current), m_offset(obj.m_offset),
+          m_used(obj.m_used), m_high_water(obj.m_high_water)
+    {
+        obj.m_blocks.clear();
+        obj.m_current = 0;
+        obj.m_offset = 0;
+        obj.m_used = 0;
+        obj.m_high_water = 0;
+    }
+
+    inline workspace &workspace::operator=(workspace &&obj) noexcept
+    {
+        if (this != &obj)
+        {
+            release();
+
+            m_blocks = std::move(obj.m_blocks);
+            m_current = obj.m_current;
+            m_offset = obj.m_offset;
+            m_used = obj.m_used;
+            m_high_water = obj.m_high_water;
+
+            obj.m_blocks.clear();
+            obj.m_current = 0;
+            obj.m_offset = 0;
+            obj.m_used = 0;
+            obj.m_high_water = 0;
+        }
+
+        return *this;
+    }
+
+    inline workspace::~workspace()
+    {
+        release();
+    }
+
+    // block helpers
+    inline std::byte *workspace::allocate_block(std::size_t size)
+    {
+        MIV_PROFILE_ALLOCATION(size);
+        return static_cast<std::byte *>(::operator new(size, std::align_val_t{ block_alignment }));
+    }
+
+    inline void workspace::free_block(block &b)
+    {
+        ::operator delete(b.data, std::align_val_t{ block_alignment });
+        b.data = nullptr;
+        b.size = 0;
+    }
+
+    inline void workspace::add_block(std::size_t min_bytes)
+    {
+        // Geometric growth: few blocks even for a bad first guess
+        std::size_t size = m_blocks.empty() ? default_block_size : 2 * m_blocks.back().size;
+        if (size < min_bytes)
+        {
+            size = min_bytes;
+        }
+
+        // grow the list first: push_back below cannot throw and leak the block
+        m_blocks.reserve(m_blocks.size() + 1);
+        m_blocks.push_back(block{ allocate_block(size), size });
+    }
+
+    inline void workspace::release()
+    {
+        for (auto &b : m_blocks)
+        {
+            free_block(b);
+        }
+
+        m_blocks.clear();
+        m_current = 0;
+        m_offset = 0;
+        m_used = 0;
+    }
+
+    // allocation
+    inline void *workspace::allocate(std::size_t bytes, std::size_t alignment)
+    {
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+        {
+            throw std::invalid_argument("workspace::allocate(): alignment must be a power of two");
+        }
+
+        if (bytes == 0)
+        {
+            bytes = 1;
+        }
+
+        while (true)
+        {
+            if (m_current < m_blocks.size())
+            {
+                block &b = m_blocks[m_current];
+
+                const auto base = reinterpret_cast<std::uintptr_t>(b.data);
+                const std::uintptr_t aligned = (base + m_offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+                const std::size_t start = static_cast<std::size_t>(aligned - base);
+
+                if (start <= b.size && bytes <= b.size - start)
+                {
+                    m_offset = start + bytes;
+
+                    const std::size_t now_used = m_used + m_offset;
+                    if (now_used > m_high_water)
+                    {
+                        m_high_water = now_used;
+                    }
+
+                    return b.data + start;
+                }
+
+                // current block is full: the rest of it is counted as used
+                m_used += b.size;
+                m_offset = 0;
+                ++m_current;
+                continue;
+            }
+
+            // worst case padding for alignments above the block alignment
+            const std::size_t padding = (alignment > block_alignment) ? alignment : 0;
+            add_block(bytes + padding);
+        }
+    }
+
+    template <typename type>
+    inline type *workspace::allocate(std::size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<type>,
+                      "workspace::allocate<T>(): the workspace never runs destructors");
+
+        if (count > static_cast<std::size_t>(-1) / sizeof(type))
+        {
+            throw std::length_error("workspace::allocate(): " + std::to_string(count) + " elements is too many");
+        }
+
+        return static_cast<type *>(allocate(count * sizeof(type), alignof(type)));
+    }
+
+    inline void workspace::reset()
+    {
+        if (m_blocks.size() > 1)
+        {
+            // Several blocks were needed: replace them by one block that fits the whole round
+            std::size_t total = 0;
+            for (const auto &b : m_blocks)
+            {
+                total += b.size;
+            }
+
+            const std::size_t size = (m_high_water > total) ? m_high_water : total;
+
+            release();
+            m_blocks.push_back(block{ allocate_block(size), size });
+        }
+
+        m_current = 0;
+        m_offset = 0;
+        m_used = 0;
+    }
+
+    inline void workspace::reserve(std::size_t bytes)
+    {
+        if (bytes == 0 || capacity() - used() >= bytes)
+        {
+            return;
+        }
+
+        if (used() == 0)
+        {
+            // nothing is handed out: simply own one block of the requested size
+            release();
+            m_blocks.reserve(1);
+            m_blocks.push_back(block{ allocate_block(bytes), bytes });
+            return;
+        }
+
+        add_block(bytes);
+    }
+
+    // state methods
+    inline std::size_t workspace::used() const
+    {
+        return m_used + m_offset;
+    }
+
+    inline std::size_t workspace::capacity() const
+    {
+        std::size_t total = 0;
+        for (const auto &b : m_blocks)
+        {
+            total += b.size;
+        }
+
+        return total;
+    }
+
+    inline std::size_t workspace::high_water() const
+    {
+        return m_high_water;
+    }
+
+    inline std::size_t workspace::block_count() const
+    {
+        return m_blocks.size();
+    }
+
+    // ============================================================
+    //                     workspace_allocator
+    // ============================================================
+
+    template <typename type>
+    inline workspace_allocator<type>::workspace_allocator(workspace &ws) noexcept : m_ws(&ws) {}
+
+    template <typename type>
+    template <typename other>
+    inline workspace_allocator<type>::workspace_allocator(const workspace_allocator<other> &obj) noexcept
+        : m_ws(obj.resource()) {}
+
+    template <typename type>
+    inline type *workspace_allocator<type>::allocate(std::size_t count)
+    {
+        if (count > static_cast<std::size_t>(-1) / sizeof(type))
+        {
+            throw std::bad_array_new_length();
+        }
+
+        return static_cast<type *>(m_ws->allocate(count * sizeof(type), alignof(type)));
+    }
+
+    template <typename type>
+    inline void workspace_allocator<type>::deallocate(type *, std::size_t) noexcept
+    {
+        // bump allocator: memory is returned by workspace::reset()
+    }
+
+    template <typename type>
+    inline workspace *workspace_allocator<type>::resource() const noexcept
+    {
+        return m_ws;
+    }
+
+    template <typename type>
+    template <typename other>
+    inline bool workspace_allocator<type>::operator==(const workspace_allocator<other> &other_alloc) const noexcept
+    {
+        return m_ws == other_alloc.resource();
+    }
+}
+
+#endif // MIV_CONTAINERS_WORKSPACE_H
@@ -0,0 +1,457 @@
+#ifndef MIV_EXEC_THREAD_POOL_H
+#define MIV_EXEC_THREAD_POOL_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace miv::exec
+{
+    /**
+     * @brief Пул потоков с work-stealing очередями.
+     *
+     * У каждого рабочего потока своя очередь задач:
+     *  - свои задачи берутся с конца (LIFO, горячие данные в кэше)
+     *  - чужие задачи воруются с начала (FIFO, самые крупные куски)
+     *
+     * Параллелизм пула size() включает вызывающий поток: thread_pool(4) создаёт
+     * 3 рабочих потока, а четвёртым работает тот, кто вызвал parallel_for().
+     * thread_pool(1) не создаёт потоков вовсе — всё выполняется на месте.
+     */
+    class thread_pool
+    {
+    public:
+        using task = std::function<void()>;
+
+        explicit thread_pool(std::size_t threads)
+            : m_queues(threads > 1 ? threads - 1 : 0)
+        {
+            const std::size_t workers = m_queues.size();
+            m_threads.reserve(workers);
+
+            for (std::size_t i = 0; i < workers; ++i)
+            {
+                m_threads.emplace_back([this, i] { worker_loop(i); });
+            }
+        }
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_sleep_mutex);
+                m_stop = true;
+            }
+            m_sleep_cv.notify_all();
+
+            for (auto &t : m_threads)
+            {
+                t.join();
+            }
+        }
+
+        /**
+         * @brief Степень параллелизма (рабочие потоки + вызывающий).
+         */
+        std::size_t size() const { return m_queues.size() + 1; }
+
+        /**
+         * @brief Поставить задачу в очередь.
+         *
+         * Из рабочего потока задача кладётся в его собственную очередь,
+         * извне — по кругу в очереди рабочих. В пуле без рабочих выполняется сразу.
+         */
+        void submit(task t)
+        {
+            if (m_queues.empty())
+            {
+                t();
+                return;
+            }
+
+            const std::size_t self = current_worker();
+            const std::size_t target = (self != npos)
+                ? self
+                : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+            // Счётчик увеличивается до публикации задачи, чтобы никогда не уходить в минус
+            m_pending.fetch_add(1, std::memory_order_release);
+
+            {
+                std::lock_guard<std::mutex> lock(m_queues[target].mutex);
+                m_queues[target].tasks.push_back(std::move(t));
+            }
+
+            {
+                // Пустая критическая секция: не даём потоку уснуть между проверкой и ожиданием
+                std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            }
+            m_sleep_cv.notify_one();
+        }
+
+        /**
+         * @brief Выполнить одну задачу из очередей (свою или украденную).
+         *
+         * @return true, если задача была выполнена
+         */
+        bool try_run_one()
+        {
+            task t;
+            if (!try_pop(current_worker(), t))
+            {
+                return false;
+            }
+
+            t();
+            return true;
+        }
+
+        /**
+         * @brief Разбить [begin, end) на куски не меньше grain и выполнить f(lo, hi) параллельно.
+         *
+         * Вызывающий поток сам выполняет первый кусок и, пока ждёт остальные,
+         * помогает разбирать очереди — поэтому вложенные parallel_for не блокируются.
+         * Первое исключение из f пробрасывается вызывающему после завершения всех кусков.
+         */
+        template <typename F>
+        void parallel_for(std::size_t begin, std::size_t end, std::size_t grain, F &&f)
+        {
+            if (end <= begin)
+            {
+                return;
+            }
+
+            const std::size_t count = end - begin;
+            grain = std::max<std::size_t>(grain, 1);
+
+            const std::size_t max_chunks = (count + grain - 1) / grain;
+            const std::size_t chunks = std::min(max_chunks, size() * 4);
+
+            if (chunks <= 1)
+            {
+                f(begin, end);
+                return;
+            }
+
+            struct shared_state
+            {
+                std::atomic<std::size_t> remaining;
+                std::exception_ptr error;
+                std::mutex error_mutex;
+            };
+
+            shared_state state;
+            state.remaining.store(chunks - 1, std::memory_order_relaxed);
+
+            const auto chunk_begin = [begin, count, chunks](std::size_t c)
+            {
+                return begin + (count * c) / chunks;
+            };
+
+            auto run_chunk = [&](std::size_t c)
+            {
+                try
+                {
+                    f(chunk_begin(c), chunk_begin(c + 1));
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(state.error_mutex);
+                    if (!state.error)
+                    {
+                        state.error = std::current_exception();
+                    }
+                }
+            };
+
+            for (std::size_t c = 1; c < chunks; ++c)
+            {
+                submit([&run_chunk, &state, c]
+                {
+                    run_chunk(c);
+                    state.remaining.fetch_sub(1, std::memory_order_acq_rel);
+                });
+            }
+
+            run_chunk(0);
+
+            while (state.remaining.load(std::memory_order_acquire) != 0)
+            {
+                if (!try_run_one())
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            if (state.error)
+            {
+                std::rethrow_exception(state.error);
+            }
+        }
+
+    private:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        struct work_queue
+        {
+            std::mutex mutex;
+            std::deque<task> tasks;
+        };
+
+        /**
+         * @brief Индекс рабочего потока этого пула, либо npos для чужого потока.
+         */
+        std::size_t current_worker() const
+        {
+            return (tls_owner() == this) ? tls_index() : npos;
+        }
+
+        static const thread_pool *&tls_owner()
+        {
+            thread_local const thread_pool *owner = nullptr;
+            return owner;
+        }
+
+        static std::size_t &tls_index()
+        {
+            thread_local std::size_t index = npos;
+            return index;
+        }
+
+        bool try_pop(std::size_t self, task &out)
+        {
+            // Своя очередь: с конца
+            if (self != npos)
+            {
+                auto &q = m_queues[self];
+                std::lock_guard<std::mutex> lock(q.mutex);
+                if (!q.tasks.empty())
+                {
+                    out = std::move(q.tasks.back());
+                    q.tasks.pop_back();
+                    m_pending.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            // Воровство: с начала чужих очередей
+            const std::size_t start = (self != npos) ? self + 1 : 0;
+            for (std::size_t k = 0; k < m_queues.size(); ++k)
+            {
+                const std::size_t victim = (start + k) % m_queues.size();
+                if (victim == self)
+                {
+                    continue;
+                }
+
+                auto &q = m_queues[victim];
+                std::lock_guard<std::mutex> lock(q.mutex);
+                if (!q.tasks.empty())
+                {
+                    out = std::move(q.tasks.front());
+                    q.tasks.pop_front();
+                    m_pending.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void worker_loop(std::size_t index)
+        {
+            tls_owner() = this;
+            tls_index() = index;
+
+            while (true)
+            {
+                task t;
+                if (try_pop(index, t))
+                {
+                    t();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(m_sleep_mutex);
+                m_sleep_cv.wait(lock, [this]
+                {
+                    return m_stop || m_pending.load(std::memory_order_acquire) > 0;
+                });
+
+                if (m_stop && m_pending.load(std::memory_order_acquire) == 0)
+                {
+                    return;
+                }
+            }
+        }
+
+        std::vector<work_queue> m_queues;
+        std::vector<std::thread> m_threads;
+
+        std::atomic<std::size_t> m_pending{0};
+        std::atomic<std::size_t> m_next_queue{0};
+
+        std::mutex m_sleep_mutex;
+        std::condition_variable m_sleep_cv;
+        bool m_stop = false;
+    };
+
+    // ============================================================
+    //               Общий пул и настройки параллелизма
+    // ============================================================
+
+    namespace detail
+    {
+        struct pool_registry
+        {
+            std::mutex mutex;
+            std::unique_ptr<thread_pool> pool;
+            std::atomic<std::size_t> serial_threshold{std::size_t(1) << 16};
+        };
+
+        inline pool_registry &registry()
+        {
+            static pool_registry r;
+            return r;
+        }
+
+        /**
+         * @brief Число потоков по умолчанию: MIV_NUM_THREADS или hardware_concurrency().
+         */
+        inline std::size_t default_thread_count()
+        {
+            if (const char *env = std::getenv("MIV_NUM_THREADS"))
+            {
+                try
+                {
+                    const long long value = std::stoll(env);
+                    if (value > 0)
+                    {
+                        return static_cast<std::size_t>(value);
+                    }
+                }
+                catch (...)
+                {
+                    // некорректное значение — берём число ядер
+                }
+            }
+
+            const unsigned hw = std::thread::hardware_concurrency();
+            return hw == 0 ? 1 : hw;
+        }
+    }
+
+    /**
+     * @brief Общий пул, которым пользуются ядра miv::math.
+     *
+     * Создаётся при первом обращении (MIV_NUM_THREADS или число ядер).
+     */
+    inline thread_pool &default_pool()
+    {
+        auto &r = detail::registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+
+        if (!r.pool)
+        {
+            r.pool = std::make_unique<thread_pool>(detail::default_thread_count());
+        }
+
+        return *r.pool;
+    }
+
+    /**
+     * @brief Пересоздать общий пул с заданным числом потоков (0 — число ядер).
+     *
+     * Нельзя вызывать, пока какое-либо ядро работает на общем пуле.
+     */
+    inline void set_thread_count(std::size_t threads)
+    {
+        if (threads == 0)
+        {
+            const unsigned hw = std::thread::hardware_concurrency();
+            threads = hw == 0 ? 1 : hw;
+        }
+
+        auto &r = detail::registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.pool.reset();
+        r.pool = std::make_unique<thread_pool>(threads);
+    }
+
+    /**
+     * @brief Текущая степень параллелизма общего пула.
+     */
+    inline std::size_t thread_count()
+    {
+        return default_pool().size();
+    }
+
+    /**
+     * @brief Порог распараллеливания: минимальный объём работы ядра
+     * (число поэлементных операций или умножений-сложений), ниже которого
+     * оно выполняется последовательно и не платит за диспетчеризацию.
+     */
+    inline std::size_t serial_threshold()
+    {
+        return detail::registry().serial_threshold.load(std::memory_order_relaxed);
+    }
+
+    inline void set_serial_threshold(std::size_t work)
+    {
+        detail::registry().serial_threshold.store(work, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief parallel_for на общем пуле с учётом порога.
+     *
+     * @param work Оценка объёма работы всего диапазона (для сравнения с serial_threshold())
+     * @param f Вызывается как f(lo, hi) на непересекающихся поддиапазонах
+     */
+    template <typename F>
+    inline void parallel_for(std::size_t begin, std::size_t end, std::size_t work, F &&f)
+    {
+        if (end <= begin)
+        {
+            return;
+        }
+
+        const std::size_t threshold = serial_threshold();
+
+        if (work < threshold)
+        {
+            f(begin, end);
+            return;
+        }
+
+        thread_pool &pool = default_pool();
+
+        if (pool.size() == 1)
+        {
+            f(begin, end);
+            return;
+        }
+
+        // Кусок должен содержать хотя бы threshold работы
+        const std::size_t count = end - begin;
+        const std::size_t per_item = std::max<std::size_t>(work / count, 1);
+        const std::size_t grain = std::max<std::size_t>(threshold / per_item, 1);
+
+        pool.parallel_for(begin, end, grain, std::forward<F>(f));
+    }
+
+} // namespace miv::exec
+
+#endif // MIV_EXEC_THREAD_POOL_H
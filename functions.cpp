@@ -1,6 +1,7 @@
 #include "functions.hpp"
 
 #include <cmath>
+#include <cstddef>
 #include <vector>
 
 /**
@@ -16,13 +17,17 @@
  * 3) Тип FuncFloat задаёт точность вычислений всей системы:
  *      - Замените typedef FuncFloat на Float32/Float64/Float80/Float128 в functions.hpp.
  *      - Все функции автоматически соберутся под новую точность.
+ * 4) Функции шаблонные по miv::ad::Scalar: те же функции инстанцируются и для
+ *    дуальных чисел (точный Якобиан, режим «автоматически»). Поэтому математику
+ *    вызывайте без std:: — sin(x), pow(x, 2); using std::sin и т.д. ниже по файлу
+ *    подключают обычные версии, а для miv::ad::dual их находит ADL.
  *
  * Пример объявления функции:
  * @code
- * template <miv::math::FloatNumber T>
+ * template <miv::ad::Scalar T>
  * inline T func1(miv::array<T> &x)
  * {
- *     return std::cos(x[0]) + x[1] + std::pow(x[2], 2);
+ *     return cos(x[0]) + x[1] + pow(x[2], 2);
  * }
  * @endcode
  *
@@ -36,13 +41,13 @@
  * ---------------------------------------------------------------------------
  * 1) Классическая 2D система:
  * @code
- * template <miv::math::FloatNumber T>
+ * template <miv::ad::Scalar T>
  * inline T example2d_f1(miv::array<T> &x)
  * {
  *     return x[0] * x[0] + x[1] * x[1] - static_cast<T>(1);
  * }
  *
- * template <miv::math::FloatNumber T>
+ * template <miv::ad::Scalar T>
  * inline T example2d_f2(miv::array<T> &x)
  * {
  *     return x[0] - x[1];
@@ -51,19 +56,19 @@
  *
  * 2) 3D система (пример с cos/sin):
  * @code
- * template <miv::math::FloatNumber T>
+ * template <miv::ad::Scalar T>
  * inline T example3d_f1(miv::array<T> &x)
  * {
- *     return std::cos(x[0]) + x[1] + x[2];
+ *     return cos(x[0]) + x[1] + x[2];
  * }
  *
- * template <miv::math::FloatNumber T>
+ * template <miv::ad::Scalar T>
  * inline T example3d_f2(miv::array<T> &x)
  * {
- *     return std::sin(x[1]) + x[0] - x[2];
+ *     return sin(x[1]) + x[0] - x[2];
  * }
  *
- * template <miv::math::FloatNumber T>
+ * template <miv::ad::Scalar T>
  * inline T example3d_f3(miv::array<T> &x)
  * {
  *     return x[0] * x[0] + x[1] * x[1] + x[2] * x[2] - static_cast<T>(1);
@@ -72,13 +77,13 @@
  *
  * 3) Полиномиальная система:
  * @code
- * template <miv::math::FloatNumber T>
+ * template <miv::ad::Scalar T>
  * inline T poly_f1(miv::array<T> &x)
  * {
  *     return x[0] * x[0] * x[0] - x[1] + static_cast<T>(2);
  * }
  *
- * template <miv::math::FloatNumber T>
+ * template <miv::ad::Scalar T>
  * inline T poly_f2(miv::array<T> &x)
  * {
  *     return x[1] * x[1] - x[0] + static_cast<T>(1);
@@ -87,27 +92,69 @@
  *
  * 4) Пример с разделением переменных:
  * @code
- * template <miv::math::FloatNumber T>
+ * template <miv::ad::Scalar T>
  * inline T sep_f1(miv::array<T> &x)
  * {
- *     return std::sin(x[0]) - static_cast<T>(0.5);
+ *     return sin(x[0]) - static_cast<T>(0.5);
  * }
  *
- * template <miv::math::FloatNumber T>
+ * template <miv::ad::Scalar T>
  * inline T sep_f2(miv::array<T> &x)
  * {
- *     return std::exp(x[1]) - static_cast<T>(3);
+ *     return exp(x[1]) - static_cast<T>(3);
  * }
  * @endcode
  *
  * ---------------------------------------------------------------------------
  * КАК ДОБАВИТЬ СВОЮ ФУНКЦИЮ
  * ---------------------------------------------------------------------------
- * 1) Создайте новую функцию в стиле template <FloatNumber T>.
+ * 1) Создайте новую функцию в стиле template <miv::ad::Scalar T>.
  * 2) Проверьте индексы x[i].
- * 3) НЕ забудьте добавить её в return { ... } ниже.
+ * 3) НЕ забудьте добавить её в return { ... } в system_functions() ниже.
+ * 4) Если включена векторная форма (HasSystemVector = true в functions.hpp),
+ *    перепишите и system_vector(): out[i] должен совпадать с i-й функцией
+ *    списка. Отладочная сборка сверяет их в x0 (check_system_vector).
+ *
+ * ---------------------------------------------------------------------------
+ * ВЕКТОРНАЯ ФОРМА
+ * ---------------------------------------------------------------------------
+ * Если несколько уравнений используют общие члены (например, sin(x[1] + 1)),
+ * задайте систему целиком в system_vector(x, out): общий член считается один
+ * раз, и на вычисление F приходится один вызов, а не n. Решатель использует
+ * её, только если в functions.hpp поставить HasSystemVector = true (по
+ * умолчанию false: образец ниже повторяет func1/func2 и не следует за
+ * изменениями списка сам):
+ * @code
+ * template <miv::ad::Scalar T>
+ * void system_vector(miv::array_view<const T> x, miv::array_view<T> out)
+ * {
+ *     const T s = sin(x[1] + 1);
+ *     out[0] = x[0] - s;
+ *     out[1] = s * x[0] + x[1];
+ * }
+ * @endcode
+ * Компоненты out обязаны совпадать с функциями get_system_functions() —
+ * по их числу определяется размерность системы.
+ *
+ * ---------------------------------------------------------------------------
+ * РАЗРЕЖЕННЫЕ СИСТЕМЫ
+ * ---------------------------------------------------------------------------
+ * Для больших систем, где каждое уравнение зависит от немногих переменных,
+ * выберите в меню разреженный численный Якобиан. Шаблон зависимостей можно
+ * объявить в get_system_sparsity() (например, для трёхдиагональной системы
+ * строка i = { i - 1, i, i + 1 }); если вернуть {}, он будет найден численно.
  */
 
+// Математика без квалификации: для FuncFloat — эти версии, для dual — ADL
+using std::sin;
+using std::cos;
+using std::tan;
+using std::exp;
+using std::log;
+using std::sqrt;
+using std::pow;
+using std::abs;
+
 // ============================================================================
 //                  Реальная система уравнений (пример)
 // ============================================================================
@@ -117,10 +164,10 @@
  *
  * f1(x, y) = x - sin(y + 1) + 1.2
  */
-template <miv::math::FloatNumber T>
+template <miv::ad::Scalar T>
 inline T func1(miv::array<T> &x)
 {
-    return x[0] - std::sin(x[1] + 1) + static_cast<T>(1.2);
+    return x[0] - sin(x[1] + 1) + static_cast<T>(1.2);
 }
 
 /**
@@ -128,10 +175,20 @@ inline T func1(miv::array<T> &x)
  *
  * f2(x, y) = cos(x) + 2y - 2
  */
-template <miv::math::FloatNumber T>
+template <miv::ad::Scalar T>
 inline T func2(miv::array<T> &x)
 {
-    return std::cos(x[0]) + 2*x[1] - static_cast<T>(2);
+    return cos(x[0]) + 2*x[1] - static_cast<T>(2);
+}
+
+/**
+ * @brief Список функций системы для типа T (FuncFloat или DualFloat).
+ */
+template <miv::ad::Scalar T>
+std::vector<NonlinearFunction<T>> system_functions()
+{
+    // TODO: добавь свою функцию выше и не забудь включить её сюда:
+    return { &func1<T>, &func2<T> };
 }
 
 /**
@@ -139,6 +196,36 @@ inline T func2(miv::array<T> &x)
  */
 std::vector<NonlinearFunction<FuncFloat>> get_system_functions()
 {
-    // TODO: добавь свою функцию выше и не забудь включить её сюда:
-    return { &func1<FuncFloat>, &func2<FuncFloat> };
+    return system_functions<FuncFloat>();
+}
+
+/**
+ * @brief Те же функции для дуальных чисел (автоматический Якобиан).
+ */
+std::vector<NonlinearFunction<DualFloat>> get_system_dual_functions()
+{
+    return system_functions<DualFloat>();
+}
+
+/**
+ * @brief Векторная форма: f1 и f2 одним проходом (должна совпадать с func1/func2).
+ */
+template <miv::ad::Scalar T>
+void system_vector(miv::array_view<const T> x, miv::array_view<T> out)
+{
+    out[0] = x[0] - sin(x[1] + 1) + static_cast<T>(1.2);
+    out[1] = cos(x[0]) + 2*x[1] - static_cast<T>(2);
+}
+
+template void system_vector<FuncFloat>(miv::array_view<const FuncFloat>, miv::array_view<FuncFloat>);
+template void system_vector<DualFloat>(miv::array_view<const DualFloat>, miv::array_view<DualFloat>);
+
+/**
+ * @brief Шаблон разреженности Якобиана (пусто — определить численно).
+ */
+std::vector<std::vector<std::size_t>> get_system_sparsity()
+{
+    // Для func1/func2 матрица плотная 2 x 2, отдельный шаблон не нужен:
+    // return { { 0, 1 }, { 0, 1 } };
+    return {};
 }
@@ -3,12 +3,18 @@
 
 #include <vector>
 #include <cstddef>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <stdexcept>
 
 #if __has_include(<stdfloat>)
     #include <stdfloat>
 #endif
 
+#include "ad/dual.hpp"
 #include "containers/array.hpp"
+#include "containers/matrix_view.hpp"
 #include "math/helpers.hpp"
 
 /**
@@ -19,6 +25,9 @@
  * Пользователь определяет набор функций, возвращаемых get_system_functions().
  * Размерность системы n равна количеству функций в этом векторе.
  * Каждая функция принимает вектор x (miv::array<T>&) и возвращает значение T.
+ * Та же система может быть задана и целиком — system_vector(x, out) пишет все
+ * компоненты за один вызов (HasSystemVector = true включает эту форму; по
+ * умолчанию решатель вызывает функции списка по одной).
  * Тип FuncFloat задаёт точность вычислений ВСЕЙ системы: достаточно изменить typedef,
  * и все функции автоматически собираются под новую точность.
  */
@@ -64,17 +73,23 @@ using Float80 = long double;
 /// Тип точности для всей системы: перепишите на Float32/Float64/Float80/Float128.
 using FuncFloat = Float128;
 
+/// Сколько столбцов Якобиана считает один проход автоматического дифференцирования.
+inline constexpr std::size_t AutoDiffWidth = 4;
+
+/// Дуальные числа для JacobianMode::Automatic: значение FuncFloat и AutoDiffWidth производных.
+using DualFloat = miv::ad::dual<FuncFloat, AutoDiffWidth>;
+
 /**
  * @brief Указатель на нелинейную функцию системы F(x)=0.
  *
- * @tparam T Тип чисел (FloatNumber)
+ * @tparam T Тип чисел (FloatNumber или miv::ad::dual)
  *
  * Каждая функция:
  *  - принимает miv::array<T>& x
  *  - возвращает значение T
  *  - НЕ должна изменять x (хотя параметр не const)
  */
-template <miv::math::FloatNumber T>
+template <miv::ad::Scalar T>
 using NonlinearFunction = T(*)(miv::array<T> &);
 
 /**
@@ -86,4 +101,70 @@ using NonlinearFunction = T(*)(miv::array<T> &);
  */
 std::vector<NonlinearFunction<FuncFloat>> get_system_functions();
 
+/**
+ * @brief Те же функции, инстанцированные для дуальных чисел (JacobianMode::Automatic).
+ *
+ * @return std::vector<NonlinearFunction<DualFloat>> той же длины и в том же порядке
+ */
+std::vector<NonlinearFunction<DualFloat>> get_system_dual_functions();
+
+/// Задана ли векторная форма system_vector(); false — решатель вызывает функции по одной.
+/// Включайте, только переписав system_vector() под свои функции (functions.cpp, шаг 4).
+inline constexpr bool HasSystemVector = false;
+
+/**
+ * @brief Векторная форма той же системы: все n компонент F(x) за один вызов.
+ *
+ * @tparam T Тип чисел (FuncFloat или DualFloat — обе инстанцированы в functions.cpp)
+ *
+ * out[i] должен совпадать с i-й функцией get_system_functions(). Общие
+ * подвыражения нескольких уравнений здесь считаются один раз, а решатель
+ * делает один вызов на вычисление F вместо n косвенных.
+ */
+template <miv::ad::Scalar T>
+void system_vector(miv::array_view<const T> x, miv::array_view<T> out);
+
+/**
+ * @brief Отладочная проверка: system_vector(x) совпадает с функциями get_system_functions() в точке x.
+ *
+ * Вызывается в начальной точке отладочных сборок при HasSystemVector: забытое
+ * в system_vector() уравнение иначе решалось бы молча.
+ *
+ * @throws std::logic_error с номером первой несовпавшей компоненты
+ */
+inline void check_system_vector(const miv::array<FuncFloat> &x)
+{
+    auto functions = get_system_functions();
+    miv::array<FuncFloat> point(x);
+    miv::array<FuncFloat> values(functions.size());
+    system_vector<FuncFloat>(miv::array_view<const FuncFloat>(point.data(), point.size()),
+                             miv::array_view<FuncFloat>(values.data(), values.size()));
+
+    const FuncFloat tolerance = 1024 * std::numeric_limits<FuncFloat>::epsilon();
+    for (std::size_t i = 0; i < functions.size(); ++i)
+    {
+        const FuncFloat expected = functions[i](point);
+        if (!std::isfinite(expected) && !std::isfinite(values[i]))
+        {
+            continue;
+        }
+        if (!(std::abs(values[i] - expected) <= tolerance * (1 + std::abs(expected))))
+        {
+            throw std::logic_error("system_vector() does not match get_system_functions() at x0: component " +
+                                   std::to_string(i) + " (HasSystemVector, functions.cpp)");
+        }
+    }
+}
+
+/**
+ * @brief Необязательный шаблон разреженности Якобиана.
+ *
+ * Элемент i — номера переменных x[j], от которых зависит i-я функция.
+ * Пустой вектор означает «шаблон не задан»: в разреженном режиме он
+ * определяется численно в начальной точке (miv::math::detect_sparsity).
+ *
+ * @return std::vector<std::vector<std::size_t>> (пустой или длины n)
+ */
+std::vector<std::vector<std::size_t>> get_system_sparsity();
+
 #endif // QM_FUNCTIONS_HPP
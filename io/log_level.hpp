@@ -0,0 +1,67 @@
+#ifndef MIV_IO_LOG_LEVEL_H
+#define MIV_IO_LOG_LEVEL_H
+
+#include <string_view>
+
+namespace miv::io
+{
+    /**
+     * @brief Подробность журнала итераций.
+     *
+     * - off:   журнал не ведётся (callback не устанавливается, цикл ничего не форматирует)
+     * - norms: одна строка на итерацию — k, ||F||, ||s||, λ
+     * - full:  полный блок с векторами x^k, F(x^k), s^k, x^{k+1}
+     */
+    enum class log_level
+    {
+        off = 0,
+        norms = 1,
+        full = 2
+    };
+
+    /**
+     * @brief Разобрать уровень по имени ("off", "norms", "full") или номеру ("0".."2").
+     *
+     * @return false, если строка не распознана (level не меняется)
+     */
+    inline bool parse_log_level(std::string_view text, log_level &level)
+    {
+        if (text == "off" || text == "0")
+        {
+            level = log_level::off;
+        }
+        else if (text == "norms" || text == "1")
+        {
+            level = log_level::norms;
+        }
+        else if (text == "full" || text == "2")
+        {
+            level = log_level::full;
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Имя уровня (обратное к parse_log_level).
+     */
+    constexpr std::string_view to_string(log_level level)
+    {
+        switch (level)
+        {
+        case log_level::off:
+            return "off";
+        case log_level::norms:
+            return "norms";
+        case log_level::full:
+            return "full";
+        }
+        return "unknown";
+    }
+}
+
+#endif // MIV_IO_LOG_LEVEL_H
@@ -0,0 +1,685 @@
+#ifndef MIV_IO_MATRIX_FILE_H
+#define MIV_IO_MATRIX_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#if __has_include(<stdfloat>)
+    #include <stdfloat>
+#endif
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "containers/array.hpp"
+#include "containers/matrix.hpp"
+#include "containers/matrix_view.hpp"
+
+namespace miv::io
+{
+    // ============================================================
+    //                  Формат двоичной матрицы (.qmm)
+    // ============================================================
+    //
+    // [matrix_file_header][заполнение до data_offset][rows * cols элементов]
+    //
+    // Элементы идут по строкам подряд (как в miv::matrix), в порядке байт
+    // машины, которая писала файл. data_offset кратен alignment, поэтому
+    // отображённые в память данные выровнены так же, как miv::array.
+    // Вектор — rank 1 и cols = 1.
+
+    inline constexpr char matrix_file_magic[8] = { 'Q', 'M', 'M', 'A', 'T', 'R', 'X', '\0' };
+    inline constexpr std::uint32_t matrix_file_version = 1;
+    inline constexpr std::uint32_t matrix_file_byte_order = 0x01020304u;
+    inline constexpr std::uint32_t matrix_file_alignment = 64;
+
+    /**
+     * @brief Тип элементов: формат IEEE, а не имя типа C++ (float и std::float32_t — одно и то же).
+     */
+    enum class matrix_dtype : std::uint32_t
+    {
+        float32 = 1,
+        float64 = 2,
+        float80 = 3,    ///< x87 extended (long double GCC/Clang на x86), 16 байт на элемент
+        float128 = 4    ///< IEEE binary128
+    };
+
+    constexpr const char *to_string(matrix_dtype dtype)
+    {
+        switch (dtype)
+        {
+        case matrix_dtype::float32:
+            return "float32";
+        case matrix_dtype::float64:
+            return "float64";
+        case matrix_dtype::float80:
+            return "float80";
+        case matrix_dtype::float128:
+            return "float128";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @brief Код формата для числа с плавающей точкой T (по разрядности мантиссы).
+     */
+    template <typename T>
+    constexpr matrix_dtype dtype_of()
+    {
+        static_assert(std::numeric_limits<T>::is_iec559 || std::numeric_limits<T>::digits == 64,
+                      "matrix_file: unsupported floating-point type");
+
+        constexpr int digits = std::numeric_limits<T>::digits;
+        static_assert(digits == 24 || digits == 53 || digits == 64 || digits == 113,
+                      "matrix_file: unsupported floating-point type");
+
+        if constexpr (digits == 24)
+        {
+            return matrix_dtype::float32;
+        }
+        else if constexpr (digits == 53)
+        {
+            return matrix_dtype::float64;
+        }
+        else if constexpr (digits == 64)
+        {
+            return matrix_dtype::float80;
+        }
+        else
+        {
+            return matrix_dtype::float128;
+        }
+    }
+
+    /**
+     * @brief Заголовок файла (64 байта).
+     */
+    struct matrix_file_header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint32_t dtype;          ///< matrix_dtype
+        std::uint32_t element_size;   ///< sizeof элемента у писавшей машины
+        std::uint32_t rank;           ///< 1 — вектор, 2 — матрица
+        std::uint32_t alignment;      ///< кратность data_offset
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t data_offset;    ///< смещение первого элемента от начала файла
+        std::uint64_t reserved;
+    };
+
+    static_assert(sizeof(matrix_file_header) == 64, "matrix_file_header must have no padding");
+
+    // ============================================================
+    //                        mapped_file
+    // ============================================================
+
+    /**
+     * @brief Файл, отображённый в память только для чтения (RAII, только перемещение).
+     *
+     * Страницы подгружаются ОС по мере обращения: открытие не читает файл целиком.
+     */
+    class mapped_file
+    {
+    public:
+        mapped_file() = default;
+
+        /**
+         * @throws std::runtime_error если файл не открывается, пуст или не отображается
+         */
+        explicit mapped_file(const std::string &path)
+        {
+#if defined(_WIN32)
+            m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE)
+            {
+                throw std::runtime_error("mapped_file: cannot open '" + path + "'");
+            }
+
+            LARGE_INTEGER size{};
+            if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+            {
+                close();
+                throw std::runtime_error("mapped_file: '" + path + "' is empty or unreadable");
+            }
+            m_size = static_cast<std::size_t>(size.QuadPart);
+
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            m_data = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (!m_data)
+            {
+                close();
+                throw std::runtime_error("mapped_file: cannot map '" + path + "'");
+            }
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                throw std::runtime_error("mapped_file: cannot open '" + path + "'");
+            }
+
+            struct stat st{};
+            if (::fstat(fd, &st) != 0 || st.st_size == 0)
+            {
+                ::close(fd);
+                throw std::runtime_error("mapped_file: '" + path + "' is empty or unreadable");
+            }
+            m_size = static_cast<std::size_t>(st.st_size);
+
+            void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);   // отображение держит файл само
+            if (data == MAP_FAILED)
+            {
+                m_size = 0;
+                throw std::runtime_error("mapped_file: cannot map '" + path + "'");
+            }
+            m_data = data;
+#endif
+        }
+
+        mapped_file(const mapped_file &) = delete;
+        mapped_file &operator=(const mapped_file &) = delete;
+
+        mapped_file(mapped_file &&other) noexcept { swap(other); }
+
+        mapped_file &operator=(mapped_file &&other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+                swap(other);
+            }
+            return *this;
+        }
+
+        ~mapped_file() { close(); }
+
+        const std::byte *data() const { return static_cast<const std::byte *>(m_data); }
+        std::size_t size() const { return m_size; }
+        bool empty() const { return m_data == nullptr; }
+
+    private:
+        void swap(mapped_file &other) noexcept
+        {
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+#if defined(_WIN32)
+            std::swap(m_file, other.m_file);
+            std::swap(m_mapping, other.m_mapping);
+#endif
+        }
+
+        void close() noexcept
+        {
+#if defined(_WIN32)
+            if (m_data)
+            {
+                UnmapViewOfFile(m_data);
+            }
+            if (m_mapping)
+            {
+                CloseHandle(m_mapping);
+            }
+            if (m_file != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(m_file);
+            }
+            m_mapping = nullptr;
+            m_file = INVALID_HANDLE_VALUE;
+#else
+            if (m_data)
+            {
+                ::munmap(m_data, m_size);
+            }
+#endif
+            m_data = nullptr;
+            m_size = 0;
+        }
+
+        void *m_data = nullptr;
+        std::size_t m_size = 0;
+#if defined(_WIN32)
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#endif
+    };
+
+    // ============================================================
+    //                     Проверка заголовка
+    // ============================================================
+
+    namespace detail
+    {
+        inline std::size_t element_size_of(matrix_dtype dtype)
+        {
+            switch (dtype)
+            {
+            case matrix_dtype::float32:
+                return 4;
+            case matrix_dtype::float64:
+                return 8;
+            case matrix_dtype::float80:
+            case matrix_dtype::float128:
+                return 16;
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Прочитать и проверить заголовок отображённого файла.
+         *
+         * @throws std::runtime_error при чужом/повреждённом/усечённом файле
+         */
+        inline matrix_file_header parse_header(const mapped_file &file, const std::string &path)
+        {
+            if (file.size() < sizeof(matrix_file_header))
+            {
+                throw std::runtime_error("matrix_file: '" + path + "' is too short for a header");
+            }
+
+            matrix_file_header h;
+            std::memcpy(&h, file.data(), sizeof(h));
+
+            if (std::memcmp(h.magic, matrix_file_magic, sizeof(matrix_file_magic)) != 0)
+            {
+                throw std::runtime_error("matrix_file: '" + path + "' is not a matrix file");
+            }
+            if (h.version != matrix_file_version)
+            {
+                throw std::runtime_error("matrix_file: '" + path + "' has unsupported version " +
+                                         std::to_string(h.version));
+            }
+            if (h.byte_order != matrix_file_byte_order)
+            {
+                throw std::runtime_error("matrix_file: '" + path + "' was written with a different byte order");
+            }
+            if (h.rank != 1 && h.rank != 2)
+            {
+                throw std::runtime_error("matrix_file: '" + path + "' has invalid rank " + std::to_string(h.rank));
+            }
+            if (h.rank == 1 && h.cols != 1)
+            {
+                throw std::runtime_error("matrix_file: '" + path + "' is a vector with cols != 1");
+            }
+
+            const std::size_t expected = element_size_of(static_cast<matrix_dtype>(h.dtype));
+            if (expected == 0 || h.element_size != expected)
+            {
+                throw std::runtime_error("matrix_file: '" + path + "' has unsupported element type");
+            }
+
+            if (h.cols != 0 && h.rows > std::numeric_limits<std::uint64_t>::max() / h.cols / h.element_size)
+            {
+                throw std::runtime_error("matrix_file: '" + path + "' has an impossible shape");
+            }
+
+            const std::uint64_t payload = h.rows * h.cols * h.element_size;
+            if (h.data_offset < sizeof(matrix_file_header) || h.data_offset > file.size() ||
+                payload > file.size() - h.data_offset)
+            {
+                throw std::runtime_error("matrix_file: '" + path + "' is truncated: expected " +
+                                         std::to_string(h.data_offset + payload) + " bytes, got " +
+                                         std::to_string(file.size()));
+            }
+
+            return h;
+        }
+
+        /**
+         * @brief out[i] = (T) src[i] для элементов формата dtype.
+         *
+         * @throws std::runtime_error если формат не представим на этой платформе
+         */
+        template <typename T>
+        void convert(matrix_dtype dtype, const std::byte *src, std::size_t count, T *out)
+        {
+            auto copy_as = [&]<typename S>()
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    S value;
+                    std::memcpy(&value, src + i * sizeof(S), sizeof(S));
+                    out[i] = static_cast<T>(value);
+                }
+            };
+
+            if (dtype == dtype_of<T>() && sizeof(T) == element_size_of(dtype))
+            {
+                std::memcpy(out, src, count * sizeof(T));
+                return;
+            }
+
+            switch (dtype)
+            {
+            case matrix_dtype::float32:
+                copy_as.template operator()<float>();
+                return;
+            case matrix_dtype::float64:
+                copy_as.template operator()<double>();
+                return;
+            case matrix_dtype::float80:
+                if constexpr (std::numeric_limits<long double>::digits == 64 && sizeof(long double) == 16)
+                {
+                    copy_as.template operator()<long double>();
+                    return;
+                }
+                break;
+            case matrix_dtype::float128:
+#ifdef __STDCPP_FLOAT128_T__
+                copy_as.template operator()<std::float128_t>();
+                return;
+#else
+                if constexpr (std::numeric_limits<long double>::digits == 113)
+                {
+                    copy_as.template operator()<long double>();
+                    return;
+                }
+                break;
+#endif
+            }
+
+            throw std::runtime_error(std::string("matrix_file: ") + to_string(dtype) +
+                                     " elements are not supported on this platform");
+        }
+    }
+
+    // ============================================================
+    //                      matrix_file_view
+    // ============================================================
+
+    /**
+     * @brief Отображённый в память файл матрицы/вектора: данные читаются без копии.
+     *
+     * Тип элементов файла должен совпадать с T (проверяется при открытии);
+     * для преобразования типов — load_matrix / load_array.
+     *
+     * @code
+     * miv::io::matrix_file_view<double> J("jacobian.qmm");
+     * miv::matrix_view<const double> view = J.matrix();
+     * @endcode
+     *
+     * Представления (matrix(), array()) действительны, пока жив объект.
+     */
+    template <typename T>
+        requires std::is_floating_point_v<T>
+    class matrix_file_view
+    {
+    public:
+        /**
+         * @throws std::runtime_error если файл повреждён или хранит элементы другого типа
+         */
+        explicit matrix_file_view(const std::string &path) : m_file(path)
+        {
+            m_header = detail::parse_header(m_file, path);
+
+            if (static_cast<matrix_dtype>(m_header.dtype) != dtype_of<T>() || m_header.element_size != sizeof(T))
+            {
+                throw std::runtime_error(std::string("matrix_file_view: '") + path + "' stores " +
+                                         to_string(static_cast<matrix_dtype>(m_header.dtype)) + ", expected " +
+                                         to_string(dtype_of<T>()));
+            }
+
+            if (reinterpret_cast<std::uintptr_t>(m_file.data() + m_header.data_offset) % alignof(T) != 0)
+            {
+                throw std::runtime_error("matrix_file_view: '" + path + "' payload is misaligned");
+            }
+        }
+
+        std::size_t rank() const { return m_header.rank; }
+        std::size_t rows() const { return static_cast<std::size_t>(m_header.rows); }
+        std::size_t cols() const { return static_cast<std::size_t>(m_header.cols); }
+        std::size_t size() const { return rows() * cols(); }
+
+        const T *data() const { return reinterpret_cast<const T *>(m_file.data() + m_header.data_offset); }
+
+        miv::matrix_view<const T> matrix() const { return miv::matrix_view<const T>(data(), rows(), cols()); }
+        miv::array_view<const T> array() const { return miv::array_view<const T>(data(), size()); }
+
+    private:
+        mapped_file m_file;
+        matrix_file_header m_header{};
+    };
+
+    // ============================================================
+    //                     matrix_file_writer
+    // ============================================================
+
+    /**
+     * @brief Потоковая запись матрицы/вектора: заголовок сразу, данные — порциями.
+     *
+     * Размер известен заранее, поэтому заголовок пишется в конструкторе, а
+     * элементы можно отдавать по строке или любыми кусками — вся матрица в
+     * памяти не нужна.
+     *
+     * @code
+     * miv::io::matrix_file_writer<double> out("J.qmm", n, n);
+     * for (std::size_t r = 0; r < n; ++r) out.write(row(r), n);
+     * out.close();
+     * @endcode
+     *
+     * close() проверяет, что записано ровно rows * cols элементов. Деструктор
+     * закрывает файл без исключений: недописанный файл читатель отвергнет как
+     * усечённый.
+     */
+    template <typename T>
+        requires std::is_floating_point_v<T>
+    class matrix_file_writer
+    {
+    public:
+        /**
+         * @brief Матрица rows x cols.
+         *
+         * @throws std::runtime_error если файл не открывается
+         */
+        matrix_file_writer(const std::string &path, std::size_t rows, std::size_t cols)
+            : matrix_file_writer(path, rows, cols, 2)
+        {
+        }
+
+        /**
+         * @brief Вектор длины n.
+         */
+        matrix_file_writer(const std::string &path, std::size_t n)
+            : matrix_file_writer(path, n, 1, 1)
+        {
+        }
+
+        matrix_file_writer(const matrix_file_writer &) = delete;
+        matrix_file_writer &operator=(const matrix_file_writer &) = delete;
+
+        ~matrix_file_writer()
+        {
+            if (m_file)
+            {
+                std::fclose(m_file);
+            }
+        }
+
+        /**
+         * @brief Дописать count элементов.
+         *
+         * @throws std::length_error если элементов больше, чем rows * cols
+         * @throws std::runtime_error при ошибке записи
+         */
+        void write(const T *values, std::size_t count)
+        {
+            if (!m_file)
+            {
+                throw std::runtime_error("matrix_file_writer: '" + m_path + "' is already closed");
+            }
+            if (count > m_total - m_written)
+            {
+                throw std::length_error("matrix_file_writer: more than " + std::to_string(m_total) +
+                                        " elements written to '" + m_path + "'");
+            }
+            if (count != 0 && std::fwrite(values, sizeof(T), count, m_file) != count)
+            {
+                throw std::runtime_error("matrix_file_writer: write to '" + m_path + "' failed");
+            }
+            m_written += count;
+        }
+
+        void write(miv::array_view<const T> values) { write(values.data(), values.size()); }
+
+        std::size_t written() const { return m_written; }
+        std::size_t total() const { return m_total; }
+        const std::string &path() const { return m_path; }
+
+        /**
+         * @brief Закрыть файл.
+         *
+         * @throws std::runtime_error если записаны не все элементы или сброс на диск не удался
+         */
+        void close()
+        {
+            if (!m_file)
+            {
+                return;
+            }
+
+            const bool flushed = std::fflush(m_file) == 0;
+            const bool closed = std::fclose(m_file) == 0;
+            m_file = nullptr;
+
+            if (m_written != m_total)
+            {
+                throw std::runtime_error("matrix_file_writer: '" + m_path + "' closed after " +
+                                         std::to_string(m_written) + " of " + std::to_string(m_total) +
+                                         " elements");
+            }
+            if (!flushed || !closed)
+            {
+                throw std::runtime_error("matrix_file_writer: cannot finish '" + m_path + "'");
+            }
+        }
+
+    private:
+        matrix_file_writer(const std::string &path, std::size_t rows, std::size_t cols, std::uint32_t rank)
+            : m_path(path), m_total(rows * cols)
+        {
+            m_file = std::fopen(path.c_str(), "wb");
+            if (!m_file)
+            {
+                throw std::runtime_error("matrix_file_writer: cannot open '" + path + "' for writing");
+            }
+            std::setvbuf(m_file, nullptr, _IOFBF, 1 << 20);
+
+            matrix_file_header header{};
+            std::memcpy(header.magic, matrix_file_magic, sizeof(matrix_file_magic));
+            header.version = matrix_file_version;
+            header.byte_order = matrix_file_byte_order;
+            header.dtype = static_cast<std::uint32_t>(dtype_of<T>());
+            header.element_size = sizeof(T);
+            header.rank = rank;
+            header.alignment = matrix_file_alignment;
+            header.rows = rows;
+            header.cols = cols;
+
+            // Заголовок сам занимает ровно одну единицу выравнивания: данные идут сразу за ним
+            static_assert(sizeof(matrix_file_header) % matrix_file_alignment == 0);
+            header.data_offset = sizeof(matrix_file_header);
+
+            if (std::fwrite(&header, sizeof(header), 1, m_file) != 1)
+            {
+                std::fclose(m_file);
+                m_file = nullptr;
+                throw std::runtime_error("matrix_file_writer: cannot write header to '" + path + "'");
+            }
+        }
+
+        std::string m_path;
+        std::FILE *m_file = nullptr;
+        std::size_t m_total = 0;
+        std::size_t m_written = 0;
+    };
+
+    // ============================================================
+    //                  Загрузка и сохранение целиком
+    // ============================================================
+
+    /**
+     * @brief Форма и тип элементов файла (без чтения данных).
+     */
+    inline matrix_file_header read_matrix_file_header(const std::string &path)
+    {
+        const mapped_file file(path);
+        return detail::parse_header(file, path);
+    }
+
+    /**
+     * @brief Прочитать матрицу (вектор — как столбец n x 1) с приведением элементов к T.
+     */
+    template <typename T>
+        requires std::is_floating_point_v<T>
+    miv::matrix<T> load_matrix(const std::string &path)
+    {
+        const mapped_file file(path);
+        const matrix_file_header h = detail::parse_header(file, path);
+
+        miv::matrix<T> m(static_cast<std::size_t>(h.rows), static_cast<std::size_t>(h.cols), miv::uninitialized);
+        detail::convert(static_cast<matrix_dtype>(h.dtype), file.data() + h.data_offset, m.size(), m.data());
+        return m;
+    }
+
+    /**
+     * @brief Прочитать вектор (или матрицу n x 1 / 1 x n) с приведением элементов к T.
+     *
+     * @throws std::runtime_error если в файле матрица, а не вектор
+     */
+    template <typename T>
+        requires std::is_floating_point_v<T>
+    miv::array<T> load_array(const std::string &path)
+    {
+        const mapped_file file(path);
+        const matrix_file_header h = detail::parse_header(file, path);
+
+        if (h.rows != 1 && h.cols != 1)
+        {
+            throw std::runtime_error("load_array: '" + path + "' holds a " + std::to_string(h.rows) + "x" +
+                                     std::to_string(h.cols) + " matrix, not a vector");
+        }
+
+        miv::array<T> a(static_cast<std::size_t>(h.rows * h.cols), miv::uninitialized);
+        detail::convert(static_cast<matrix_dtype>(h.dtype), file.data() + h.data_offset, a.size(), a.data());
+        return a;
+    }
+
+    template <typename T>
+        requires std::is_floating_point_v<T>
+    void save_matrix(const std::string &path, const miv::matrix<T> &m)
+    {
+        matrix_file_writer<T> out(path, m.rows(), m.cols());
+        out.write(m.data(), m.size());
+        out.close();
+    }
+
+    template <typename T, typename Alloc>
+        requires std::is_floating_point_v<T>
+    void save_array(const std::string &path, const miv::array<T, Alloc> &a)
+    {
+        matrix_file_writer<T> out(path, a.size());
+        out.write(a.data(), a.size());
+        out.close();
+    }
+}
+
+#endif // MIV_IO_MATRIX_FILE_H
@@ -0,0 +1,338 @@
+#ifndef MIV_IO_TRACE_H
+#define MIV_IO_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+#include <condition_variable>
+
+namespace miv::io
+{
+    // ============================================================
+    //                      Формат файла трассы
+    // ============================================================
+    //
+    // [trace_header][trace_record][trace_record]...
+    //
+    // Записи фиксированного размера в порядке байт машины, которая писала файл
+    // (byte_order позволяет читателю это проверить). Файл можно читать, пока
+    // он ещё пишется: неполная последняя запись просто не читается.
+
+    inline constexpr char trace_magic[8] = { 'Q', 'M', 'T', 'R', 'A', 'C', 'E', '\0' };
+    inline constexpr std::uint32_t trace_version = 1;
+    inline constexpr std::uint32_t trace_byte_order = 0x01020304u;
+
+    /**
+     * @brief Заголовок файла трассы (24 байта).
+     */
+    struct trace_header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t record_size;
+        std::uint32_t byte_order;
+        std::uint32_t reserved;
+    };
+
+    /**
+     * @brief Одна итерация метода (48 байт).
+     *
+     * Нормы и λ приводятся к double: для журнала этой точности достаточно.
+     */
+    struct trace_record
+    {
+        std::uint32_t run = 0;          ///< номер solve() в сессии
+        std::uint32_t iteration = 0;    ///< k
+        double fx_norm = 0;             ///< ||F(x_k)||
+        double step_norm = 0;           ///< ||s_k||
+        double lambda = 0;              ///< демпфирование шага
+        std::int64_t iteration_ns = 0;  ///< длительность итерации k
+        std::int64_t elapsed_ns = 0;    ///< от начала solve() до конца итерации k
+    };
+
+    static_assert(sizeof(trace_header) == 24, "trace_header must have no padding");
+    static_assert(sizeof(trace_record) == 48, "trace_record must have no padding");
+    static_assert(std::is_trivially_copyable_v<trace_record>);
+
+    // ============================================================
+    //                         trace_writer
+    // ============================================================
+
+    /**
+     * @brief Асинхронная запись трассы в двоичный файл.
+     *
+     * write() только кладёт запись в буфер под мьютексом (без форматирования и
+     * системных вызовов); фоновый поток забирает накопленные записи обменом
+     * буферов и пишет их одним fwrite. Буферы переиспользуются, поэтому в
+     * установившемся режиме write() не выделяет память.
+     *
+     * @code
+     * miv::io::trace_writer trace("run.qmtrace");
+     * trace.write({ .run = 0, .iteration = k, .fx_norm = fx_norm });
+     * @endcode
+     *
+     * Деструктор дописывает всё накопленное и закрывает файл.
+     */
+    class trace_writer
+    {
+    public:
+        /**
+         * @brief Создать (перезаписать) файл и запустить поток записи.
+         *
+         * @param batch_records сколько записей копить перед пробуждением потока записи
+         *
+         * @throws std::runtime_error если файл не открывается
+         */
+        explicit trace_writer(const std::string &path, std::size_t batch_records = 1024)
+            : m_path(path), m_batch(batch_records > 0 ? batch_records : 1)
+        {
+            m_file = std::fopen(path.c_str(), "wb");
+            if (!m_file)
+            {
+                throw std::runtime_error("trace_writer: cannot open '" + path + "' for writing");
+            }
+
+            trace_header header{};
+            std::memcpy(header.magic, trace_magic, sizeof(trace_magic));
+            header.version = trace_version;
+            header.record_size = sizeof(trace_record);
+            header.byte_order = trace_byte_order;
+
+            if (std::fwrite(&header, sizeof(header), 1, m_file) != 1)
+            {
+                std::fclose(m_file);
+                throw std::runtime_error("trace_writer: cannot write header to '" + path + "'");
+            }
+
+            m_pending.reserve(2 * m_batch);
+            m_writing.reserve(2 * m_batch);
+            m_thread = std::thread([this] { writer_loop(); });
+        }
+
+        trace_writer(const trace_writer &) = delete;
+        trace_writer &operator=(const trace_writer &) = delete;
+
+        ~trace_writer()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_cv.notify_one();
+            m_thread.join();
+            std::fclose(m_file);
+        }
+
+        /**
+         * @brief Добавить запись (не ждёт диска).
+         */
+        void write(const trace_record &record)
+        {
+            bool wake = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_pending.push_back(record);
+                ++m_accepted;
+                wake = m_pending.size() >= m_batch;
+            }
+
+            if (wake)
+            {
+                m_cv.notify_one();
+            }
+        }
+
+        /**
+         * @brief Дождаться, пока все принятые записи окажутся в файле.
+         *
+         * @throws std::runtime_error если запись в файл не удалась
+         */
+        void flush()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            const std::uint64_t target = m_accepted;
+            m_flush_requested = true;
+            m_cv.notify_one();
+            m_synced_cv.wait(lock, [&] { return m_synced >= target || m_failed; });
+
+            if (m_failed)
+            {
+                throw std::runtime_error("trace_writer: write to '" + m_path + "' failed");
+            }
+        }
+
+        /**
+         * @brief Сколько записей принято write().
+         */
+        std::uint64_t records() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_accepted;
+        }
+
+        const std::string &path() const { return m_path; }
+
+    private:
+        void writer_loop()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            while (true)
+            {
+                m_cv.wait(lock, [&]
+                {
+                    return m_stop || m_flush_requested || m_pending.size() >= m_batch;
+                });
+
+                const bool sync = m_flush_requested || m_stop;
+                m_flush_requested = false;
+                m_writing.swap(m_pending);
+                const std::uint64_t batch_end = m_accepted;
+
+                lock.unlock();
+
+                bool ok = true;
+                if (!m_writing.empty())
+                {
+                    ok = std::fwrite(m_writing.data(), sizeof(trace_record), m_writing.size(), m_file) ==
+                         m_writing.size();
+                    m_writing.clear();
+                }
+                if (sync)
+                {
+                    ok = (std::fflush(m_file) == 0) && ok;
+                }
+
+                lock.lock();
+
+                m_failed = m_failed || !ok;
+                if (sync)
+                {
+                    m_synced = batch_end;
+                    m_synced_cv.notify_all();
+                }
+
+                if (m_stop && m_pending.empty())
+                {
+                    return;
+                }
+            }
+        }
+
+        std::string m_path;
+        std::size_t m_batch;
+        std::FILE *m_file = nullptr;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cv;          // будит поток записи
+        std::condition_variable m_synced_cv;   // будит flush()
+
+        std::vector<trace_record> m_pending;   // наполняется write()
+        std::vector<trace_record> m_writing;   // пишется потоком записи
+
+        std::uint64_t m_accepted = 0;
+        std::uint64_t m_synced = 0;
+        bool m_flush_requested = false;
+        bool m_stop = false;
+        bool m_failed = false;
+
+        std::thread m_thread;
+    };
+
+    // ============================================================
+    //                         trace_reader
+    // ============================================================
+
+    /**
+     * @brief Последовательное чтение файла трассы.
+     *
+     * @code
+     * miv::io::trace_reader reader("run.qmtrace");
+     * miv::io::trace_record r;
+     * while (reader.next(r)) { ... }
+     * @endcode
+     */
+    class trace_reader
+    {
+    public:
+        /**
+         * @brief Открыть файл и проверить заголовок.
+         *
+         * @throws std::runtime_error если файл не открывается или это не трасса
+         *         поддерживаемой версии с тем же порядком байт
+         */
+        explicit trace_reader(const std::string &path)
+            : m_path(path)
+        {
+            m_file = std::fopen(path.c_str(), "rb");
+            if (!m_file)
+            {
+                throw std::runtime_error("trace_reader: cannot open '" + path + "'");
+            }
+
+            trace_header header{};
+            const bool ok = std::fread(&header, sizeof(header), 1, m_file) == 1;
+
+            std::string error;
+            if (!ok || std::memcmp(header.magic, trace_magic, sizeof(trace_magic)) != 0)
+            {
+                error = "not a trace file";
+            }
+            else if (header.byte_order != trace_byte_order)
+            {
+                error = "trace was written with a different byte order";
+            }
+            else if (header.version != trace_version)
+            {
+                error = "unsupported trace version " + std::to_string(header.version);
+            }
+            else if (header.record_size != sizeof(trace_record))
+            {
+                error = "unexpected record size " + std::to_string(header.record_size);
+            }
+
+            if (!error.empty())
+            {
+                std::fclose(m_file);
+                throw std::runtime_error("trace_reader: '" + path + "': " + error);
+            }
+
+            m_version = header.version;
+        }
+
+        trace_reader(const trace_reader &) = delete;
+        trace_reader &operator=(const trace_reader &) = delete;
+
+        ~trace_reader()
+        {
+            std::fclose(m_file);
+        }
+
+        /**
+         * @brief Прочитать следующую запись.
+         *
+         * @return false в конце файла (неполная последняя запись игнорируется)
+         */
+        bool next(trace_record &record)
+        {
+            return std::fread(&record, sizeof(record), 1, m_file) == 1;
+        }
+
+        std::uint32_t version() const { return m_version; }
+        const std::string &path() const { return m_path; }
+
+    private:
+        std::string m_path;
+        std::FILE *m_file = nullptr;
+        std::uint32_t m_version = 0;
+    };
+}
+
+#endif // MIV_IO_TRACE_H
@@ -1,18 +1,29 @@
 #include <cctype>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <format>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "containers/array.hpp"
 #include "containers/matrix.hpp"
-#include "math/equation_system.hpp"
-#include "math/linalg.hpp"
-
+#include "containers/profile.hpp"
+#include "math/newton_options.hpp"
+#include "math/newton_solver.hpp"
+#include "math/sparse.hpp"
+#include "io/log_level.hpp"
+#include "io/matrix_file.hpp"
+#include "io/trace.hpp"
+
+#include "batch.hpp"
 #include "functions.hpp"
 
 /**
@@ -22,164 +33,72 @@
  * Реализованы методы:
  *  - Ньютон
  *  - Модифицированный Ньютон (замороженный Якобиан)
+ *  - Бройден («хороший» и «плохой»): поправки ранга 1 вместо нового Якобиана
+ *
+ * По умолчанию Якобиан строится численно. Пользователь может ввести матрицу вручную,
+ * выбрать разреженный численный Якобиан (раскраска столбцов + разреженный LU)
+ * обойтись без Якобиана (Ньютон–Крылов: GMRES по разностным J v) или получить
+ * точный Якобиан автоматическим дифференцированием (функции от дуальных чисел).
+ * Сам метод — miv::math::newton_solver (math/newton_solver.hpp); здесь только
+ * диалог с пользователем, журнал итераций и печать итога.
+ *
+ * Переменные окружения:
+ *  - QM_LOG_LEVEL — подробность журнала итераций: off, norms или full (по умолчанию)
+ *  - QM_TRACE     — файл двоичной трассы итераций (нормы, λ, время);
+ *                   расшифровывается утилитой qm_trace_decode
+ *  - QM_SAVE_X    — файл (.qmm), куда после каждого решения пишется x*
+ *
+ * Вместо ввода x0 или матрицы Якоби с клавиатуры можно указать двоичный файл
+ * (io/matrix_file.hpp; см. qm_matrix): строка вида @путь.
  *
- * По умолчанию Якобиан строится численно. Пользователь может ввести матрицу вручную.
- * Вся логика приложения находится в этом файле.
+ * С аргументами командной строки меню не открывается: параметры берутся из
+ * них и из файла конфигурации, начальные приближения — потоком (batch.hpp).
  */
 
 namespace
 {
-    enum class Method
-    {
-        Newton = 1,
-        ModifiedNewton = 2
-    };
-
-    enum class JacobianMode
-    {
-        Numeric = 1,
-        Manual = 2
-    };
-
-    enum class NumericFormula
-    {
-        TwoPoint = 1,
-        ThreePoint = 2
-    };
+    using miv::math::Method;
+    using miv::math::JacobianMode;
+    using miv::math::NumericFormula;
+    using miv::math::Globalization;
 
     /**
-     * @brief Печать массива в формате [a b c].
+     * @brief Записать n чисел get(0..n-1) в поток в формате [a b c].
      */
-    template <miv::math::FloatNumber T>
-    std::string format_array(const miv::array<T> &x, int precision = 10)
+    template <typename Get>
+    void write_values(std::ostream &out, std::size_t n, Get &&get, int precision = 10)
     {
-        std::ostringstream out;
         out << std::setprecision(precision) << std::fixed;
         out << "[";
-        for (std::size_t i = 0; i < x.size(); ++i)
+        for (std::size_t i = 0; i < n; ++i)
         {
-            out << x[i];
-            if (i + 1 < x.size())
+            out << get(i);
+            if (i + 1 < n)
             {
                 out << " ";
             }
         }
         out << "]";
-        return out.str();
-    }
-
-    /**
-     * @brief Преобразование массива в матрицу-столбец (n x 1).
-     */
-    template <miv::math::FloatNumber T>
-    miv::matrix<T> to_column_matrix(const miv::array<T> &x)
-    {
-        miv::matrix<T> out(x.size(), 1);
-        for (std::size_t i = 0; i < x.size(); ++i)
-        {
-            out(i, 0) = x[i];
-        }
-        return out;
     }
 
     /**
-     * @brief Преобразование матрицы-столбца (n x 1) в массив.
+     * @brief Печать n чисел подряд в формате [a b c].
      */
     template <miv::math::FloatNumber T>
-    miv::array<T> column_matrix_to_array(const miv::matrix<T> &v)
+    std::string format_values(const T *values, std::size_t n, int precision = 10)
     {
-        if (v.cols() != 1)
-        {
-            throw std::invalid_argument("Expected column matrix (n x 1)");
-        }
-
-        miv::array<T> out(v.rows());
-        for (std::size_t i = 0; i < v.rows(); ++i)
-        {
-            out[i] = v(i, 0);
-        }
-        return out;
-    }
-
-    /**
-     * @brief Вычислить вектор F(x) в виде матрицы-столбца (n x 1).
-     */
-    template <miv::math::FloatNumber T>
-    miv::matrix<T> compute_F(miv::array<T> &x, const std::vector<NonlinearFunction<T>> &functions)
-    {
-        const std::size_t n = functions.size();
-        miv::matrix<T> out(n, 1);
-
-        for (std::size_t i = 0; i < n; ++i)
-        {
-            out(i, 0) = functions[i](x);
-        }
-
-        return out;
-    }
-
-    /**
-     * @brief Численное построение Якобиана (двухузловая формула).
-     */
-    template <miv::math::FloatNumber T>
-    miv::matrix<T> build_jacobian_two_point(
-        miv::array<T> &x,
-        const std::vector<NonlinearFunction<T>> &functions)
-    {
-        const std::size_t n = functions.size();
-        miv::matrix<T> J(n, n);
-
-        const auto fx = compute_F(x, functions);
-        const T eps = std::numeric_limits<T>::epsilon();
-
-        for (std::size_t j = 0; j < n; ++j)
-        {
-            const T h = std::sqrt(eps) * (static_cast<T>(1) + std::abs(x[j]));
-
-            miv::array<T> x_plus = x;
-            x_plus[j] += h;
-            const auto f_plus = compute_F(x_plus, functions);
-
-            for (std::size_t i = 0; i < n; ++i)
-            {
-                J(i, j) = (f_plus(i, 0) - fx(i, 0)) / h;
-            }
-        }
-
-        return J;
+        std::ostringstream out;
+        write_values(out, n, [values](std::size_t i) { return values[i]; }, precision);
+        return out.str();
     }
 
     /**
-     * @brief Численное построение Якобиана (трёхузловая формула).
+     * @brief Печать массива в формате [a b c].
      */
-    template <miv::math::FloatNumber T>
-    miv::matrix<T> build_jacobian_three_point(
-        miv::array<T> &x,
-        const std::vector<NonlinearFunction<T>> &functions)
+    template <miv::math::FloatNumber T, typename Alloc>
+    std::string format_array(const miv::array<T, Alloc> &x, int precision = 10)
     {
-        const std::size_t n = functions.size();
-        miv::matrix<T> J(n, n);
-        const T eps = std::numeric_limits<T>::epsilon();
-
-        for (std::size_t j = 0; j < n; ++j)
-        {
-            const T h = std::sqrt(eps) * (static_cast<T>(1) + std::abs(x[j]));
-
-            miv::array<T> x_plus = x;
-            miv::array<T> x_minus = x;
-            x_plus[j] += h;
-            x_minus[j] -= h;
-
-            const auto f_plus = compute_F(x_plus, functions);
-            const auto f_minus = compute_F(x_minus, functions);
-
-            for (std::size_t i = 0; i < n; ++i)
-            {
-                J(i, j) = (f_plus(i, 0) - f_minus(i, 0)) / (static_cast<T>(2) * h);
-            }
-        }
-
-        return J;
+        return format_values(x.data(), x.size(), precision);
     }
 
     /**
@@ -291,7 +210,22 @@ namespace
     }
 
     /**
-     * @brief Считать строку из n чисел (вектор).
+     * @brief Путь из строки вида "@путь" (пустая строка — это не ссылка на файл).
+     */
+    std::string file_reference(const std::string &line)
+    {
+        const auto first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line[first] != '@')
+        {
+            return {};
+        }
+
+        const auto last = line.find_last_not_of(" \t\r");
+        return line.substr(first + 1, last - first);
+    }
+
+    /**
+     * @brief Считать строку из n чисел (вектор) или @файл с вектором длины n.
      */
     template <miv::math::FloatNumber T>
     miv::array<T> read_vector(std::size_t n, const std::string &prompt)
@@ -305,6 +239,24 @@ namespace
                 throw std::runtime_error("Ошибка чтения ввода");
             }
 
+            if (const std::string path = file_reference(line); !path.empty())
+            {
+                try
+                {
+                    auto x = miv::io::load_array<T>(path);
+                    if (x.size() == n)
+                    {
+                        return x;
+                    }
+                    std::cout << "В файле " << x.size() << " чисел, ожидалось " << n << ". Повторите ввод.\n";
+                }
+                catch (const std::exception &ex)
+                {
+                    std::cout << "Не удалось прочитать файл: " << ex.what() << "\n";
+                }
+                continue;
+            }
+
             std::istringstream ss(line);
             miv::array<T> x(n);
             bool ok = true;
@@ -328,7 +280,7 @@ namespace
     }
 
     /**
-     * @brief Считать матрицу n x n построчно.
+     * @brief Считать матрицу n x n построчно (или @файл вместо первой строки).
      */
     template <miv::math::FloatNumber T>
     miv::matrix<T> read_matrix(std::size_t n, const std::string &prompt)
@@ -347,6 +299,25 @@ namespace
                     throw std::runtime_error("Ошибка чтения ввода");
                 }
 
+                if (const std::string path = file_reference(line); r == 0 && !path.empty())
+                {
+                    try
+                    {
+                        auto loaded = miv::io::load_matrix<T>(path);
+                        if (loaded.rows() == n && loaded.cols() == n)
+                        {
+                            return loaded;
+                        }
+                        std::cout << "В файле матрица " << loaded.rows() << " x " << loaded.cols()
+                                  << ", ожидалась " << n << " x " << n << ". Повторите ввод.\n";
+                    }
+                    catch (const std::exception &ex)
+                    {
+                        std::cout << "Не удалось прочитать файл: " << ex.what() << "\n";
+                    }
+                    continue;
+                }
+
                 std::istringstream ss(line);
                 bool ok = true;
                 for (std::size_t c = 0; c < n; ++c)
@@ -394,82 +365,225 @@ namespace
     }
 
     /**
-     * @brief Решить линейную систему J s = -F(x) через LUP.
+     * @brief Журнал итераций: консоль (уровень QM_LOG_LEVEL) и двоичная трасса (QM_TRACE).
+     *
+     * Нормы берутся из newton_iteration, x^{k+1} печатается на лету без
+     * временного вектора, а блок итерации собирается в переиспользуемый поток и
+     * выводится одной записью. При log_level::off без трассы callback решателю
+     * не передаётся вовсе.
      */
     template <miv::math::FloatNumber T>
-    miv::array<T> solve_step(const miv::matrix<T> &J, const miv::matrix<T> &fx)
+    class iteration_logger
     {
-        miv::matrix<T> b(fx.rows(), 1);
-        for (std::size_t i = 0; i < fx.rows(); ++i)
+    public:
+        iteration_logger(miv::io::log_level level, bool damping_enabled, miv::io::trace_writer *trace, std::uint32_t run)
+            : m_level(level), m_damping_enabled(damping_enabled), m_trace(trace), m_run(run)
         {
-            b(i, 0) = -fx(i, 0);
         }
 
-        miv::math::equation_system<T> sys(J, b);
-        const auto s_mat = sys.solve_lup();
-        return column_matrix_to_array(s_mat);
-    }
+        bool enabled() const { return m_level != miv::io::log_level::off || m_trace != nullptr; }
+
+        void operator()(const miv::math::newton_iteration<T> &it)
+        {
+            if (m_trace)
+            {
+                miv::io::trace_record record;
+                record.run = m_run;
+                record.iteration = static_cast<std::uint32_t>(it.k);
+                record.fx_norm = static_cast<double>(it.fx_norm);
+                record.step_norm = static_cast<double>(it.step_norm);
+                record.lambda = static_cast<double>(it.lambda);
+                record.iteration_ns = it.iteration_time.count();
+                record.elapsed_ns = it.elapsed.count();
+                m_trace->write(record);
+            }
+
+            if (m_level == miv::io::log_level::norms)
+            {
+                print_norms(it);
+            }
+            else if (m_level == miv::io::log_level::full)
+            {
+                print_full(it);
+            }
+        }
+
+    private:
+        void print_norms(const miv::math::newton_iteration<T> &it)
+        {
+            std::cout << std::format("k = {:<6}||F|| = {:<26}||s|| = {}", it.k, it.fx_norm, it.step_norm);
+            if (m_damping_enabled)
+            {
+                std::cout << std::format("  λ = {}", it.lambda);
+            }
+            std::cout << "\n";
+        }
+
+        void print_full(const miv::math::newton_iteration<T> &it)
+        {
+            const std::size_t n = it.x.size();
+            const T *x = it.x.data();
+            const T *step = it.step.data();
+            const T lambda = it.lambda;
+
+            m_out.str(std::string());
+            m_out.clear();
+
+            const std::string header = std::format(" Итерация {} ", it.k);
+            m_out << std::format("\n{:-^70}\n", header);
+            m_out << std::format("{:<14}", "x^k:");
+            write_values(m_out, n, [x](std::size_t i) { return x[i]; });
+            m_out << std::format("\n{:<14}", "F(x^k):");
+            write_values(m_out, it.fx.size(), [fx = it.fx.data()](std::size_t i) { return fx[i]; });
+            m_out << std::format("\n{:<14}{}\n", "||F||:", it.fx_norm);
+            m_out << std::format("{:<14}", "s^k:");
+            write_values(m_out, it.step.size(), [step](std::size_t i) { return step[i]; });
+            m_out << std::format("\n{:<14}{}\n", "||s||:", it.step_norm);
+            if (m_damping_enabled)
+            {
+                m_out << std::format("{:<14}{}\n", "λ:", lambda);
+            }
+            m_out << std::format("{:<14}", "x^{k+1}:");
+            write_values(m_out, n, [x, step, lambda](std::size_t i) { return x[i] + lambda * step[i]; });
+            m_out << std::format("\n{:-^70}\n", "");
+
+            std::cout << m_out.view();
+        }
+
+        miv::io::log_level m_level;
+        bool m_damping_enabled;
+        miv::io::trace_writer *m_trace;
+        std::uint32_t m_run;
+        std::ostringstream m_out;
+    };
 
     /**
-     * @brief Вывести лог одной итерации.
+     * @brief Уровень журнала из QM_LOG_LEVEL (off / norms / full), по умолчанию full.
      */
-    template <miv::math::FloatNumber T>
-    void print_iteration_log(
-        std::size_t k,
-        const miv::array<T> &x,
-        const miv::matrix<T> &fx,
-        const miv::array<T> &step,
-        T lambda,
-        bool damping_enabled)
+    miv::io::log_level log_level_from_env()
     {
-        const auto fx_norm = miv::math::norm_l2(fx);
-        const auto step_norm = miv::math::norm_l2(to_column_matrix(step));
-        miv::array<T> x_next = x;
-        for (std::size_t i = 0; i < x_next.size(); ++i)
+        miv::io::log_level level = miv::io::log_level::full;
+
+        if (const char *env = std::getenv("QM_LOG_LEVEL"))
         {
-            x_next[i] += lambda * step[i];
+            if (!miv::io::parse_log_level(env, level))
+            {
+                std::cerr << "QM_LOG_LEVEL: ожидалось off, norms или full; используется full.\n";
+            }
         }
-        const std::string header = std::format(" Итерация {} ", k);
-        std::cout << std::format("\n{:-^70}\n", header);
-        std::cout << std::format("{:<14}{}\n", "x^k:", format_array(x));
-        std::cout << std::format("{:<14}{}\n", "F(x^k):", format_array(column_matrix_to_array(fx)));
-        std::cout << std::format("{:<14}{}\n", "||F||:", fx_norm);
-        std::cout << std::format("{:<14}{}\n", "s^k:", format_array(step));
-        std::cout << std::format("{:<14}{}\n", "||s||:", step_norm);
-        if (damping_enabled)
+
+        return level;
+    }
+
+    /**
+     * @brief Двоичная трасса итераций в файл QM_TRACE (nullptr, если переменная не задана).
+     */
+    std::unique_ptr<miv::io::trace_writer> trace_from_env()
+    {
+        const char *env = std::getenv("QM_TRACE");
+        if (!env || *env == '\0')
         {
-            std::cout << std::format("{:<14}{}\n", "λ:", lambda);
+            return nullptr;
         }
-        std::cout << std::format("{:<14}{}\n", "x^{k+1}:", format_array(x_next));
-        std::cout << std::format("{:-^70}\n", "");
+
+        return std::make_unique<miv::io::trace_writer>(env);
+    }
+
+    /**
+     * @brief Файл для x* из QM_SAVE_X (пусто, если переменная не задана).
+     */
+    std::string save_x_from_env()
+    {
+        const char *env = std::getenv("QM_SAVE_X");
+        return env ? std::string(env) : std::string();
+    }
+
+    /**
+     * @brief Строки профиля для «Итога» (сборка с MIV_PROFILE).
+     *
+     * Разделы пересекаются: вычисления F внутри построения Якобиана входят в оба.
+     */
+    void print_profile(const miv::profile_counters &profile)
+    {
+        auto section = [&](const char *label, miv::profile_section s)
+        {
+            std::cout << std::format(
+                "{:<24}{} за {:.3f} мс\n",
+                label,
+                profile.count(s),
+                std::chrono::duration<double, std::milli>(profile.time(s)).count());
+        };
+
+        section("Вычислений F:", miv::profile_section::evaluate);
+        section("Сборок Якобиана:", miv::profile_section::jacobian);
+        section("LU-разложений:", miv::profile_section::factorize);
+        section("Подстановок:", miv::profile_section::substitute);
+        section("Журнал итераций:", miv::profile_section::callback);
+        std::cout << std::format("{:<24}{} ({} байт)\n", "Выделений памяти:", profile.allocations, profile.allocated_bytes);
+        std::cout << std::format("{:<24}{} байт\n", "Скопировано:", profile.bytes_moved);
     }
 }
 
-int main()
+int main(int argc, char **argv)
 {
+    if (argc > 1)
+    {
+        return run_batch(argc, argv);
+    }
+
     using T = FuncFloat;
 
     try
     {
+        const miv::io::log_level log_level = log_level_from_env();
+        const auto trace = trace_from_env();
+        const std::string save_x = save_x_from_env();
+        std::uint32_t run = 0;
+
+        if (trace)
+        {
+            std::cout << std::format("\nТрасса итераций пишется в {}.\n", trace->path());
+        }
+
         while (true)
         {
             std::cout << std::format("\n{:=^70}\n", " Меню ");
             std::cout << "  1) Метод Ньютона\n";
             std::cout << "  2) Модифицированный метод Ньютона (замороженный Якобиан)\n";
+            std::cout << "  3) Метод Бройдена («хороший»)\n";
+            std::cout << "  4) Метод Бройдена («плохой»)\n";
             std::cout << "  0) Выход\n";
 
-            const auto method_choice = read_number_in_range<int>("Выберите метод: ", 0, 2);
+            const auto method_choice = read_number_in_range<int>("Выберите метод: ", 0, 4);
             if (method_choice == 0)
             {
                 std::cout << std::format("\n{}\n\n", "Выход.");
                 return 0;
             }
 
-            const Method method = (method_choice == 1) ? Method::Newton : Method::ModifiedNewton;
+            const Method method = static_cast<Method>(method_choice);
 
             const bool damping_enabled = read_yes_no("Использовать демпфирование шага? (да/нет): ");
             T lambda = static_cast<T>(1);
+            Globalization globalization = Globalization::None;
             if (damping_enabled)
+            {
+                // Dogleg строит модель по явному Якобиану — Бройдену недоступен
+                const bool dogleg_allowed = !miv::math::is_broyden(method);
+
+                std::cout << std::format("\n{:-^70}\n", " Демпфирование ");
+                std::cout << "  1) Постоянное λ\n";
+                std::cout << "  2) Линейный поиск (Армихо, λ подбирается на каждой итерации)\n";
+                if (dogleg_allowed)
+                {
+                    std::cout << "  3) Доверительная область (dogleg)\n";
+                }
+                const auto globalization_choice =
+                    read_number_in_range<int>("Выберите способ: ", 1, dogleg_allowed ? 3 : 2);
+                globalization = static_cast<Globalization>(globalization_choice);
+            }
+
+            if (globalization == Globalization::None && damping_enabled)
             {
                 std::cout << std::format("\n{}\n", "Подсказка: x_{k+1} = x_k + λ * s_k");
                 while (true)
@@ -501,11 +615,33 @@ int main()
             std::cout << std::format("\n{:-^70}\n", " Источник Якобиана ");
             std::cout << "  1) Численно (приближение)\n";
             std::cout << "  2) Ввести матрицу Якоби вручную\n";
-            const auto jacobian_choice = read_number_in_range<int>("Выберите режим: ", 1, 2);
-            const JacobianMode jacobian_mode = (jacobian_choice == 1) ? JacobianMode::Numeric : JacobianMode::Manual;
+            std::cout << "  3) Численно, разреженный (для больших систем)\n";
+
+            // Бройдену и dogleg нужен явный Якобиан
+            const bool jacobian_free_allowed =
+                !miv::math::is_broyden(method) && globalization != Globalization::Dogleg;
+            if (jacobian_free_allowed)
+            {
+                std::cout << "  4) Без Якобиана (Ньютон–Крылов, GMRES)\n";
+            }
+            std::cout << "  5) Автоматически (точный Якобиан, дуальные числа)\n";
+
+            int jacobian_choice = 0;
+            while (true)
+            {
+                jacobian_choice = read_number_in_range<int>("Выберите режим: ", 1, 5);
+                if (jacobian_choice != 4 || jacobian_free_allowed)
+                {
+                    break;
+                }
+                std::cout << std::format(
+                    "{} нужен Якобиан: выберите 1, 2, 3 или 5.\n",
+                    miv::math::is_broyden(method) ? "Методу Бройдена" : "Доверительной области");
+            }
+            const JacobianMode jacobian_mode = static_cast<JacobianMode>(jacobian_choice);
 
             NumericFormula numeric_formula = NumericFormula::TwoPoint;
-            if (jacobian_mode == JacobianMode::Numeric)
+            if (jacobian_mode == JacobianMode::Numeric || jacobian_mode == JacobianMode::Sparse)
             {
                 std::cout << std::format("\n{:-^70}\n", " Численная формула ");
                 std::cout << "  1) Двухузловая (односторонняя разность)\n";
@@ -528,12 +664,25 @@ int main()
                 return 1;
             }
 
+            // Векторная форма (functions.cpp): F целиком одним встраиваемым вызовом
+            const auto system = miv::math::make_vector_system(n, [](auto xv, auto out)
+            {
+                system_vector(xv, out);
+            });
+
             std::cout << std::format(
                 "\nОбнаружено уравнений: {}.\nТребуется начальное приближение x0 длины {}.\n",
                 n,
                 n);
             auto x = read_vector<T>(n, std::format("Введите x0 ({} чисел через пробел): ", n));
 
+#ifndef NDEBUG
+            if constexpr (HasSystemVector)
+            {
+                check_system_vector(x);
+            }
+#endif
+
             miv::matrix<T> J_manual;
             if (jacobian_mode == JacobianMode::Manual)
             {
@@ -542,104 +691,162 @@ int main()
                 print_matrix(J_manual);
             }
 
-            miv::matrix<T> J_frozen;
-            if (method == Method::ModifiedNewton)
+            miv::math::newton_options<T> options;
+            options.method = method;
+            options.jacobian = jacobian_mode;
+            options.formula = numeric_formula;
+            options.max_iterations = max_iter;
+            options.eps_F = eps_F;
+            options.eps_x = eps_x;
+            options.lambda = lambda;
+            options.globalization = globalization;
+
+            miv::math::newton_solver<T> solver(options);
+            iteration_logger<T> logger(log_level, damping_enabled, trace.get(), run++);
+            if (logger.enabled())
+            {
+                solver.set_iteration_callback([&logger](const miv::math::newton_iteration<T> &it)
+                {
+                    logger(it);
+                });
+            }
+
+            if (jacobian_mode == JacobianMode::Manual)
+            {
+                solver.set_manual_jacobian(std::move(J_manual));
+            }
+
+            if (jacobian_mode == JacobianMode::Automatic)
             {
-                if (jacobian_mode == JacobianMode::Numeric)
+                if constexpr (HasSystemVector)
                 {
-                    J_frozen = (numeric_formula == NumericFormula::TwoPoint)
-                        ? build_jacobian_two_point(x, functions)
-                        : build_jacobian_three_point(x, functions);
+                    solver.set_automatic_jacobian<AutoDiffWidth>(system);
                 }
                 else
                 {
-                    J_frozen = J_manual;
+                    solver.set_automatic_jacobian(get_system_dual_functions());
                 }
             }
 
-            bool converged = false;
-            std::size_t iter_done = 0;
-
-            for (std::size_t k = 0; k < max_iter; ++k)
+            // Разреженный режим: шаблон (из functions.cpp или найденный в x0) и раскраска — один раз
+            if (jacobian_mode == JacobianMode::Sparse)
             {
-                iter_done = k + 1;
-                auto fx = compute_F(x, functions);
-                const auto fx_norm = miv::math::norm_l2(fx);
+                const auto deps = get_system_sparsity();
+                auto pattern = !deps.empty() ? miv::math::sparsity_pattern::from_rows(n, deps)
+                    : HasSystemVector        ? miv::math::detect_sparsity(x, system)
+                                             : miv::math::detect_sparsity(x, functions);
 
-                if (fx_norm < static_cast<miv::math::norm_t>(eps_F))
+                if (pattern.rows != n)
                 {
-                    converged = true;
-                    std::cout << std::format("\n{}\n", "Критерий ||F|| < eps_F выполнен.");
-                    break;
+                    throw std::invalid_argument("get_system_sparsity() must describe every equation");
                 }
 
-                miv::matrix<T> J;
-                if (method == Method::Newton)
+                solver.set_sparsity(std::move(pattern));
+                std::cout << std::format(
+                    "\nШаблон Якобиана: {} ненулевых из {}, цветов (вычислений F на Якобиан): {}.\n",
+                    solver.sparse_builder()->pattern().nnz(),
+                    n * n,
+                    solver.sparse_builder()->colors());
+            }
+
+            const auto result = [&]
+            {
+                if constexpr (HasSystemVector)
                 {
-                    if (jacobian_mode == JacobianMode::Numeric)
-                    {
-                        J = (numeric_formula == NumericFormula::TwoPoint)
-                            ? build_jacobian_two_point(x, functions)
-                            : build_jacobian_three_point(x, functions);
-                    }
-                    else
-                    {
-                        J = J_manual;
-                    }
+                    return solver.solve(system, std::move(x));
                 }
                 else
                 {
-                    J = J_frozen;
+                    return solver.solve(functions, std::move(x));
                 }
+            }();
 
-                miv::array<T> step = solve_step(J, fx);
-                const auto step_norm = miv::math::norm_l2(to_column_matrix(step));
-                const auto x_norm = miv::math::norm_l2(to_column_matrix(x));
-
-                print_iteration_log(k, x, fx, step, lambda, damping_enabled);
-
-                const auto step_threshold =
-                    static_cast<miv::math::norm_t>(eps_x) * (static_cast<miv::math::norm_t>(1) + x_norm);
-                if (step_norm < step_threshold)
-                {
-                    converged = true;
-                    std::cout << std::format("\n{}\n", "Критерий ||s|| < eps_x * (1 + ||x||) выполнен.");
-                    break;
-                }
+            if (trace)
+            {
+                trace->flush();
+            }
 
-                for (std::size_t i = 0; i < n; ++i)
-                {
-                    x[i] += lambda * step[i];
-                }
+            if (!save_x.empty())
+            {
+                miv::io::save_array(save_x, result.x);
             }
 
-            auto fx_final = compute_F(x, functions);
-            const auto fx_final_norm = miv::math::norm_l2(fx_final);
+            if (result.stop == miv::math::newton_stop::residual)
+            {
+                std::cout << std::format("\n{}\n", "Критерий ||F|| < eps_F выполнен.");
+            }
+            else if (result.stop == miv::math::newton_stop::step)
+            {
+                std::cout << std::format("\n{}\n", "Критерий ||s|| < eps_x * (1 + ||x||) выполнен.");
+            }
+            else if (result.stop == miv::math::newton_stop::no_decrease)
+            {
+                std::cout << std::format("\n{}\n", "Ни одна проба шага не уменьшила ||F|| — остановка в x_k.");
+            }
 
             std::cout << std::format("\n{:=^70}\n", " Итог ");
-            std::cout << std::format("{:<24}{}\n", "Статус:", converged ? "сходимость достигнута" : "не сошлось");
-            std::cout << std::format("{:<24}{}\n", "Итоговый x*:", format_array(x));
-            std::cout << std::format("{:<24}{}\n", "||F(x*)||:", fx_final_norm);
-            std::cout << std::format("{:<24}{}\n", "Итераций выполнено:", iter_done);
+            std::cout << std::format("{:<24}{}\n", "Статус:", result.converged ? "сходимость достигнута" : "не сошлось");
+            std::cout << std::format("{:<24}{}\n", "Итоговый x*:", format_array(result.x));
+            std::cout << std::format("{:<24}{}\n", "||F(x*)||:", result.residual_norm);
+            std::cout << std::format("{:<24}{}\n", "Итераций выполнено:", result.iterations);
+            std::cout << std::format(
+                "{:<24}{:.3f} мс\n",
+                "Время решения:",
+                std::chrono::duration<double, std::milli>(result.elapsed).count());
             std::cout << std::format(
                 "{:<24}{}\n",
                 "Метод:",
-                (method == Method::Newton) ? "Ньютон" : "Модифицированный Ньютон");
+                (method == Method::Newton)          ? "Ньютон"
+                : (method == Method::ModifiedNewton) ? "Модифицированный Ньютон"
+                : (method == Method::BroydenGood)    ? "Бройден («хороший»)"
+                                                     : "Бройден («плохой»)");
+            if (miv::math::is_broyden(method))
+            {
+                std::cout << std::format("{:<24}{}\n", "Построений Якобиана:", result.jacobian_builds);
+            }
             std::cout << std::format(
                 "{:<24}{}\n",
                 "Якобиан:",
-                (jacobian_mode == JacobianMode::Numeric) ? "численный" : "ручной");
-            if (jacobian_mode == JacobianMode::Numeric)
+                (jacobian_mode == JacobianMode::Numeric)     ? "численный"
+                : (jacobian_mode == JacobianMode::Sparse)    ? "численный разреженный"
+                : (jacobian_mode == JacobianMode::Manual)    ? "ручной"
+                : (jacobian_mode == JacobianMode::Automatic) ? "автоматический (дуальные числа)"
+                                                             : "без Якобиана (GMRES)");
+            if (jacobian_mode == JacobianMode::JacobianFree)
+            {
+                std::cout << std::format("{:<24}{}\n", "Итераций GMRES:", result.linear_iterations);
+            }
+            if (jacobian_mode == JacobianMode::Numeric || jacobian_mode == JacobianMode::Sparse)
             {
                 std::cout << std::format(
                     "{:<24}{}\n",
                     "Формула:",
                     (numeric_formula == NumericFormula::TwoPoint) ? "двухузловая" : "трёхузловая");
             }
-            if (damping_enabled)
+            if (globalization == Globalization::None && damping_enabled)
             {
                 std::cout << std::format("{:<24}{}\n", "λ:", lambda);
             }
+            else if (globalization != Globalization::None)
+            {
+                std::cout << std::format(
+                    "{:<24}{}\n",
+                    "Демпфирование:",
+                    (globalization == Globalization::LineSearch) ? "линейный поиск (Армихо)" : "доверительная область (dogleg)");
+                std::cout << std::format("{:<24}{}\n", "Отвергнуто проб:", result.rejected_steps);
+            }
+            if (trace)
+            {
+                std::cout << std::format("{:<24}{} (записей: {})\n", "Трасса:", trace->path(), trace->records());
+            }
+            if (!save_x.empty())
+            {
+                std::cout << std::format("{:<24}{}\n", "x* сохранён в:", save_x);
+            }
+            if constexpr (miv::profile_enabled)
+            {
+                print_profile(result.profile);
+            }
             std::cout << std::format("{:=^70}\n\n", "");
         }
     }
@@ -0,0 +1,167 @@
+#ifndef MIV_MATH_AUTODIFF_H
+#define MIV_MATH_AUTODIFF_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "containers/array.hpp"
+#include "containers/matrix.hpp"
+#include "containers/profile.hpp"
+#include "exec/thread_pool.hpp"
+#include "ad/dual.hpp"
+#include "math/helpers.hpp"   // FloatNumber
+#include "math/system.hpp"    // system_size, evaluate_system
+
+namespace miv::math
+{
+    /**
+     * @brief Точный Якобиан прямым автоматическим дифференцированием.
+     *
+     * Функции системы вызываются от x типа miv::ad::dual<T, N>: проход с
+     * единичными направлениями e_c0..e_{c0+N-1} даёт сразу N столбцов Якобиана
+     * (и F(x) как значение). Всего ceil(n / N) проходов по n функций, без шага
+     * дифференцирования и без погрешности разностной формулы.
+     *
+     * Система — вектор функций fi(miv::array<dual<T, N>>&) -> dual<T, N>
+     * (например, NonlinearFunction<dual<T, N>> из functions.hpp) или
+     * vector_system с шаблонным f (см. math/system.hpp). Как и в
+     * jacobian_builder, проходы распределяются по потокам пула miv::exec, у
+     * каждого слота своя копия x; функции должны быть потокобезопасны.
+     */
+    template <FloatNumber T, std::size_t N>
+    class automatic_jacobian_builder
+    {
+    public:
+        using value_t = T;
+        using dual_t = miv::ad::dual<T, N>;
+
+        /**
+         * @brief J = F'(x); если fx не nullptr, туда же пишется F(x) (n значений).
+         *
+         * @throws std::invalid_argument если длина x не равна числу функций
+         */
+        template <typename System>
+        void build(const miv::array<T> &x, const System &functions, miv::matrix<T> &J, T *fx = nullptr)
+        {
+            MIV_PROFILE_SCOPE(jacobian);
+
+            const std::size_t n = system_size(functions);
+
+            if (x.size() != n)
+            {
+                throw std::invalid_argument(
+                    "automatic_jacobian_builder: x must have length n = " + std::to_string(n) +
+                    ", but got " + std::to_string(x.size()));
+            }
+
+            if (J.rows() != n || J.cols() != n)
+            {
+                J = miv::matrix<T>(n, n, miv::uninitialized);
+            }
+
+            if (n == 0)
+            {
+                return;
+            }
+
+            const std::size_t sweeps = (n + N - 1) / N;
+
+            // Одна "единица работы" — вычисление одной компоненты F от dual
+            const std::size_t work = sweeps * n * N;
+            const std::size_t threads = (work < miv::exec::serial_threshold()) ? 1 : miv::exec::thread_count();
+            const std::size_t slots = std::min(sweeps, threads);
+
+            if (m_slots.size() < slots)
+            {
+                m_slots.resize(slots);
+            }
+
+            for (std::size_t s = 0; s < slots; ++s)
+            {
+                auto &buf = m_slots[s];
+                if (buf.x.size() != n)
+                {
+                    buf.x.resize(n);
+                    buf.f.resize(n);
+                }
+
+                for (std::size_t j = 0; j < n; ++j)
+                {
+                    buf.x[j] = dual_t(x[j]);
+                }
+            }
+
+            T *jac = J.data();
+
+            auto run = [&](slot_buffers &buf, std::size_t sweep_lo, std::size_t sweep_hi)
+            {
+                miv::array<dual_t> &xs = buf.x;
+
+                for (std::size_t sweep = sweep_lo; sweep < sweep_hi; ++sweep)
+                {
+                    const std::size_t c0 = sweep * N;
+                    const std::size_t width = std::min(N, n - c0);
+
+                    for (std::size_t k = 0; k < width; ++k)
+                    {
+                        xs[c0 + k].d[k] = static_cast<T>(1);
+                    }
+
+                    evaluate_system(functions, xs, buf.f.data());
+
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        const dual_t &r = buf.f[i];
+
+                        T *row = jac + i * n + c0;
+                        for (std::size_t k = 0; k < width; ++k)
+                        {
+                            row[k] = r.d[k];
+                        }
+
+                        if (fx && sweep == 0)
+                        {
+                            fx[i] = r.v;
+                        }
+                    }
+
+                    for (std::size_t k = 0; k < width; ++k)
+                    {
+                        xs[c0 + k].d[k] = T{};
+                    }
+                }
+            };
+
+            if (slots == 1)
+            {
+                run(m_slots[0], 0, sweeps);
+                return;
+            }
+
+            // Вычисления F в потоках пула — в профиль вызывающего
+            MIV_PROFILE_CAPTURE(profile);
+            miv::exec::default_pool().parallel_for(0, slots, 1, [&](std::size_t lo, std::size_t hi)
+            {
+                MIV_PROFILE_RECORD_INTO(profile);
+                for (std::size_t s = lo; s < hi; ++s)
+                {
+                    run(m_slots[s], (sweeps * s) / slots, (sweeps * (s + 1)) / slots);
+                }
+            });
+        }
+
+    private:
+        struct slot_buffers
+        {
+            miv::array<dual_t> x;   // x от dual
+            miv::array<dual_t> f;   // F(x) от dual
+        };
+
+        std::vector<slot_buffers> m_slots;
+    };
+}
+
+#endif // MIV_MATH_AUTODIFF_H
@@ -0,0 +1,718 @@
+#ifndef MIV_MATH_BATCH_SOLVER_H
+#define MIV_MATH_BATCH_SOLVER_H
+
+#include <cstddef>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "containers/array.hpp"
+#include "containers/matrix.hpp"
+#include "exec/thread_pool.hpp"
+#include "math/helpers.hpp"   // FloatNumber, norm_t
+#include "math/linalg.hpp"    // norm_l2
+#include "math/system.hpp"    // system_size, evaluate_system, parametric_system
+#include "math/jacobian.hpp"
+#include "math/newton_options.hpp"
+
+namespace miv::math
+{
+    /**
+     * @brief Состояние одной дорожки (lane) пакета после solve_batch.
+     */
+    enum class lane_status : unsigned char
+    {
+        running,          ///< ещё итерируется (во время решения)
+        converged,        ///< выполнен критерий по ||F|| или по ||s||
+        max_iterations,   ///< исчерпан лимит итераций
+        singular,         ///< Якобиан вырожден
+        diverged          ///< F или шаг перестали быть конечными
+    };
+
+    constexpr std::string_view to_string(lane_status status)
+    {
+        switch (status)
+        {
+        case lane_status::running:
+            return "running";
+        case lane_status::converged:
+            return "converged";
+        case lane_status::max_iterations:
+            return "max_iterations";
+        case lane_status::singular:
+            return "singular";
+        case lane_status::diverged:
+            return "diverged";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @brief Параметры разбиения пакета.
+     *
+     * block_lanes дорожек решаются вместе: их данные лежат в формате SoA
+     * (элемент i всех дорожек подряд), так что LU-ядра векторизуются по дорожкам.
+     * Блоки независимы и при parallel распределяются по общему пулу miv::exec.
+     */
+    struct batch_options
+    {
+        std::size_t block_lanes = 64;
+        bool parallel = true;
+    };
+
+    /**
+     * @brief Результат solve_batch: по столбцу на дорожку.
+     */
+    template <FloatNumber T>
+    struct batch_result
+    {
+        miv::matrix<T> x;                     ///< n x lanes: столбец l — решение дорожки l
+        miv::array<norm_t> residual_norm;     ///< ||F(x*)|| каждой дорожки
+        miv::array<std::size_t> iterations;   ///< выполненных итераций
+        miv::array<lane_status> status;
+
+        std::size_t n() const { return x.rows(); }
+        std::size_t lanes() const { return x.cols(); }
+
+        /**
+         * @brief Решение дорожки l отдельным вектором.
+         */
+        miv::array<T> lane(std::size_t l) const
+        {
+            miv::array<T> out(x.rows());
+            for (std::size_t i = 0; i < x.rows(); ++i)
+            {
+                out[i] = x(i, l);
+            }
+            return out;
+        }
+
+        /**
+         * @brief Сколько дорожек закончилось с данным статусом.
+         */
+        std::size_t count(lane_status s) const
+        {
+            return static_cast<std::size_t>(std::count(status.begin(), status.end(), s));
+        }
+    };
+
+    // ============================================================
+    //                  SoA LUP kernels (по дорожкам)
+    // ============================================================
+    //
+    // Раскладка блока из L дорожек системы размера n:
+    //   a[(i * n + j) * L + l] — элемент (i, j) матрицы дорожки l
+    //   b[i * L + l], pivots[k * L + l]
+    // Внутренний цикл всегда идёт по дорожкам l, поэтому исключение
+    // (основная работа) векторизуется, хотя у каждой дорожки свой выбор
+    // главного элемента.
+
+    namespace detail
+    {
+        /**
+         * @brief LUP-разложение L матриц n x n на месте.
+         *
+         * Вырожденные дорожки не прерывают разложение: для них singular[l] = 1,
+         * а диагональ заменяется единицей, чтобы остальная арифметика оставалась конечной.
+         *
+         * @param scratch 2 * L элементов
+         */
+        template <FloatNumber T>
+        void soa_lu_decompose(std::size_t n, std::size_t L, T *a, std::size_t *pivots,
+                              unsigned char *singular, T *scratch)
+        {
+            const T eps = static_cast<T>(1e-18);
+            T *max_val = scratch;
+            T *inv = scratch + L;
+
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                std::size_t *piv = pivots + k * L;
+                T *diag = a + (k * n + k) * L;
+
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    max_val[l] = std::abs(diag[l]);
+                    piv[l] = k;
+                }
+
+                for (std::size_t i = k + 1; i < n; ++i)
+                {
+                    const T *col = a + (i * n + k) * L;
+                    for (std::size_t l = 0; l < L; ++l)
+                    {
+                        const T v = std::abs(col[l]);
+                        if (v > max_val[l])
+                        {
+                            max_val[l] = v;
+                            piv[l] = i;
+                        }
+                    }
+                }
+
+                // Обмен строк — у каждой дорожки свой
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    const std::size_t p = piv[l];
+                    if (p != k)
+                    {
+                        for (std::size_t j = 0; j < n; ++j)
+                        {
+                            std::swap(a[(k * n + j) * L + l], a[(p * n + j) * L + l]);
+                        }
+                    }
+                }
+
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    if (max_val[l] <= eps)
+                    {
+                        singular[l] = 1;
+                        diag[l] = static_cast<T>(1);
+                    }
+                    inv[l] = static_cast<T>(1) / diag[l];
+                }
+
+                const T *row_k = a + k * n * L;
+
+                for (std::size_t i = k + 1; i < n; ++i)
+                {
+                    T *row_i = a + i * n * L;
+                    T *m = row_i + k * L;
+
+                    for (std::size_t l = 0; l < L; ++l)
+                    {
+                        m[l] *= inv[l];
+                    }
+
+                    for (std::size_t j = k + 1; j < n; ++j)
+                    {
+                        T *dst = row_i + j * L;
+                        const T *src = row_k + j * L;
+                        for (std::size_t l = 0; l < L; ++l)
+                        {
+                            dst[l] -= m[l] * src[l];
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Решить L систем по результату soa_lu_decompose: b заменяется на x.
+         */
+        template <FloatNumber T>
+        void soa_lu_solve(std::size_t n, std::size_t L, const T *a, const std::size_t *pivots, T *b)
+        {
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                const std::size_t *piv = pivots + k * L;
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    if (piv[l] != k)
+                    {
+                        std::swap(b[k * L + l], b[piv[l] * L + l]);
+                    }
+                }
+            }
+
+            // L y = Pb
+            for (std::size_t i = 1; i < n; ++i)
+            {
+                T *bi = b + i * L;
+                for (std::size_t j = 0; j < i; ++j)
+                {
+                    const T *lij = a + (i * n + j) * L;
+                    const T *bj = b + j * L;
+                    for (std::size_t l = 0; l < L; ++l)
+                    {
+                        bi[l] -= lij[l] * bj[l];
+                    }
+                }
+            }
+
+            // U x = y
+            for (std::size_t i = n; i > 0; --i)
+            {
+                const std::size_t row = i - 1;
+                T *br = b + row * L;
+
+                for (std::size_t j = row + 1; j < n; ++j)
+                {
+                    const T *uij = a + (row * n + j) * L;
+                    const T *bj = b + j * L;
+                    for (std::size_t l = 0; l < L; ++l)
+                    {
+                        br[l] -= uij[l] * bj[l];
+                    }
+                }
+
+                const T *diag = a + (row * n + row) * L;
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    br[l] /= diag[l];
+                }
+            }
+        }
+
+        /**
+         * @brief Рабочие буферы одного блока дорожек (SoA).
+         */
+        template <FloatNumber T>
+        struct batch_block
+        {
+            std::size_t n = 0;
+            std::size_t L = 0;
+
+            miv::array<T> x;           // n * L
+            miv::array<T> f;           // n * L
+            miv::array<T> J;           // n * n * L
+            miv::array<T> s;           // n * L
+            miv::array<T> scratch;     // 2 * L
+            miv::array<std::size_t> pivots;
+            miv::array<unsigned char> active;
+            miv::array<unsigned char> singular;
+            miv::array<norm_t> f_norm;           // ||F|| дорожки после последнего evaluate
+            miv::array<unsigned char> f_current; // f и f_norm соответствуют текущему x дорожки
+
+            // одна дорожка в обычном формате (для вызова функций системы)
+            miv::array<T> x_lane;
+            miv::matrix<T> f_lane;
+            miv::matrix<T> J_lane;
+            jacobian_builder<T> builder;
+
+            batch_block(std::size_t n_, std::size_t L_)
+                : n(n_), L(L_),
+                  x(n_ * L_), f(n_ * L_), J(n_ * n_ * L_), s(n_ * L_), scratch(2 * L_),
+                  pivots(n_ * L_), active(L_), singular(L_), f_norm(L_), f_current(L_),
+                  x_lane(n_), f_lane(n_, 1), J_lane(n_, n_) {}
+
+            void gather(std::size_t l)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    x_lane[i] = x[i * L + l];
+                }
+            }
+
+            template <typename System>
+            norm_t evaluate(const System &functions, std::size_t l)
+            {
+                gather(l);
+                evaluate_system(functions, x_lane, f_lane.data());
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    f[i * L + l] = f_lane.data()[i];
+                }
+                f_norm[l] = norm_l2(f_lane);
+                f_current[l] = 1;
+                return f_norm[l];
+            }
+
+            template <typename System>
+            void jacobian(const System &functions, NumericFormula formula, std::size_t l)
+            {
+                // x_lane и f_lane — уже для дорожки l (после evaluate)
+                if (formula == NumericFormula::TwoPoint)
+                {
+                    builder.build_two_point(x_lane, functions, f_lane, J_lane);
+                }
+                else
+                {
+                    builder.build_three_point(x_lane, functions, J_lane);
+                }
+
+                for (std::size_t e = 0; e < n * n; ++e)
+                {
+                    J[e * L + l] = J_lane.data()[e];
+                }
+            }
+
+            // Неактивные дорожки: J = I, F = 0 — разложение и шаг остаются конечными
+            void neutralize(std::size_t l)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    f[i * L + l] = T{};
+                    for (std::size_t j = 0; j < n; ++j)
+                    {
+                        J[(i * n + j) * L + l] = (i == j) ? static_cast<T>(1) : T{};
+                    }
+                }
+            }
+
+            void decompose()
+            {
+                std::fill(singular.begin(), singular.end(), static_cast<unsigned char>(0));
+                soa_lu_decompose(n, L, J.data(), pivots.data(), singular.data(), scratch.data());
+            }
+        };
+
+        /**
+         * @brief Итерации Ньютона для дорожек [l0, l0 + L) пакета.
+         *
+         * lane_system(l) — система дорожки l пакета (одна и та же или со своими параметрами).
+         */
+        template <FloatNumber T, typename LaneSystem>
+        void solve_batch_block(
+            const LaneSystem &lane_system,
+            std::size_t n,
+            const newton_options<T> &options,
+            std::size_t l0,
+            std::size_t L,
+            batch_result<T> &result)
+        {
+            batch_block<T> blk(n, L);
+
+            auto finish = [&](std::size_t l, lane_status st)
+            {
+                result.status[l0 + l] = st;
+                blk.active[l] = 0;
+            };
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    blk.x[i * L + l] = result.x(i, l0 + l);
+                }
+            }
+            std::fill(blk.active.begin(), blk.active.end(), static_cast<unsigned char>(1));
+
+            // Замороженный Якобиан: раскладывается один раз в x0
+            if (options.method == Method::ModifiedNewton)
+            {
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    const auto &functions = lane_system(l0 + l);
+                    blk.evaluate(functions, l);
+                    blk.jacobian(functions, options.formula, l);
+                }
+
+                blk.decompose();
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    if (blk.singular[l])
+                    {
+                        finish(l, lane_status::singular);
+                    }
+                }
+            }
+
+            for (std::size_t k = 0; k < options.max_iterations; ++k)
+            {
+                bool any_active = false;
+
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    if (!blk.active[l])
+                    {
+                        if (options.method == Method::Newton)
+                        {
+                            blk.neutralize(l);
+                        }
+                        else
+                        {
+                            for (std::size_t i = 0; i < n; ++i)
+                            {
+                                blk.f[i * L + l] = T{};
+                            }
+                        }
+                        continue;
+                    }
+
+                    result.iterations[l0 + l] = k + 1;
+
+                    // F(x0) модифицированного метода уже вычислена перед разложением
+                    const auto &functions = lane_system(l0 + l);
+                    const norm_t fx_norm = blk.f_current[l] ? blk.f_norm[l] : blk.evaluate(functions, l);
+                    if (fx_norm < static_cast<norm_t>(options.eps_F))
+                    {
+                        finish(l, lane_status::converged);
+                        blk.neutralize(l);
+                        continue;
+                    }
+
+                    if (!std::isfinite(fx_norm))
+                    {
+                        finish(l, lane_status::diverged);
+                        blk.neutralize(l);
+                        continue;
+                    }
+
+                    if (options.method == Method::Newton)
+                    {
+                        blk.jacobian(functions, options.formula, l);
+                    }
+
+                    any_active = true;
+                }
+
+                if (!any_active)
+                {
+                    break;
+                }
+
+                if (options.method == Method::Newton)
+                {
+                    blk.decompose();
+                    for (std::size_t l = 0; l < L; ++l)
+                    {
+                        if (blk.active[l] && blk.singular[l])
+                        {
+                            finish(l, lane_status::singular);
+                        }
+                    }
+                }
+
+                // J s = -F для всех дорожек блока сразу
+                for (std::size_t e = 0; e < n * L; ++e)
+                {
+                    blk.s[e] = -blk.f[e];
+                }
+                soa_lu_solve(n, L, blk.J.data(), blk.pivots.data(), blk.s.data());
+
+                for (std::size_t l = 0; l < L; ++l)
+                {
+                    if (!blk.active[l])
+                    {
+                        continue;
+                    }
+
+                    norm_t step_sq = 0;
+                    norm_t x_sq = 0;
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        const norm_t si = static_cast<norm_t>(blk.s[i * L + l]);
+                        const norm_t xi = static_cast<norm_t>(blk.x[i * L + l]);
+                        step_sq += si * si;
+                        x_sq += xi * xi;
+                    }
+
+                    const norm_t step_norm = std::sqrt(step_sq);
+                    if (!std::isfinite(step_norm))
+                    {
+                        finish(l, lane_status::diverged);
+                        continue;
+                    }
+
+                    const norm_t threshold =
+                        static_cast<norm_t>(options.eps_x) * (static_cast<norm_t>(1) + std::sqrt(x_sq));
+                    if (step_norm < threshold)
+                    {
+                        finish(l, lane_status::converged);
+                        continue;
+                    }
+
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        blk.x[i * L + l] += options.lambda * blk.s[i * L + l];
+                    }
+                    blk.f_current[l] = 0;
+                }
+            }
+
+            for (std::size_t l = 0; l < L; ++l)
+            {
+                if (blk.active[l])
+                {
+                    result.status[l0 + l] = lane_status::max_iterations;
+                }
+
+                // F пересчитывается только там, где x сдвинулся после последнего вычисления
+                result.residual_norm[l0 + l] = blk.f_current[l] ? blk.f_norm[l] : blk.evaluate(lane_system(l0 + l), l);
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    result.x(i, l0 + l) = blk.x[i * L + l];
+                }
+            }
+        }
+    }
+
+    namespace detail
+    {
+        /**
+         * @brief Общая часть solve_batch: проверки, разбиение на блоки, пул.
+         */
+        template <FloatNumber T, typename LaneSystem>
+        batch_result<T> run_batch(
+            const LaneSystem &lane_system,
+            std::size_t n,
+            const miv::matrix<T> &starts,
+            const newton_options<T> &options,
+            const batch_options &batch)
+        {
+            if (n == 0)
+            {
+                throw std::invalid_argument("solve_batch(): the system has no functions");
+            }
+
+            if (starts.rows() != n)
+            {
+                throw std::invalid_argument(
+                    "solve_batch(): starts must have n = " + std::to_string(n) +
+                    " rows (one column per lane), but got " + std::to_string(starts.rows()));
+            }
+
+            if (options.jacobian != JacobianMode::Numeric)
+            {
+                throw std::invalid_argument("solve_batch(): only the numeric Jacobian is supported");
+            }
+
+            if (is_broyden(options.method))
+            {
+                throw std::invalid_argument("solve_batch(): only Newton and ModifiedNewton are supported");
+            }
+
+            if (options.globalization != Globalization::None)
+            {
+                throw std::invalid_argument("solve_batch(): only globalization = none is supported");
+            }
+
+            const std::size_t lanes = starts.cols();
+
+            batch_result<T> result;
+            result.x = starts;
+            result.residual_norm = miv::array<norm_t>(lanes);
+            result.iterations = miv::array<std::size_t>(lanes);
+            result.status = miv::array<lane_status>(lanes);
+
+            if (lanes == 0)
+            {
+                return result;
+            }
+
+            const std::size_t block = std::max<std::size_t>(batch.block_lanes, 1);
+            const std::size_t blocks = (lanes + block - 1) / block;
+
+            auto run = [&](std::size_t lo, std::size_t hi)
+            {
+                for (std::size_t b = lo; b < hi; ++b)
+                {
+                    const std::size_t l0 = b * block;
+                    solve_batch_block(lane_system, n, options, l0, std::min(block, lanes - l0), result);
+                }
+            };
+
+            if (batch.parallel && blocks > 1)
+            {
+                miv::exec::default_pool().parallel_for(0, blocks, 1, run);
+            }
+            else
+            {
+                run(0, blocks);
+            }
+
+            return result;
+        }
+    }
+
+    // ============================================================
+    //                         solve_batch
+    // ============================================================
+
+    /**
+     * @brief Решить одну систему F(x) = 0 из многих начальных точек сразу.
+     *
+     * Каждая дорожка (столбец starts) проходит те же итерации, что и одиночный
+     * метод Ньютона в main.cpp (те же критерии остановки и счёт итераций), но:
+     *  - дорожки хранятся блоками в формате SoA, разложение Якобианов и решение
+     *    J s = -F выполняются векторизованными по дорожкам ядрами;
+     *  - у каждой дорожки своя маска активности: сошедшиеся, вырожденные
+     *    и разошедшиеся дорожки перестают вычислять F и Якобиан;
+     *  - блоки независимы и выполняются параллельно на общем пуле miv::exec.
+     *
+     * Система (вектор fi(miv::array<T>&) -> T или vector_system) вызывается по одной дорожке
+     * и должна быть потокобезопасной. Поддерживаются только численный Якобиан
+     * и globalization = none (шаг lambda * s).
+     *
+     * @param starts n x lanes: столбец l — начальное приближение дорожки l
+     *
+     * @throws std::invalid_argument при пустой системе, несовпадении размеров,
+     *         нечисленном режиме Якобиана, методе Бройдена или глобализации шага
+     */
+    template <FloatNumber T, typename System>
+    batch_result<T> solve_batch(
+        const System &functions,
+        const miv::matrix<T> &starts,
+        const newton_options<T> &options = {},
+        const batch_options &batch = {})
+    {
+        auto lane_system = [&](std::size_t) -> const System & { return functions; };
+        return detail::run_batch(lane_system, system_size(functions), starts, options, batch);
+    }
+
+    /**
+     * @brief Решить семейство систем F(x; p_l) = 0: у каждой дорожки свой вектор параметров.
+     *
+     * То же, что solve_batch для одной системы, но дорожка l решает
+     * F(x; params[l]) = 0 — f(x, p, out) получает строку l матрицы params.
+     * Так решаются десятки тысяч задач с одинаковыми уравнениями и разными
+     * коэффициентами; старт можно дать общий (одинаковые столбцы starts).
+     *
+     * @param starts n x lanes: столбец l — начальное приближение дорожки l
+     * @param params lanes x system.parameters(): строка l — параметры дорожки l
+     *
+     * @throws std::invalid_argument как solve_batch, а также при несовпадении размеров params
+     */
+    template <FloatNumber T, typename F>
+    batch_result<T> solve_batch(
+        const parametric_system<F> &system,
+        const miv::matrix<T> &starts,
+        const miv::matrix<T> &params,
+        const newton_options<T> &options = {},
+        const batch_options &batch = {})
+    {
+        if (params.rows() != starts.cols() || params.cols() != system.parameters())
+        {
+            throw std::invalid_argument(
+                "solve_batch(): params must be " + std::to_string(starts.cols()) + " x " +
+                std::to_string(system.parameters()) + " (one row per lane), but got " +
+                std::to_string(params.rows()) + " x " + std::to_string(params.cols()));
+        }
+
+        auto lane_system = [&](std::size_t l)
+        {
+            return bind_parameters(system, miv::array_view<const T>(params.row_ptr(l), params.cols()));
+        };
+        return detail::run_batch(lane_system, system.size(), starts, options, batch);
+    }
+
+    /**
+     * @brief solve_batch для списка начальных точек (по вектору на дорожку).
+     */
+    template <FloatNumber T, typename System>
+    batch_result<T> solve_batch(
+        const System &functions,
+        const std::vector<miv::array<T>> &starts,
+        const newton_options<T> &options = {},
+        const batch_options &batch = {})
+    {
+        const std::size_t n = system_size(functions);
+        miv::matrix<T> soa(n, starts.size(), miv::uninitialized);
+
+        for (std::size_t l = 0; l < starts.size(); ++l)
+        {
+            if (starts[l].size() != n)
+            {
+                throw std::invalid_argument(
+                    "solve_batch(): start " + std::to_string(l) + " must have length n = " + std::to_string(n) +
+                    ", but got " + std::to_string(starts[l].size()));
+            }
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                soa(i, l) = starts[l][i];
+            }
+        }
+
+        return solve_batch(functions, soa, options, batch);
+    }
+}
+
+#endif // MIV_MATH_BATCH_SOLVER_H
@@ -0,0 +1,177 @@
+#ifndef MIV_MATH_BROYDEN_H
+#define MIV_MATH_BROYDEN_H
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+
+#include "containers/matrix.hpp"
+#include "math/helpers.hpp"   // FloatNumber
+
+namespace miv::math
+{
+    /**
+     * @brief Вариант квазиньютоновского обновления Бройдена.
+     *
+     * Для шага dx = x_{k+1} - x_k и y = F(x_{k+1}) - F(x_k):
+     *  - good: J_{k+1} = J_k + (y - J_k dx) dx^T / (dx^T dx)
+     *          H_{k+1} = H_k + (dx - H_k y) dx^T H_k / (dx^T H_k y)
+     *  - bad:  H_{k+1} = H_k + (dx - H_k y) y^T / (y^T y)
+     *
+     * где H = J^{-1}.
+     */
+    enum class broyden_kind
+    {
+        good,
+        bad
+    };
+
+    /**
+     * @brief Обратный Якобиан H_k = J_k^{-1} как H_0 плюс m поправок ранга 1.
+     *
+     * H_0 — имеющееся разложение J(x_0) (плотное или разреженное LU); сами
+     * факторы не меняются. Поправки хранятся парами векторов (u_i, v_i):
+     *
+     *  - good: H_{i+1} = (I + u_i v_i^T) H_i,  v_i = dx_i
+     *  - bad:  H_{i+1} = H_i + u_i v_i^T,      v_i = y_i / (y_i^T y_i)
+     *
+     * Применение H_m b — решение с H_0 и O(n m) на поправки, то есть O(n^2) на
+     * итерацию против O(n^3) на новое разложение и n+1 (2n) вычислений F на
+     * численный Якобиан. Число поправок ограничено capacity(); когда место
+     * кончается, вызывающий строит Якобиан заново и вызывает clear().
+     *
+     * Векторы хранятся строками матриц capacity x n: память выделяется в
+     * reset(), а не на итерациях.
+     */
+    template <FloatNumber T>
+    class broyden_updates
+    {
+    public:
+        using value_t = T;
+
+        /**
+         * @brief Подготовить хранилище для системы размерности n (без выделений, если размеры те же).
+         */
+        void reset(broyden_kind kind, std::size_t n, std::size_t capacity)
+        {
+            m_kind = kind;
+            m_count = 0;
+
+            if (m_u.rows() != capacity || m_u.cols() != n)
+            {
+                m_u = miv::matrix<T>(capacity, n, miv::uninitialized);
+                m_v = miv::matrix<T>(capacity, n, miv::uninitialized);
+            }
+        }
+
+        /**
+         * @brief Забыть все поправки (H_k = H_0).
+         */
+        void clear() { m_count = 0; }
+
+        broyden_kind kind() const { return m_kind; }
+
+        std::size_t size() const { return m_count; }
+        std::size_t capacity() const { return m_u.rows(); }
+        bool full() const { return m_count >= capacity(); }
+
+        /**
+         * @brief c := H_m b, где на входе c = H_0 b.
+         *
+         * b нужен только варианту bad (поправки применяются к b, а не к H_i b).
+         */
+        void apply(T *c, const T *b) const
+        {
+            const std::size_t n = m_u.cols();
+
+            for (std::size_t i = 0; i < m_count; ++i)
+            {
+                const T *u = m_u.data() + i * n;
+                const T *v = m_v.data() + i * n;
+                const T *src = (m_kind == broyden_kind::good) ? c : b;
+
+                T dot{};
+                for (std::size_t j = 0; j < n; ++j)
+                {
+                    dot += v[j] * src[j];
+                }
+
+                for (std::size_t j = 0; j < n; ++j)
+                {
+                    c[j] += u[j] * dot;
+                }
+            }
+        }
+
+        /**
+         * @brief Добавить поправку по шагу dx, разности y и z = H_k y.
+         *
+         * @return false, если места нет или знаменатель обновления вырожден
+         *         (поправка не добавляется — пора строить Якобиан заново)
+         */
+        bool push(const T *dx, const T *y, const T *z)
+        {
+            if (full())
+            {
+                return false;
+            }
+
+            const std::size_t n = m_u.cols();
+            T *u = m_u.data() + m_count * n;
+            T *v = m_v.data() + m_count * n;
+
+            // Знаменатель p^T q: good — dx^T (H y), bad — y^T y
+            const T *p = (m_kind == broyden_kind::good) ? dx : y;
+            const T *q = (m_kind == broyden_kind::good) ? z : y;
+
+            T denom{};
+            T pp{};
+            T qq{};
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                denom += p[j] * q[j];
+                pp += p[j] * p[j];
+                qq += q[j] * q[j];
+            }
+
+            const T tiny = std::numeric_limits<T>::epsilon() * std::sqrt(pp * qq);
+            if (!std::isfinite(denom) || std::abs(denom) <= tiny)
+            {
+                return false;
+            }
+
+            const T inv = static_cast<T>(1) / denom;
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                u[j] = dx[j] - z[j];
+            }
+
+            if (m_kind == broyden_kind::good)
+            {
+                for (std::size_t j = 0; j < n; ++j)
+                {
+                    u[j] *= inv;
+                    v[j] = dx[j];
+                }
+            }
+            else
+            {
+                for (std::size_t j = 0; j < n; ++j)
+                {
+                    v[j] = y[j] * inv;
+                }
+            }
+
+            ++m_count;
+            return true;
+        }
+
+    private:
+        broyden_kind m_kind = broyden_kind::good;
+        std::size_t m_count = 0;
+        miv::matrix<T> m_u;   // строки — u_i
+        miv::matrix<T> m_v;   // строки — v_i
+    };
+}
+
+#endif // MIV_MATH_BROYDEN_H
@@ -9,15 +9,37 @@
 #include <numeric>
 
 #include "containers/matrix.hpp"
+#include "containers/matrix_view.hpp"
+#include "containers/workspace.hpp"
 #include "math/helpers.hpp"   // Number, require_same_shape, etc.
 #include "math/linalg.hpp"    // identity
+#include "math/lu_factorization.hpp"
+#include "math/refinement.hpp"
 
 namespace miv::math
 {
     /**
-     * @brief Система линейных уравнений Ax = b.
+     * @brief Вариант LUP-разложения, которым решается система.
      *
-     * Работает только с квадратными матрицами A (n x n) и вектором b длины n.
+     * - separate: отдельные матрицы L и U; строки U меняются на месте (std::swap_ranges),
+     *             b — перестановкой обмена (permute_vector), в L — уже найденные столбцы
+     * - packed:   L и U в одном буфере, обмены строк хранятся в массиве pivots
+     * - blocked:  упакованный формат, блочное right-looking разложение
+     *             (панель + TRSM + GEMM), для больших n
+     */
+    enum class lup_mode
+    {
+        separate,
+        packed,
+        blocked
+    };
+
+    /**
+     * @brief Система линейных уравнений Ax = b (или AX = B для нескольких правых частей).
+     *
+     * Работает только с квадратными матрицами A (n x n); b — вектор длины n
+     * или матрица n x k, столбцы которой — k правых частей (все решаются по
+     * одному разложению A).
      * Внутренний тип системы — только FloatNumber (float/double/long double).
      * Позволяет выполнять решение методами разложения (например, LUP).
      */
@@ -35,22 +57,13 @@ namespace miv::math
          *
          * Требования:
          *  - A квадратная (n x n)
-         *  - b размерности (n x 1) или (1 x n) если ты хочешь разрешить строку-вектор
+         *  - b размерности (n x 1) или (1 x n) если ты хочешь разрешить строку-вектор,
+         *    либо (n x k) — k правых частей
          */
         equation_system(miv::matrix<T> A_, miv::matrix<T> b_)
             : A(std::move(A_)), b(std::move(b_))
         {
-            require_squareness(A);
-
-            const std::size_t n = A.rows();
-
-            // b должен быть вектором длины n
-            if (!is_vector(b) || vector_length(b) != n)
-            {
-                throw std::invalid_argument(
-                    "equation_system: b must be a vector of length n = " + std::to_string(n) +
-                    ", but got shape " + std::to_string(b.rows()) + "x" + std::to_string(b.cols()));
-            }
+            require_rhs_shape(A, b);
         }
 
         /**
@@ -62,16 +75,7 @@ namespace miv::math
         equation_system(const miv::matrix<U> &A_, const miv::matrix<U> &b_)
             : A(cast_matrix(A_)), b(cast_matrix(b_))
         {
-            require_squareness(A);
-
-            const std::size_t n = A.rows();
-
-            if (!is_vector(b) || vector_length(b) != n)
-            {
-                throw std::invalid_argument(
-                    "equation_system: b must be a vector of length n = " + std::to_string(n) +
-                    ", but got shape " + std::to_string(b.rows()) + "x" + std::to_string(b.cols()));
-            }
+            require_rhs_shape(A, b);
         }
 
         /**
@@ -79,13 +83,63 @@ namespace miv::math
          */
         std::size_t n() const { return A.rows(); }
 
+        /**
+         * @brief Число правых частей k (1, если b — вектор).
+         */
+        std::size_t rhs_count() const { return is_rhs_block() ? b.cols() : 1; }
+
         /**
          * @brief Решить систему методом LUP-разложения.
          *
          * Работает только с типами float/double/long double.
+         * По умолчанию используется упакованное разложение на месте (lup_mode::packed).
+         * Для b из n x k правых частей результат — X (n x k), разложение одно на все
+         * столбцы, подстановки блочные (lup_mode::separate здесь не поддерживается).
+         *
+         * @throws std::invalid_argument если A вырождена или k > 1 при lup_mode::separate
          */
-        miv::matrix<T> solve_lup() const
+        miv::matrix<T> solve_lup(lup_mode mode = lup_mode::packed) const
         {
+            if (is_rhs_block())
+            {
+                require_single_rhs_mode(mode);
+
+                auto LU = A;
+                miv::array<std::size_t> pivots(n());
+                factorize_packed(miv::matrix_view<T>(LU), pivots.data(), mode);
+
+                miv::matrix<T> x = b;
+                const miv::matrix_view<T> xv(x);
+                apply_row_swaps(pivots.data(), n(), xv);
+                forward_substitution_packed(miv::matrix_view<const T>(LU), xv);
+                backward_substitution_packed(miv::matrix_view<const T>(LU), xv);
+                return x;
+            }
+
+            if (mode == lup_mode::packed || mode == lup_mode::blocked)
+            {
+                auto LU = A;
+                miv::array<std::size_t> pivots(n());
+
+                if (mode == lup_mode::blocked)
+                {
+                    lu_decompose_lup_blocked(LU, pivots);
+                }
+                else
+                {
+                    lu_decompose_lup_packed(LU, pivots);
+                }
+
+                // Результат в форме столбца, как и у раздельного варианта
+                miv::matrix<T> x(n(), 1);
+                std::copy(b.data(), b.data() + n(), x.data());
+
+                apply_row_swaps(pivots, x.data());
+                forward_substitution_packed(LU, x.data());
+                backward_substitution_packed(LU, x.data());
+                return x;
+            }
+
             auto A_work = A;
             auto b_work = b;
 
@@ -95,7 +149,179 @@ namespace miv::math
             return backward_substitution(U, y);
         }
 
+        /**
+         * @brief Решить систему в готовую матрицу x (n x 1, или n x k) без выделений кучи.
+         *
+         * Копия A под разложение и массив обменов строк берутся из workspace
+         * (вызывающий делает ws.reset(), когда они больше не нужны); x того же
+         * размера переиспользуется. Для lup_mode::separate рабочие матрицы
+         * по-прежнему выделяются (см. solve_lup).
+         */
+        void solve_lup_into(miv::matrix<T> &x, miv::workspace &ws, lup_mode mode = lup_mode::packed) const
+        {
+            if (mode == lup_mode::separate)
+            {
+                require_single_rhs_mode(mode);
+                x = solve_lup(mode);
+                return;
+            }
+
+            const std::size_t size = n();
+
+            T *lu_buffer = ws.allocate<T>(size * size);
+            std::size_t *pivots = ws.allocate<std::size_t>(size);
+            std::copy(A.data(), A.data() + size * size, lu_buffer);
+
+            const miv::matrix_view<T> LU(lu_buffer, size, size);
+
+            factorize_packed(LU, pivots, mode);
+
+            const std::size_t k = rhs_count();
+            if (x.rows() != size || x.cols() != k)
+            {
+                x = miv::matrix<T>(size, k, miv::uninitialized);
+            }
+            std::copy(b.data(), b.data() + size * k, x.data());
+
+            if (is_rhs_block())
+            {
+                const miv::matrix_view<T> xv(x);
+                apply_row_swaps(pivots, size, xv);
+                forward_substitution_packed(miv::matrix_view<const T>(LU), xv);
+                backward_substitution_packed(miv::matrix_view<const T>(LU), xv);
+                return;
+            }
+
+            apply_row_swaps(pivots, size, x.data());
+            forward_substitution_packed(miv::matrix_view<const T>(LU), x.data());
+            backward_substitution_packed(miv::matrix_view<const T>(LU), x.data());
+        }
+
+        /**
+         * @brief Решить транспонированную систему A^T x = b (или A^T X = B).
+         *
+         * Разложение то же, что у solve_lup (PA = LU, см. lu_factorization::solve_transposed):
+         * A^T не строится.
+         *
+         * @return x в форме столбца (n x 1) или X (n x k)
+         * @throws std::invalid_argument если матрица вырожденная
+         */
+        miv::matrix<T> solve_transposed() const
+        {
+            const lu_factorization<T> lu(A);
+
+            miv::matrix<T> x(n(), rhs_count(), miv::uninitialized);
+            std::copy(b.data(), b.data() + b.size(), x.data());
+
+            lu.solve_transposed_inplace(x);
+            return x;
+        }
+
+        /**
+         * @brief Решить систему в смешанной точности: разложение в Low, невязки в T.
+         *
+         * Для T = Float128 (программная эмуляция) разложение O(n^3) выполняется
+         * аппаратным double, а точность T восстанавливается итерационным
+         * уточнением за O(n^2) на шаг (см. mixed_lu_factorization). Если A
+         * слишком плохо обусловлена для Low, по умолчанию система решается
+         * обычным LUP в точности T.
+         *
+         * @param report если не nullptr — сюда пишется, как прошло уточнение
+         * @return x в форме столбца (n x 1)
+         *
+         * @throws std::invalid_argument если матрица вырожденная
+         */
+        template <FloatNumber Low = double>
+        miv::matrix<T> solve_refined(refinement_options options = {}, refinement_report *report = nullptr) const
+        {
+            if (is_rhs_block())
+            {
+                throw std::invalid_argument("equation_system::solve_refined(): b must be a single right-hand side");
+            }
+
+            mixed_lu_factorization<T, Low> lu(A, options);
+
+            miv::matrix<T> x(n(), 1, miv::uninitialized);
+            std::copy(b.data(), b.data() + n(), x.data());
+
+            const refinement_report r = lu.solve_inplace(x);
+            if (report)
+            {
+                *report = r;
+            }
+
+            return x;
+        }
+
+        /**
+         * @brief Разложить A в точности Low для многих правых частей с уточнением.
+         */
+        template <FloatNumber Low = double>
+        mixed_lu_factorization<T, Low> factorize_mixed(refinement_options options = {}) const
+        {
+            return mixed_lu_factorization<T, Low>(A, options);
+        }
+
+        /**
+         * @brief Разложить A и вернуть переиспользуемое разложение.
+         *
+         * Удобно, когда с той же матрицей A нужно решить ещё несколько систем.
+         */
+        lu_factorization<T> factorize() const
+        {
+            return lu_factorization<T>(A);
+        }
+
     private:
+        /**
+         * @brief A квадратная, b — вектор длины n или n x k.
+         */
+        static void require_rhs_shape(const miv::matrix<T> &A, const miv::matrix<T> &b)
+        {
+            require_squareness(A);
+
+            const std::size_t n = A.rows();
+
+            // b должен быть вектором длины n или n x k
+            if (b.rows() == n && b.cols() > 0)
+            {
+                return;
+            }
+
+            if (!is_vector(b) || vector_length(b) != n)
+            {
+                throw std::invalid_argument(
+                    "equation_system: b must be a vector of length n = " + std::to_string(n) +
+                    " or an n x k matrix, but got shape " + std::to_string(b.rows()) + "x" + std::to_string(b.cols()));
+            }
+        }
+
+        /**
+         * @brief b — несколько правых частей (n x k, k > 1), а не вектор.
+         */
+        bool is_rhs_block() const { return b.rows() == n() && b.cols() > 1; }
+
+        void require_single_rhs_mode(lup_mode mode) const
+        {
+            if (mode == lup_mode::separate && is_rhs_block())
+            {
+                throw std::invalid_argument(
+                    "equation_system::solve_lup(): lup_mode::separate supports a single right-hand side");
+            }
+        }
+
+        static void factorize_packed(const miv::matrix_view<T> &LU, std::size_t *pivots, lup_mode mode)
+        {
+            if (mode == lup_mode::blocked)
+            {
+                lu_decompose_lup_blocked(LU, pivots);
+            }
+            else
+            {
+                lu_decompose_lup_packed(LU, pivots);
+            }
+        }
+
         /**
          * @brief LUP-разложение с частичным выбором главного элемента.
          *
@@ -113,15 +339,18 @@ namespace miv::math
             miv::matrix<T> L = identity<T>(n);
             miv::matrix<T> U = A_work;
 
+            const miv::matrix_view<T> l(L);
+            const miv::matrix_view<T> u(U);
+
             for (std::size_t k = 0; k < n; ++k)
             {
                 // Найдём опорный элемент в столбце k
                 std::size_t pivot = k;
-                T max_val = std::abs(U(k, k));
+                T max_val = std::abs(u(k, k));
 
                 for (std::size_t i = k + 1; i < n; ++i)
                 {
-                    const T val = std::abs(U(i, k));
+                    const T val = std::abs(u(i, k));
                     if (val > max_val)
                     {
                         max_val = val;
@@ -137,26 +366,26 @@ namespace miv::math
                 if (pivot != k)
                 {
                     // Переставляем строки в U и b
-                    const auto perm = build_swap_perm(n, k, pivot);
-                    U.row_permute(perm);
-                    permute_vector(b_work, perm);
+                    // Строки U меняются на месте: буфер (и view на него) остаётся прежним
+                    std::swap_ranges(u.row_ptr(k), u.row_ptr(k) + n, u.row_ptr(pivot));
+                    permute_vector(b_work, build_swap_perm(n, k, pivot));
 
                     // В L переставляем только уже вычисленные столбцы (0..k-1)
                     for (std::size_t j = 0; j < k; ++j)
                     {
-                        std::swap(L(k, j), L(pivot, j));
+                        std::swap(l(k, j), l(pivot, j));
                     }
                 }
 
                 for (std::size_t i = k + 1; i < n; ++i)
                 {
-                    const T m = U(i, k) / U(k, k);
-                    L(i, k) = m;
-                    U(i, k) = static_cast<T>(0);
+                    const T m = u(i, k) / u(k, k);
+                    l(i, k) = m;
+                    u(i, k) = static_cast<T>(0);
 
                     for (std::size_t j = k + 1; j < n; ++j)
                     {
-                        U(i, j) -= m * U(k, j);
+                        u(i, j) -= m * u(k, j);
                     }
                 }
             }
@@ -174,14 +403,19 @@ namespace miv::math
             const std::size_t n = L.rows();
             miv::matrix<T> y(n, 1);
 
+            const miv::matrix_view<const T> l(L);
+            const miv::matrix_view<T> yv(y);
+            // b — вектор 1 x n или n x 1, в обоих случаях элементы лежат подряд
+            const miv::array_view<const T> bv(b_work.data(), vector_length(b_work));
+
             for (std::size_t i = 0; i < n; ++i)
             {
                 T sum = 0;
                 for (std::size_t j = 0; j < i; ++j)
                 {
-                    sum += L(i, j) * y(j, 0);
+                    sum += l(i, j) * yv(j, 0);
                 }
-                y(i, 0) = vector_at(b_work, i) - sum;
+                yv(i, 0) = bv[i] - sum;
             }
 
             return y;
@@ -197,6 +431,10 @@ namespace miv::math
             const std::size_t n = U.rows();
             miv::matrix<T> x(n, 1);
 
+            const miv::matrix_view<const T> u(U);
+            const miv::matrix_view<T> xv(x);
+            const miv::array_view<const T> yv(y.data(), vector_length(y));
+
             for (std::size_t i = n; i > 0; --i)
             {
                 const std::size_t row = i - 1;
@@ -204,10 +442,10 @@ namespace miv::math
 
                 for (std::size_t j = row + 1; j < n; ++j)
                 {
-                    sum += U(row, j) * x(j, 0);
+                    sum += u(row, j) * xv(j, 0);
                 }
 
-                x(row, 0) = (vector_at(y, row) - sum) / U(row, row);
+                xv(row, 0) = (yv[row] - sum) / u(row, row);
             }
 
             return x;
@@ -219,7 +457,7 @@ namespace miv::math
         template <Number U>
         static miv::matrix<T> cast_matrix(const miv::matrix<U> &src)
         {
-            miv::matrix<T> out(src.rows(), src.cols());
+            miv::matrix<T> out(src.rows(), src.cols(), miv::uninitialized);
 
             for (std::size_t i = 0; i < src.size(); ++i)
             {
@@ -0,0 +1,388 @@
+#ifndef MIV_MATH_EXPRESSION_H
+#define MIV_MATH_EXPRESSION_H
+
+#include <cstddef>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <concepts>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "containers/matrix.hpp"
+#include "math/helpers.hpp"   // Number, for_each_chunk
+
+namespace miv::math::expr
+{
+    /**
+     * @brief Ленивые поэлементные выражения над матрицами (expression templates).
+     *
+     * Операторы возвращают не матрицу, а узел дерева выражения; вычисление
+     * происходит одним слитым циклом при присваивании в miv::matrix
+     * (или при явном eval()), без промежуточных матриц:
+     *
+     * @code
+     * using namespace miv::math::expr;
+     * miv::matrix<double> r = a * k + hadamard(b, c) - sin(d);   // один проход, одно выделение
+     * r = r * 0.5 + a;                                            // на месте, без выделений
+     * @endcode
+     *
+     * Все узлы поэлементные, поэтому выражение может читать ту же матрицу,
+     * в которую записывается. Lvalue-матрицы хранятся в узлах по ссылке:
+     * выражение нельзя переживать матрицы-операнды (auto e = a + b; — только
+     * пока живы a и b). Временные матрицы (rvalue) забираются в узел по значению.
+     *
+     * Операции: +, -, * и / на скаляр, унарный минус, hadamard, min, max,
+     * apply(e, f), sin, cos, abs.
+     */
+
+    // ============================================================
+    //                        Node concept
+    // ============================================================
+
+    /**
+     * @brief Базовый тег всех узлов выражения.
+     */
+    struct node_tag {};
+
+    template <typename E>
+    concept Node = std::derived_from<std::remove_cvref_t<E>, node_tag>;
+
+    /**
+     * @brief Узел либо матрица — то, что может стоять операндом выражения.
+     */
+    template <typename E>
+    struct is_matrix : std::false_type {};
+
+    template <typename T>
+    struct is_matrix<miv::matrix<T>> : std::true_type
+    {
+        using element_t = T;
+    };
+
+    template <typename E>
+    concept Operand = Node<E> || is_matrix<std::remove_cvref_t<E>>::value;
+
+    /**
+     * @brief Общая часть всех узлов: вычисление в буфер одним циклом.
+     *
+     * Большие выражения вычисляются кусками параллельно (for_each_chunk),
+     * поэтому функторы apply() не должны иметь разделяемого изменяемого состояния.
+     */
+    template <typename Derived>
+    struct evaluable : node_tag
+    {
+        template <Number U>
+        void eval_into(U *out) const
+        {
+            const Derived &self = static_cast<const Derived &>(*this);
+
+            for_each_chunk(self.rows() * self.cols(), [&self, out](std::size_t lo, std::size_t hi)
+            {
+                for (std::size_t i = lo; i < hi; ++i)
+                {
+                    out[i] = static_cast<U>(self[i]);
+                }
+            });
+        }
+    };
+
+    // ============================================================
+    //                           Leaves
+    // ============================================================
+
+    /**
+     * @brief Лист-ссылка на существующую матрицу.
+     */
+    template <Number T>
+    class matrix_ref : public evaluable<matrix_ref<T>>
+    {
+    public:
+        using value_t = T;
+
+        explicit matrix_ref(const miv::matrix<T> &m) : m_data(m.data()), m_rows(m.rows()), m_cols(m.cols()) {}
+
+        std::size_t rows() const { return m_rows; }
+        std::size_t cols() const { return m_cols; }
+        T operator[](std::size_t i) const { return m_data[i]; }
+
+    private:
+        const T *m_data;
+        std::size_t m_rows;
+        std::size_t m_cols;
+    };
+
+    /**
+     * @brief Лист, владеющий временной матрицей (операнд-rvalue).
+     */
+    template <Number T>
+    class matrix_value : public evaluable<matrix_value<T>>
+    {
+    public:
+        using value_t = T;
+
+        explicit matrix_value(miv::matrix<T> &&m) : m_matrix(std::move(m)) {}
+
+        std::size_t rows() const { return m_matrix.rows(); }
+        std::size_t cols() const { return m_matrix.cols(); }
+        T operator[](std::size_t i) const { return m_matrix.data()[i]; }
+
+    private:
+        miv::matrix<T> m_matrix;
+    };
+
+    /**
+     * @brief Обернуть операнд в узел: узел копируется, lvalue-матрица — по ссылке,
+     * rvalue-матрица — по значению.
+     */
+    template <Operand E>
+    inline auto wrap(E &&e)
+    {
+        using D = std::remove_cvref_t<E>;
+
+        if constexpr (Node<D>)
+        {
+            return D(std::forward<E>(e));
+        }
+        else if constexpr (std::is_lvalue_reference_v<E>)
+        {
+            return matrix_ref<typename is_matrix<D>::element_t>(e);
+        }
+        else
+        {
+            return matrix_value<typename is_matrix<D>::element_t>(std::move(e));
+        }
+    }
+
+    template <Operand E>
+    using node_t = decltype(wrap(std::declval<E>()));
+
+    // ============================================================
+    //                         Inner nodes
+    // ============================================================
+
+    /**
+     * @brief f(e[i]).
+     */
+    template <typename E, typename F>
+    class unary_node : public evaluable<unary_node<E, F>>
+    {
+    public:
+        using value_t = std::invoke_result_t<const F &, typename E::value_t>;
+
+        unary_node(E e, F f) : m_e(std::move(e)), m_f(std::move(f)) {}
+
+        std::size_t rows() const { return m_e.rows(); }
+        std::size_t cols() const { return m_e.cols(); }
+        value_t operator[](std::size_t i) const { return m_f(m_e[i]); }
+
+    private:
+        E m_e;
+        F m_f;
+    };
+
+    /**
+     * @brief f(l[i], r[i]) для операндов одинаковой формы.
+     */
+    template <typename L, typename R, typename F>
+    class binary_node : public evaluable<binary_node<L, R, F>>
+    {
+    public:
+        using value_t = std::invoke_result_t<const F &, typename L::value_t, typename R::value_t>;
+
+        binary_node(L l, R r, F f, const char *name) : m_l(std::move(l)), m_r(std::move(r)), m_f(std::move(f))
+        {
+            if (m_l.rows() != m_r.rows() || m_l.cols() != m_r.cols())
+            {
+                throw std::invalid_argument(std::string(name) + ": matrices must have the same shape" +
+                    " (left=" + std::to_string(m_l.rows()) + "x" + std::to_string(m_l.cols()) +
+                    ", right=" + std::to_string(m_r.rows()) + "x" + std::to_string(m_r.cols()) + ")");
+            }
+        }
+
+        std::size_t rows() const { return m_l.rows(); }
+        std::size_t cols() const { return m_l.cols(); }
+        value_t operator[](std::size_t i) const { return m_f(m_l[i], m_r[i]); }
+
+    private:
+        L m_l;
+        R m_r;
+        F m_f;
+    };
+
+    template <typename E, typename F>
+    inline auto make_unary(E &&e, F f)
+    {
+        using N = node_t<E>;
+        return unary_node<N, F>(wrap(std::forward<E>(e)), std::move(f));
+    }
+
+    template <typename L, typename R, typename F>
+    inline auto make_binary(L &&l, R &&r, F f, const char *name)
+    {
+        using NL = node_t<L>;
+        using NR = node_t<R>;
+        return binary_node<NL, NR, F>(wrap(std::forward<L>(l)), wrap(std::forward<R>(r)), std::move(f), name);
+    }
+
+    template <Operand E>
+    using value_of = typename node_t<E>::value_t;
+
+    // ============================================================
+    //                         Operators
+    // ============================================================
+
+    template <Operand L, Operand R>
+    inline auto operator+(L &&l, R &&r)
+    {
+        return make_binary(std::forward<L>(l), std::forward<R>(r), [](auto x, auto y) { return x + y; }, "operator+");
+    }
+
+    template <Operand L, Operand R>
+    inline auto operator-(L &&l, R &&r)
+    {
+        return make_binary(std::forward<L>(l), std::forward<R>(r), [](auto x, auto y) { return x - y; }, "operator-");
+    }
+
+    template <Operand E>
+    inline auto operator-(E &&e)
+    {
+        return make_unary(std::forward<E>(e), [](auto x) { return -x; });
+    }
+
+    /**
+     * @brief Умножение на скаляр (с любой стороны). Скаляр приводится к типу элементов.
+     *
+     * Умножение двух матриц не определено намеренно: A * B неоднозначно
+     * (матричное или поэлементное) — используйте matmul() или hadamard().
+     */
+    template <Operand E, Number S>
+    inline auto operator*(E &&e, S k)
+    {
+        const auto kv = static_cast<value_of<E>>(k);
+        return make_unary(std::forward<E>(e), [kv](auto x) { return x * kv; });
+    }
+
+    template <Number S, Operand E>
+    inline auto operator*(S k, E &&e)
+    {
+        const auto kv = static_cast<value_of<E>>(k);
+        return make_unary(std::forward<E>(e), [kv](auto x) { return kv * x; });
+    }
+
+    /**
+     * @brief Деление на скаляр.
+     *
+     * @throws std::invalid_argument если k == 0
+     */
+    template <Operand E, Number S>
+    inline auto operator/(E &&e, S k)
+    {
+        const auto kv = static_cast<value_of<E>>(k);
+        if (kv == value_of<E>{})
+        {
+            throw std::invalid_argument("operator/: division by zero");
+        }
+        return make_unary(std::forward<E>(e), [kv](auto x) { return x / kv; });
+    }
+
+    // ============================================================
+    //                     Named element-wise ops
+    // ============================================================
+
+    /**
+     * @brief Ленивое произведение Адамара: l ⊙ r.
+     */
+    template <Operand L, Operand R>
+    inline auto hadamard(L &&l, R &&r)
+    {
+        return make_binary(std::forward<L>(l), std::forward<R>(r), [](auto x, auto y) { return x * y; }, "hadamard()");
+    }
+
+    template <Operand L, Operand R>
+    inline auto min(L &&l, R &&r)
+    {
+        return make_binary(std::forward<L>(l), std::forward<R>(r),
+            [](auto x, auto y) { return std::min<std::common_type_t<decltype(x), decltype(y)>>(x, y); }, "min()");
+    }
+
+    template <Operand L, Operand R>
+    inline auto max(L &&l, R &&r)
+    {
+        return make_binary(std::forward<L>(l), std::forward<R>(r),
+            [](auto x, auto y) { return std::max<std::common_type_t<decltype(x), decltype(y)>>(x, y); }, "max()");
+    }
+
+    /**
+     * @brief Ленивый apply: f(e[i]) (см. miv::math::apply).
+     */
+    template <Operand E, typename F>
+        requires std::invocable<const F &, value_of<E>> && Number<std::invoke_result_t<const F &, value_of<E>>>
+    inline auto apply(E &&e, F f)
+    {
+        return make_unary(std::forward<E>(e), std::move(f));
+    }
+
+    template <Operand E>
+        requires std::is_floating_point_v<value_of<E>>
+    inline auto sin(E &&e)
+    {
+        return make_unary(std::forward<E>(e), [](auto x) { return static_cast<decltype(x)>(std::sin(x)); });
+    }
+
+    template <Operand E>
+        requires std::is_floating_point_v<value_of<E>>
+    inline auto cos(E &&e)
+    {
+        return make_unary(std::forward<E>(e), [](auto x) { return static_cast<decltype(x)>(std::cos(x)); });
+    }
+
+    template <Operand E>
+    inline auto abs(E &&e)
+    {
+        return make_unary(std::forward<E>(e), [](auto x) { return static_cast<decltype(x)>(std::abs(x)); });
+    }
+
+    // ============================================================
+    //                         Evaluation
+    // ============================================================
+
+    /**
+     * @brief Явно сделать матрицу листом выражения (например, чтобы вызвать eval()).
+     */
+    template <Number T>
+    inline matrix_ref<T> lazy(const miv::matrix<T> &m)
+    {
+        return matrix_ref<T>(m);
+    }
+
+    /**
+     * @brief Вычислить выражение в новую матрицу.
+     */
+    template <Node E>
+    inline auto eval(const E &e)
+    {
+        return miv::matrix<typename E::value_t>(e);
+    }
+
+    /**
+     * @brief Вычислить выражение в существующую матрицу (одинаковой формы — без выделений).
+     */
+    template <Number T, Node E>
+    inline void assign(miv::matrix<T> &dst, const E &e)
+    {
+        dst = e;
+    }
+}
+
+namespace miv
+{
+    // Операторы должны находиться через ADL и для miv::matrix, и для узлов
+    using miv::math::expr::operator+;
+    using miv::math::expr::operator-;
+    using miv::math::expr::operator*;
+    using miv::math::expr::operator/;
+}
+
+#endif // MIV_MATH_EXPRESSION_H
@@ -0,0 +1,177 @@
+#ifndef MIV_MATH_FACTORIZATION_CACHE_H
+#define MIV_MATH_FACTORIZATION_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <utility>
+
+#include "containers/array.hpp"
+#include "math/helpers.hpp"   // FloatNumber, norm_t
+
+namespace miv::math
+{
+    /**
+     * @brief LRU-кэш разложений Якобиана, найденных по близкой точке x.
+     *
+     * Запись — точка x, в которой строился Якобиан, и копия его разложения
+     * (Factorization: detail::dense_lu, sparse_lu, ...). find(x) возвращает
+     * ближайшую запись с ||x - x_c|| <= radius * (1 + ||x_c||) и отмечает её
+     * использованной; insert() вытесняет давно неиспользованные записи, пока
+     * суммарный объём (оценка, переданная вызывающим) не уложится в capacity.
+     *
+     * Записей немного (объём ограничен), поэтому поиск — линейный просмотр:
+     * O(entries * n), что несопоставимо дешевле построения и разложения Якобиана.
+     */
+    template <FloatNumber T, typename Factorization>
+    class factorization_cache
+    {
+    public:
+        /**
+         * @brief Кэш объёмом не больше capacity_bytes (0 — выключен, insert ничего не хранит).
+         */
+        explicit factorization_cache(std::size_t capacity_bytes = 0) : m_capacity(capacity_bytes) {}
+
+        /**
+         * @brief Новый предел объёма; лишние записи вытесняются сразу.
+         */
+        void set_capacity(std::size_t capacity_bytes)
+        {
+            m_capacity = capacity_bytes;
+            evict_to(m_capacity);
+        }
+
+        std::size_t capacity() const { return m_capacity; }
+        bool enabled() const { return m_capacity > 0; }
+
+        std::size_t size() const { return m_entries.size(); }
+        bool empty() const { return m_entries.empty(); }
+
+        /**
+         * @brief Суммарный объём записей, байт.
+         */
+        std::size_t bytes() const { return m_bytes; }
+
+        std::size_t hits() const { return m_hits; }
+        std::size_t misses() const { return m_misses; }
+
+        void clear()
+        {
+            m_entries.clear();
+            m_bytes = 0;
+        }
+
+        /**
+         * @brief Ближайшее к x разложение в пределах radius * (1 + ||x_c||), иначе nullptr.
+         *
+         * Указатель действителен до следующего insert() / clear().
+         */
+        const Factorization *find(const miv::array<T> &x, norm_t radius)
+        {
+            entry *best = nullptr;
+            norm_t best_distance = 0;
+
+            for (auto &e : m_entries)
+            {
+                if (e.x.size() != x.size())
+                {
+                    continue;
+                }
+
+                norm_t d2 = 0;
+                for (std::size_t i = 0; i < x.size(); ++i)
+                {
+                    const norm_t d = static_cast<norm_t>(x[i]) - static_cast<norm_t>(e.x[i]);
+                    d2 += d * d;
+                }
+
+                const norm_t limit = radius * (static_cast<norm_t>(1) + e.x_norm);
+                if (d2 <= limit * limit && (best == nullptr || d2 < best_distance))
+                {
+                    best = &e;
+                    best_distance = d2;
+                }
+            }
+
+            if (best == nullptr)
+            {
+                ++m_misses;
+                return nullptr;
+            }
+
+            ++m_hits;
+            best->last_used = ++m_clock;
+            return &best->factorization;
+        }
+
+        /**
+         * @brief Запомнить разложение Якобиана в точке x (bytes — его объём).
+         *
+         * Запись больше capacity не хранится.
+         */
+        void insert(const miv::array<T> &x, const Factorization &factorization, std::size_t bytes)
+        {
+            const std::size_t total = bytes + x.size() * sizeof(T);
+            if (total > m_capacity)
+            {
+                return;
+            }
+
+            evict_to(m_capacity - total);
+
+            norm_t x_norm = 0;
+            for (std::size_t i = 0; i < x.size(); ++i)
+            {
+                x_norm += static_cast<norm_t>(x[i]) * static_cast<norm_t>(x[i]);
+            }
+
+            m_entries.push_back({ x, std::sqrt(x_norm), factorization, total, ++m_clock });
+            m_bytes += total;
+        }
+
+    private:
+        struct entry
+        {
+            miv::array<T> x;
+            norm_t x_norm = 0;
+            Factorization factorization;
+            std::size_t bytes = 0;
+            std::uint64_t last_used = 0;
+        };
+
+        /**
+         * @brief Вытеснять давно неиспользованные записи, пока объём > limit.
+         */
+        void evict_to(std::size_t limit)
+        {
+            while (m_bytes > limit && !m_entries.empty())
+            {
+                std::size_t oldest = 0;
+                for (std::size_t i = 1; i < m_entries.size(); ++i)
+                {
+                    if (m_entries[i].last_used < m_entries[oldest].last_used)
+                    {
+                        oldest = i;
+                    }
+                }
+
+                m_bytes -= m_entries[oldest].bytes;
+                if (oldest + 1 != m_entries.size())
+                {
+                    m_entries[oldest] = std::move(m_entries.back());
+                }
+                m_entries.pop_back();
+            }
+        }
+
+        std::size_t m_capacity;
+        std::size_t m_bytes = 0;
+        std::uint64_t m_clock = 0;
+        std::size_t m_hits = 0;
+        std::size_t m_misses = 0;
+        std::vector<entry> m_entries;
+    };
+}
+
+#endif // MIV_MATH_FACTORIZATION_CACHE_H
@@ -0,0 +1,363 @@
+#ifndef MIV_MATH_FIXED_LU_H
+#define MIV_MATH_FIXED_LU_H
+
+#include <cstddef>
+#include <string>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#include "containers/array.hpp"
+#include "containers/matrix.hpp"
+#include "containers/fixed_array.hpp"
+#include "containers/fixed_matrix.hpp"
+#include "containers/profile.hpp"
+#include "math/helpers.hpp"   // FloatNumber, require_squareness
+
+namespace miv::math
+{
+    /**
+     * @brief Наибольший размер системы, для которого есть ядра с размером времени компиляции.
+     */
+    inline constexpr std::size_t max_fixed_size = 8;
+
+    // ============================================================
+    //            Fixed-size kernels (N известно при компиляции)
+    // ============================================================
+    //
+    // Тот же упакованный формат, что у lu_decompose_lup_packed: U на и над
+    // диагональю, множители L под ней, pivots[k] — строка, обменянная со строкой k.
+    // Все границы циклов — константы, компилятор полностью разворачивает их
+    // при малых N; никаких выделений памяти и проверок границ.
+
+    namespace detail
+    {
+        template <FloatNumber T>
+        constexpr T fixed_abs(T v)
+        {
+            return v < T{} ? -v : v;
+        }
+    }
+
+    /**
+     * @brief LUP-разложение N x N на месте (a — N * N элементов по строкам).
+     *
+     * @throws std::invalid_argument если матрица вырожденная
+     */
+    template <std::size_t N, FloatNumber T>
+    constexpr void fixed_lu_decompose(T *a, std::size_t *pivots)
+    {
+        const T eps = static_cast<T>(1e-18);
+
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            std::size_t pivot = k;
+            T max_val = detail::fixed_abs(a[k * N + k]);
+
+            for (std::size_t i = k + 1; i < N; ++i)
+            {
+                const T val = detail::fixed_abs(a[i * N + k]);
+                if (val > max_val)
+                {
+                    max_val = val;
+                    pivot = i;
+                }
+            }
+
+            if (max_val <= eps)
+            {
+                throw std::invalid_argument("fixed_lu_decompose(): matrix is singular or near-singular");
+            }
+
+            pivots[k] = pivot;
+
+            if (pivot != k)
+            {
+                for (std::size_t j = 0; j < N; ++j)
+                {
+                    const T tmp = a[k * N + j];
+                    a[k * N + j] = a[pivot * N + j];
+                    a[pivot * N + j] = tmp;
+                }
+            }
+
+            const T inv = static_cast<T>(1) / a[k * N + k];
+
+            for (std::size_t i = k + 1; i < N; ++i)
+            {
+                const T m = a[i * N + k] * inv;
+                a[i * N + k] = m;
+
+                for (std::size_t j = k + 1; j < N; ++j)
+                {
+                    a[i * N + j] -= m * a[k * N + j];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Решить (LU) x = P b на месте по результату fixed_lu_decompose.
+     */
+    template <std::size_t N, FloatNumber T>
+    constexpr void fixed_lu_solve(const T *lu, const std::size_t *pivots, T *b)
+    {
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            if (pivots[k] != k)
+            {
+                const T tmp = b[k];
+                b[k] = b[pivots[k]];
+                b[pivots[k]] = tmp;
+            }
+        }
+
+        // L y = Pb (единичная диагональ)
+        for (std::size_t i = 1; i < N; ++i)
+        {
+            T sum = b[i];
+            for (std::size_t j = 0; j < i; ++j)
+            {
+                sum -= lu[i * N + j] * b[j];
+            }
+            b[i] = sum;
+        }
+
+        // U x = y
+        for (std::size_t i = N; i > 0; --i)
+        {
+            const std::size_t row = i - 1;
+            T sum = b[row];
+            for (std::size_t j = row + 1; j < N; ++j)
+            {
+                sum -= lu[row * N + j] * b[j];
+            }
+            b[row] = sum / lu[row * N + row];
+        }
+    }
+
+    /**
+     * @brief Вызвать f(std::integral_constant<size_t, N>{}) для N == n.
+     *
+     * Переводит размер, известный только во время выполнения, в параметр шаблона
+     * (N = 1..max_fixed_size).
+     *
+     * @return false, если n вне диапазона (f не вызывается)
+     */
+    template <typename F>
+    inline bool with_fixed_size(std::size_t n, F &&f)
+    {
+        return [&]<std::size_t... I>(std::index_sequence<I...>)
+        {
+            return ((n == I + 1 && (f(std::integral_constant<std::size_t, I + 1>{}), true)) || ...);
+        }(std::make_index_sequence<max_fixed_size>{});
+    }
+
+    // ============================================================
+    //                   fixed_lu_factorization
+    // ============================================================
+
+    /**
+     * @brief LUP-разложение матрицы фиксированного размера N x N (всё на стеке).
+     *
+     * Полностью constexpr: систему можно решить при компиляции.
+     *
+     * @code
+     * constexpr miv::fixed_matrix<double, 2, 2> A{ 4, 1, 2, 3 };
+     * constexpr auto x = miv::math::fixed_solve(A, miv::fixed_array<double, 2>{ 1, 2 });
+     * @endcode
+     */
+    template <FloatNumber T, std::size_t N>
+    class fixed_lu_factorization
+    {
+    public:
+        using value_t = T;
+
+        /**
+         * @brief Разложить A (A копируется).
+         *
+         * @throws std::invalid_argument если A вырожденная
+         */
+        constexpr explicit fixed_lu_factorization(const miv::fixed_matrix<T, N, N> &A)
+            : m_LU(A), m_pivots()
+        {
+            fixed_lu_decompose<N>(m_LU.data(), m_pivots);
+        }
+
+        static constexpr std::size_t n() { return N; }
+
+        /**
+         * @brief Упакованные множители: U на и над диагональю, L под диагональю.
+         */
+        constexpr const miv::fixed_matrix<T, N, N> &packed() const { return m_LU; }
+
+        /**
+         * @brief Решить Ax = b на месте: b заменяется на x.
+         */
+        constexpr void solve_inplace(miv::fixed_array<T, N> &b) const
+        {
+            fixed_lu_solve<N>(m_LU.data(), m_pivots, b.data());
+        }
+
+        /**
+         * @brief Решить Ax = b и вернуть x.
+         */
+        constexpr miv::fixed_array<T, N> solve(const miv::fixed_array<T, N> &b) const
+        {
+            miv::fixed_array<T, N> x = b;
+            solve_inplace(x);
+            return x;
+        }
+
+    private:
+        miv::fixed_matrix<T, N, N> m_LU;
+        std::size_t m_pivots[N];
+    };
+
+    /**
+     * @brief Решить Ax = b для матрицы фиксированного размера.
+     *
+     * @throws std::invalid_argument если A вырожденная
+     */
+    template <FloatNumber T, std::size_t N>
+    constexpr miv::fixed_array<T, N> fixed_solve(const miv::fixed_matrix<T, N, N> &A, const miv::fixed_array<T, N> &b)
+    {
+        return fixed_lu_factorization<T, N>(A).solve(b);
+    }
+
+    // ============================================================
+    //                   small_lu_factorization
+    // ============================================================
+
+    /**
+     * @brief LUP-разложение малой системы (n <= max_fixed_size), размер — во время выполнения.
+     *
+     * Хранит множители во встроенном буфере max_fixed_size^2 и вызывает
+     * fixed_lu_decompose<N> / fixed_lu_solve<N> для конкретного N через
+     * with_fixed_size: цикл Ньютона с n из get_system_functions() получает
+     * развёрнутые ядра без кучи. Интерфейс совпадает с lu_factorization.
+     */
+    template <FloatNumber T>
+    class small_lu_factorization
+    {
+    public:
+        using value_t = T;
+
+        /**
+         * @brief Пустое (ещё не выполненное) разложение.
+         */
+        small_lu_factorization() = default;
+
+        /**
+         * @brief Сразу разложить матрицу A.
+         *
+         * @throws std::invalid_argument если A не квадратная, больше max_fixed_size или вырожденная
+         */
+        explicit small_lu_factorization(const miv::matrix<T> &A)
+        {
+            factorize(A);
+        }
+
+        /**
+         * @brief Подходит ли размер n для этого разложения.
+         */
+        static constexpr bool supports(std::size_t n) { return n > 0 && n <= max_fixed_size; }
+
+        /**
+         * @brief Выполнить (или повторить) разложение матрицы A.
+         *
+         * Если разложение не удалось, объект становится пустым.
+         *
+         * @throws std::invalid_argument если A не квадратная, больше max_fixed_size или вырожденная
+         */
+        void factorize(const miv::matrix<T> &A)
+        {
+            require_squareness(A);
+
+            const std::size_t n = A.rows();
+            if (!supports(n))
+            {
+                throw std::invalid_argument(
+                    "small_lu_factorization: n must be in [1, " + std::to_string(max_fixed_size) +
+                    "], but got " + std::to_string(n));
+            }
+
+            MIV_PROFILE_SCOPE(factorize);
+
+            m_n = 0;
+            std::copy(A.data(), A.data() + n * n, m_LU);
+
+            with_fixed_size(n, [this](auto N)
+            {
+                fixed_lu_decompose<N()>(m_LU, m_pivots);
+            });
+
+            m_n = n;
+        }
+
+        /**
+         * @brief Было ли выполнено разложение.
+         */
+        bool empty() const { return m_n == 0; }
+
+        /**
+         * @brief Размерность разложенной матрицы (n).
+         */
+        std::size_t n() const { return m_n; }
+
+        /**
+         * @brief Решить Ax = b на месте: b заменяется на x.
+         *
+         * @throws std::logic_error если разложение не выполнено
+         * @throws std::invalid_argument если длина b не равна n
+         */
+        template <typename Alloc>
+        void solve_inplace(miv::array<T, Alloc> &b) const
+        {
+            require_rhs_length(b.size());
+            solve_raw(b.data());
+        }
+
+        /**
+         * @brief Решить Ax = b на месте для вектора-матрицы (1 x n или n x 1).
+         */
+        void solve_inplace(miv::matrix<T> &b) const
+        {
+            require_rhs_length(vector_length(b));
+            solve_raw(b.data());
+        }
+
+    private:
+        void require_rhs_length(std::size_t len) const
+        {
+            if (empty())
+            {
+                throw std::logic_error("small_lu_factorization::solve(): factorization is empty");
+            }
+
+            if (len != m_n)
+            {
+                throw std::invalid_argument(
+                    "small_lu_factorization::solve(): b must be a vector of length n = " + std::to_string(m_n) +
+                    ", but got length " + std::to_string(len));
+            }
+        }
+
+        void solve_raw(T *x) const
+        {
+            MIV_PROFILE_SCOPE(substitute);
+
+            with_fixed_size(m_n, [this, x](auto N)
+            {
+                fixed_lu_solve<N()>(m_LU, m_pivots, x);
+            });
+        }
+
+        T m_LU[max_fixed_size * max_fixed_size] = {};
+        std::size_t m_pivots[max_fixed_size] = {};
+        std::size_t m_n = 0;
+    };
+}
+
+#endif // MIV_MATH_FIXED_LU_H
@@ -19,6 +19,12 @@ namespace miv::math
      *
      * Где U тоже должен быть числом (Number), иначе это уже не "математика матриц".
      *
+     * Для больших матриц f вызывается параллельно из нескольких потоков
+     * (см. for_each_chunk), поэтому f не должна иметь разделяемого изменяемого состояния.
+     *
+     * Внутри цепочки операций удобнее ленивый вариант expr::apply
+     * (math/expression.hpp): он не создаёт промежуточную матрицу.
+     *
      * @tparam T Тип элементов исходной матрицы
      * @tparam F Тип функции
      * @return matrix<U>
@@ -29,12 +35,18 @@ namespace miv::math
     {
         using U = std::invoke_result_t<F, T>;
 
-        miv::matrix<U> out(a.rows(), a.cols());
+        miv::matrix<U> out(a.rows(), a.cols(), miv::uninitialized);
 
-        for (std::size_t i = 0; i < a.size(); ++i)
+        const T *pa = a.data();
+        U *po = out.data();
+
+        for_each_chunk(a.size(), [&](std::size_t lo, std::size_t hi)
         {
-            out.data()[i] = static_cast<U>(f(a.data()[i]));
-        }
+            for (std::size_t i = lo; i < hi; ++i)
+            {
+                po[i] = static_cast<U>(f(pa[i]));
+            }
+        });
 
         return out;
     }
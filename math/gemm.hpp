@@ -0,0 +1,353 @@
+#ifndef MIV_MATH_GEMM_H
+#define MIV_MATH_GEMM_H
+
+#include <cstddef>
+#include <algorithm>
+
+#include "containers/array.hpp"
+#include "exec/thread_pool.hpp"
+#include "math/helpers.hpp"   // Number
+
+namespace miv::math
+{
+    /**
+     * @brief Выбор ядра матричного произведения.
+     *
+     * - naive:     классический тройной цикл i-t-j (эталон)
+     * - blocked:   блочное GEMM-ядро с упаковкой панелей и регистровым тайлом
+     * - automatic: blocked для достаточно больших матриц, иначе naive
+     */
+    enum class matmul_kernel
+    {
+        naive,
+        blocked,
+        automatic
+    };
+
+    /**
+     * @brief Параметры блочного разбиения GEMM для типа T.
+     *
+     * mr x nr — регистровый тайл микроядра, kc/mc/nc — размеры блоков
+     * (kc x nr панель B живёт в L1, mc x kc блок A — в L2, kc x nc блок B — в L3).
+     *
+     * Общий вариант (long double, Float128 и целые) — скромный тайл 4 x 4.
+     */
+    template <Number T>
+    struct gemm_blocking
+    {
+        static constexpr std::size_t mr = 4;
+        static constexpr std::size_t nr = 4;
+        static constexpr std::size_t kc = 128;
+        static constexpr std::size_t mc = 64;
+        static constexpr std::size_t nc = 1024;
+    };
+
+    /**
+     * @brief float: тайл 4 x 32.
+     *
+     * Форма тайла подобрана так, чтобы GCC/Clang надёжно векторизовали микроядро
+     * и с базовым SSE2, и с -march=native (AVX2/AVX-512).
+     */
+    template <>
+    struct gemm_blocking<float>
+    {
+        static constexpr std::size_t mr = 4;
+        static constexpr std::size_t nr = 32;
+        static constexpr std::size_t kc = 256;
+        static constexpr std::size_t mc = 96;
+        static constexpr std::size_t nc = 4096;
+    };
+
+    /**
+     * @brief double: тайл 4 x 8 (см. комментарий к float).
+     */
+    template <>
+    struct gemm_blocking<double>
+    {
+        static constexpr std::size_t mr = 4;
+        static constexpr std::size_t nr = 8;
+        static constexpr std::size_t kc = 256;
+        static constexpr std::size_t mc = 96;
+        static constexpr std::size_t nc = 4096;
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief Упаковать блок A (mc x kc) в панели по mr строк.
+         *
+         * Панель i хранится как kc столбцов по mr элементов; хвост добивается нулями.
+         */
+        template <Number T>
+        inline void gemm_pack_a(std::size_t mc, std::size_t kc, const T *A, std::size_t lda, T *Ap)
+        {
+            constexpr std::size_t mr = gemm_blocking<T>::mr;
+
+            for (std::size_t i = 0; i < mc; i += mr)
+            {
+                const std::size_t rows = std::min(mr, mc - i);
+
+                for (std::size_t p = 0; p < kc; ++p)
+                {
+                    for (std::size_t r = 0; r < rows; ++r)
+                    {
+                        Ap[r] = A[(i + r) * lda + p];
+                    }
+                    for (std::size_t r = rows; r < mr; ++r)
+                    {
+                        Ap[r] = T{};
+                    }
+                    Ap += mr;
+                }
+            }
+        }
+
+        /**
+         * @brief Упаковать блок B (kc x nc) в панели по nr столбцов.
+         *
+         * Панель j хранится как kc строк по nr элементов; хвост добивается нулями.
+         */
+        template <Number T>
+        inline void gemm_pack_b(std::size_t kc, std::size_t nc, const T *B, std::size_t ldb, T *Bp)
+        {
+            constexpr std::size_t nr = gemm_blocking<T>::nr;
+
+            for (std::size_t j = 0; j < nc; j += nr)
+            {
+                const std::size_t cols = std::min(nr, nc - j);
+
+                for (std::size_t p = 0; p < kc; ++p)
+                {
+                    const T *src = B + p * ldb + j;
+                    for (std::size_t c = 0; c < cols; ++c)
+                    {
+                        Bp[c] = src[c];
+                    }
+                    for (std::size_t c = cols; c < nr; ++c)
+                    {
+                        Bp[c] = T{};
+                    }
+                    Bp += nr;
+                }
+            }
+        }
+
+        /**
+         * @brief Поточный буфер упаковки (Slot различает буферы A и B), не меньше size элементов.
+         */
+        template <Number T, int Slot>
+        inline miv::array<T> &gemm_thread_buffer(std::size_t size)
+        {
+            thread_local miv::array<T> buffer;
+
+            if (buffer.size() < size)
+            {
+                buffer = miv::array<T>(size);
+            }
+
+            return buffer;
+        }
+
+        /**
+         * @brief Микроядро: C[mr x nr] += alpha * Ap * Bp.
+         *
+         * Аккумуляторы — локальный массив фиксированного размера, который компилятор
+         * раскладывает по регистрам и векторизует по j. Запись в C — только rows x cols.
+         */
+        template <Number T>
+        inline void gemm_micro_kernel(
+            std::size_t kc,
+            const T *Ap,
+            const T *Bp,
+            T alpha,
+            T *C,
+            std::size_t ldc,
+            std::size_t rows,
+            std::size_t cols)
+        {
+            constexpr std::size_t mr = gemm_blocking<T>::mr;
+            constexpr std::size_t nr = gemm_blocking<T>::nr;
+
+            T acc[mr][nr] = {};
+
+            for (std::size_t p = 0; p < kc; ++p)
+            {
+                const T *a = Ap + p * mr;
+                const T *b = Bp + p * nr;
+
+                for (std::size_t i = 0; i < mr; ++i)
+                {
+                    const T av = a[i];
+                    for (std::size_t j = 0; j < nr; ++j)
+                    {
+                        acc[i][j] += av * b[j];
+                    }
+                }
+            }
+
+            for (std::size_t i = 0; i < rows; ++i)
+            {
+                T *c_row = C + i * ldc;
+                for (std::size_t j = 0; j < cols; ++j)
+                {
+                    c_row[j] += alpha * acc[i][j];
+                }
+            }
+        }
+
+        /**
+         * @brief Однопоточное блочное GEMM (см. gemm()).
+         */
+        template <Number T>
+        inline void gemm_serial(
+            std::size_t m,
+            std::size_t n,
+            std::size_t k,
+            T alpha,
+            const T *A,
+            std::size_t lda,
+            const T *B,
+            std::size_t ldb,
+            T beta,
+            T *C,
+            std::size_t ldc)
+        {
+            using blocking = gemm_blocking<T>;
+
+            if (m == 0 || n == 0)
+            {
+                return;
+            }
+
+            // beta применяется один раз, дальше ядро только накапливает
+            if (beta != static_cast<T>(1))
+            {
+                for (std::size_t i = 0; i < m; ++i)
+                {
+                    T *c_row = C + i * ldc;
+                    for (std::size_t j = 0; j < n; ++j)
+                    {
+                        c_row[j] = (beta == T{}) ? T{} : beta * c_row[j];
+                    }
+                }
+            }
+
+            if (k == 0 || alpha == T{})
+            {
+                return;
+            }
+
+            const std::size_t kc_max = std::min(blocking::kc, k);
+            const std::size_t mc_max = std::min(blocking::mc, m);
+            const std::size_t nc_max = std::min(blocking::nc, n);
+
+            // Буферы под упакованные панели (с округлением до целого числа тайлов).
+            // Свои у каждого потока и живут между вызовами: повторные gemm
+            // (блочный LU на каждой итерации Ньютона) не выделяют память.
+            const std::size_t a_size = ((mc_max + blocking::mr - 1) / blocking::mr) * blocking::mr * kc_max;
+            const std::size_t b_size = ((nc_max + blocking::nr - 1) / blocking::nr) * blocking::nr * kc_max;
+            miv::array<T> &a_pack = gemm_thread_buffer<T, 0>(a_size);
+            miv::array<T> &b_pack = gemm_thread_buffer<T, 1>(b_size);
+
+            for (std::size_t jc = 0; jc < n; jc += blocking::nc)
+            {
+                const std::size_t nc = std::min(blocking::nc, n - jc);
+
+                for (std::size_t pc = 0; pc < k; pc += blocking::kc)
+                {
+                    const std::size_t kc = std::min(blocking::kc, k - pc);
+
+                    detail::gemm_pack_b(kc, nc, B + pc * ldb + jc, ldb, b_pack.data());
+
+                    for (std::size_t ic = 0; ic < m; ic += blocking::mc)
+                    {
+                        const std::size_t mc = std::min(blocking::mc, m - ic);
+
+                        detail::gemm_pack_a(mc, kc, A + ic * lda + pc, lda, a_pack.data());
+
+                        for (std::size_t jr = 0; jr < nc; jr += blocking::nr)
+                        {
+                            const std::size_t cols = std::min(blocking::nr, nc - jr);
+                            const T *Bp = b_pack.data() + jr * kc;
+
+                            for (std::size_t ir = 0; ir < mc; ir += blocking::mr)
+                            {
+                                const std::size_t rows = std::min(blocking::mr, mc - ir);
+                                const T *Ap = a_pack.data() + ir * kc;
+
+                                detail::gemm_micro_kernel(
+                                    kc, Ap, Bp, alpha,
+                                    C + (ic + ir) * ldc + (jc + jr), ldc,
+                                    rows, cols);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Блочное GEMM над сырыми row-major буферами: C = alpha * A * B + beta * C.
+     *
+     * - A: (m x k), шаг строки lda
+     * - B: (k x n), шаг строки ldb
+     * - C: (m x n), шаг строки ldc
+     *
+     * Никаких проверок границ во внутренних циклах: вызывающий отвечает за размеры.
+     * Подходит и для подматриц (например, для обновления хвоста в блочном LU).
+     *
+     * Если m * n * k не меньше miv::exec::serial_threshold(), C режется на полосы
+     * (по строкам, либо по столбцам для широких матриц), и полосы считаются
+     * параллельно на общем пуле miv::exec.
+     */
+    template <Number T>
+    inline void gemm(
+        std::size_t m,
+        std::size_t n,
+        std::size_t k,
+        T alpha,
+        const T *A,
+        std::size_t lda,
+        const T *B,
+        std::size_t ldb,
+        T beta,
+        T *C,
+        std::size_t ldc)
+    {
+        using blocking = gemm_blocking<T>;
+
+        const std::size_t work = m * n * std::max<std::size_t>(k, 1);
+
+        if (m >= n)
+        {
+            // Полосы строк по mc: каждая полоса упаковывает свой блок A
+            const std::size_t strips = (m + blocking::mc - 1) / blocking::mc;
+
+            miv::exec::parallel_for(0, strips, work, [&](std::size_t lo, std::size_t hi)
+            {
+                const std::size_t r0 = lo * blocking::mc;
+                const std::size_t r1 = std::min(m, hi * blocking::mc);
+
+                detail::gemm_serial(r1 - r0, n, k, alpha, A + r0 * lda, lda, B, ldb, beta, C + r0 * ldc, ldc);
+            });
+        }
+        else
+        {
+            // Широкая C: полосы столбцов по nr * 16
+            constexpr std::size_t strip = blocking::nr * 16;
+            const std::size_t strips = (n + strip - 1) / strip;
+
+            miv::exec::parallel_for(0, strips, work, [&](std::size_t lo, std::size_t hi)
+            {
+                const std::size_t c0 = lo * strip;
+                const std::size_t c1 = std::min(n, hi * strip);
+
+                detail::gemm_serial(m, c1 - c0, k, alpha, A, lda, B + c0, ldb, beta, C + c0, ldc);
+            });
+        }
+    }
+
+} // namespace miv::math
+
+#endif // MIV_MATH_GEMM_H
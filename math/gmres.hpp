@@ -0,0 +1,298 @@
+#ifndef MIV_MATH_GMRES_H
+#define MIV_MATH_GMRES_H
+
+#include <cstddef>
+#include <cmath>
+#include <utility>
+#include <algorithm>
+
+#include "containers/array.hpp"
+#include "containers/matrix.hpp"
+#include "math/helpers.hpp"   // FloatNumber, norm_t
+#include "math/simd.hpp"      // dot
+
+namespace miv::math
+{
+    /**
+     * @brief Параметры GMRES(m).
+     *
+     * Остановка: ||b - A x|| <= tolerance * ||b|| или max_iterations шагов Арнольди
+     * (суммарно по всем перезапускам).
+     */
+    struct gmres_options
+    {
+        std::size_t restart = 30;
+        std::size_t max_iterations = 300;
+        norm_t tolerance = 1e-6;
+    };
+
+    /**
+     * @brief Как прошло решение GMRES.
+     */
+    struct gmres_report
+    {
+        std::size_t iterations = 0;   ///< шагов Арнольди (= умножений на A)
+        norm_t residual = 0;          ///< ||b - A x|| / ||b|| (оценка по вращениям Гивенса)
+        bool converged = false;
+    };
+
+    /**
+     * @brief Перезапускаемый GMRES(m) с правым предобуславливанием.
+     *
+     * Матрица задаётся только действием: apply(v, out) — out = A v, поэтому
+     * подходит и для безматричного J v ≈ (F(x + εv) - F(x)) / ε. Правое
+     * предобуславливание M: решается A M^{-1} u = b, x = M^{-1} u, так что
+     * оценка невязки — это невязка исходной системы. precondition(v) заменяет
+     * v на M^{-1} v.
+     *
+     * @code
+     * miv::math::gmres_solver<double> gmres;
+     * auto report = gmres.solve(n, [&](const double *v, double *out) { ... }, b, x, {});
+     * @endcode
+     *
+     * Базис Крылова — (m + 1) x n, то есть O(n m) памяти вместо O(n^2) у
+     * плотного Якобиана. Буферы живут в объекте и переиспользуются.
+     */
+    template <FloatNumber T>
+    class gmres_solver
+    {
+    public:
+        using value_t = T;
+
+        /**
+         * @brief Решить A x = b; x на входе — начальное приближение, на выходе — решение.
+         */
+        template <typename Apply, typename Precondition>
+        gmres_report solve(
+            std::size_t n,
+            Apply &&apply,
+            Precondition &&precondition,
+            const T *b,
+            T *x,
+            const gmres_options &options)
+        {
+            const std::size_t m = std::max<std::size_t>(options.restart, 1);
+            reserve(n, m);
+
+            gmres_report report;
+
+            const norm_t b_norm = std::sqrt(simd::dot(n, b, b));
+            if (b_norm == 0)
+            {
+                std::fill(x, x + n, T{});
+                report.converged = true;
+                return report;
+            }
+
+            const norm_t target = options.tolerance * b_norm;
+
+            while (true)
+            {
+                // r = b - A x
+                apply(static_cast<const T *>(x), m_w.data());
+                T *v0 = m_V.data();
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    v0[i] = b[i] - m_w[i];
+                }
+
+                const norm_t beta = std::sqrt(simd::dot(n, v0, v0));
+                report.residual = beta / b_norm;
+
+                if (beta <= target)
+                {
+                    report.converged = true;
+                    break;
+                }
+
+                if (report.iterations >= options.max_iterations)
+                {
+                    break;
+                }
+
+                const T inv_beta = static_cast<T>(1 / beta);
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    v0[i] *= inv_beta;
+                }
+
+                std::fill(m_g.begin(), m_g.end(), T{});
+                m_g[0] = static_cast<T>(beta);
+
+                const std::size_t cols = arnoldi(n, m, apply, precondition, target, options.max_iterations, report);
+                if (cols == 0)
+                {
+                    break;
+                }
+
+                update_solution(n, cols, precondition, x);
+
+                report.residual = static_cast<norm_t>(std::abs(m_g[cols])) / b_norm;
+                if (static_cast<norm_t>(std::abs(m_g[cols])) <= target)
+                {
+                    report.converged = true;
+                    break;
+                }
+            }
+
+            return report;
+        }
+
+        /**
+         * @brief Решить A x = b без предобуславливания.
+         */
+        template <typename Apply>
+        gmres_report solve(std::size_t n, Apply &&apply, const T *b, T *x, const gmres_options &options)
+        {
+            return solve(n, std::forward<Apply>(apply), [](T *) {}, b, x, options);
+        }
+
+    private:
+        void reserve(std::size_t n, std::size_t m)
+        {
+            if (m_V.rows() != m + 1 || m_V.cols() != n)
+            {
+                m_V = miv::matrix<T>(m + 1, n, miv::uninitialized);
+                m_H = miv::matrix<T>(m + 1, m, miv::uninitialized);
+                m_cs.resize(m, miv::uninitialized);
+                m_sn.resize(m, miv::uninitialized);
+                m_g.resize(m + 1, miv::uninitialized);
+                m_y.resize(m, miv::uninitialized);
+            }
+
+            if (m_w.size() != n)
+            {
+                m_w.resize(n, miv::uninitialized);
+                m_z.resize(n, miv::uninitialized);
+            }
+        }
+
+        /**
+         * @brief Не более m шагов Арнольди (модифицированный Грам–Шмидт) с вращениями Гивенса.
+         *
+         * @return число построенных столбцов H (0 — вырождение на первом шаге)
+         */
+        template <typename Apply, typename Precondition>
+        std::size_t arnoldi(
+            std::size_t n,
+            std::size_t m,
+            Apply &apply,
+            Precondition &precondition,
+            norm_t target,
+            std::size_t max_iterations,
+            gmres_report &report)
+        {
+            std::size_t cols = 0;
+
+            for (std::size_t j = 0; j < m && report.iterations < max_iterations; ++j)
+            {
+                // w = A M^{-1} v_j
+                const T *vj = m_V.data() + j * n;
+                std::copy(vj, vj + n, m_z.data());
+                precondition(m_z.data());
+                apply(static_cast<const T *>(m_z.data()), m_w.data());
+
+                for (std::size_t i = 0; i <= j; ++i)
+                {
+                    const T *vi = m_V.data() + i * n;
+                    const T h = static_cast<T>(simd::dot(n, m_w.data(), vi));
+                    m_H(i, j) = h;
+                    for (std::size_t e = 0; e < n; ++e)
+                    {
+                        m_w[e] -= h * vi[e];
+                    }
+                }
+
+                const T h_next = static_cast<T>(std::sqrt(simd::dot(n, m_w.data(), m_w.data())));
+                m_H(j + 1, j) = h_next;
+
+                // Предыдущие вращения к новому столбцу
+                for (std::size_t i = 0; i < j; ++i)
+                {
+                    const T a = m_H(i, j);
+                    const T c = m_H(i + 1, j);
+                    m_H(i, j) = m_cs[i] * a + m_sn[i] * c;
+                    m_H(i + 1, j) = -m_sn[i] * a + m_cs[i] * c;
+                }
+
+                const T diag = m_H(j, j);
+                const T r = std::sqrt(diag * diag + h_next * h_next);
+                if (r == T{})
+                {
+                    break;
+                }
+
+                m_cs[j] = diag / r;
+                m_sn[j] = h_next / r;
+                m_H(j, j) = r;
+                m_H(j + 1, j) = T{};
+                m_g[j + 1] = -m_sn[j] * m_g[j];
+                m_g[j] = m_cs[j] * m_g[j];
+
+                ++report.iterations;
+                cols = j + 1;
+
+                // Счастливое вырождение: подпространство Крылова инвариантно, решение точное
+                if (h_next == T{} || static_cast<norm_t>(std::abs(m_g[j + 1])) <= target)
+                {
+                    break;
+                }
+
+                const T inv = static_cast<T>(1) / h_next;
+                T *next = m_V.data() + (j + 1) * n;
+                for (std::size_t e = 0; e < n; ++e)
+                {
+                    next[e] = m_w[e] * inv;
+                }
+            }
+
+            return cols;
+        }
+
+        /**
+         * @brief x += M^{-1} V y, где H y = g (верхнетреугольная cols x cols).
+         */
+        template <typename Precondition>
+        void update_solution(std::size_t n, std::size_t cols, Precondition &precondition, T *x)
+        {
+            for (std::size_t i = cols; i > 0; --i)
+            {
+                const std::size_t row = i - 1;
+                T sum = m_g[row];
+                for (std::size_t c = row + 1; c < cols; ++c)
+                {
+                    sum -= m_H(row, c) * m_y[c];
+                }
+                m_y[row] = sum / m_H(row, row);
+            }
+
+            std::fill(m_z.begin(), m_z.end(), T{});
+            for (std::size_t j = 0; j < cols; ++j)
+            {
+                const T *vj = m_V.data() + j * n;
+                const T yj = m_y[j];
+                for (std::size_t e = 0; e < n; ++e)
+                {
+                    m_z[e] += yj * vj[e];
+                }
+            }
+
+            precondition(m_z.data());
+            for (std::size_t e = 0; e < n; ++e)
+            {
+                x[e] += m_z[e];
+            }
+        }
+
+        miv::matrix<T> m_V;     // базис Крылова, строки v_0..v_m
+        miv::matrix<T> m_H;     // Хессенберг после вращений (верхнетреугольная часть)
+        miv::array<T> m_cs;     // вращения Гивенса
+        miv::array<T> m_sn;
+        miv::array<T> m_g;      // правая часть наименьших квадратов
+        miv::array<T> m_y;
+        miv::array<T> m_w;      // A M^{-1} v_j
+        miv::array<T> m_z;      // M^{-1} v_j / поправка
+    };
+}
+
+#endif // MIV_MATH_GMRES_H
@@ -6,9 +6,11 @@
 #include <type_traits>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "containers/array.hpp"
 #include "containers/matrix.hpp"
+#include "exec/thread_pool.hpp"
 
 namespace miv::math
 {
@@ -166,6 +168,18 @@ namespace miv::math
         }
     }
 
+    /**
+     * @brief Пройти диапазон индексов [0, size) кусками f(lo, hi).
+     *
+     * Для поэлементных ядер: при size >= miv::exec::serial_threshold() куски
+     * выполняются параллельно на общем пуле, иначе — один вызов f(0, size).
+     */
+    template <typename F>
+    inline void for_each_chunk(std::size_t size, F &&f)
+    {
+        miv::exec::parallel_for(0, size, size, std::forward<F>(f));
+    }
+
 } // namespace miv::math
 
 #endif // MIV_MATH_HELPERS_H
@@ -0,0 +1,263 @@
+#ifndef MIV_MATH_JACOBIAN_H
+#define MIV_MATH_JACOBIAN_H
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "containers/array.hpp"
+#include "containers/matrix.hpp"
+#include "containers/profile.hpp"
+#include "exec/thread_pool.hpp"
+#include "math/helpers.hpp"   // FloatNumber
+#include "math/system.hpp"    // system_size, evaluate_system
+
+namespace miv::math
+{
+    /**
+     * @brief Переиспользуемый построитель численного Якобиана системы F(x) = 0.
+     *
+     * Система — вектор вызываемых объектов fi(miv::array<T>&) -> T
+     * (например, NonlinearFunction<T> из functions.hpp) или vector_system —
+     * одна f(x, out) на все компоненты (math/system.hpp).
+     *
+     * Особенности:
+     *  - координата x[j] возмущается на месте и сразу восстанавливается, копий x на столбец нет;
+     *  - значения F пишутся в заранее выделенные буферы, которые живут в построителе
+     *    между вызовами — после первого построения новых выделений памяти нет;
+     *  - независимые столбцы считаются параллельно на общем пуле miv::exec,
+     *    каждый поток работает со своей копией x (копия создаётся один раз за построение).
+     *
+     * Функции системы должны быть потокобезопасны (не иметь разделяемого изменяемого состояния).
+     */
+    template <FloatNumber T>
+    class jacobian_builder
+    {
+    public:
+        using value_t = T;
+
+        jacobian_builder() = default;
+
+        /**
+         * @brief Двухузловая (односторонняя) формула: J(:, j) = (F(x + h e_j) - F(x)) / h.
+         *
+         * F(x) вычисляется внутри (n вызовов каждой функции + 1).
+         */
+        template <typename System>
+        void build_two_point(miv::array<T> &x, const System &functions, miv::matrix<T> &J)
+        {
+            MIV_PROFILE_SCOPE(jacobian);
+
+            prepare(x, functions, J);
+
+            evaluate_system(functions, x, m_fx.data());
+            fill_two_point(x, functions, m_fx.data(), J);
+        }
+
+        /**
+         * @brief Двухузловая формула с уже известным F(x) (столбец n x 1 или строка 1 x n).
+         *
+         * Экономит одно вычисление F, когда F(x) уже посчитан на текущей итерации.
+         */
+        template <typename System>
+        void build_two_point(
+            miv::array<T> &x,
+            const System &functions,
+            const miv::matrix<T> &fx,
+            miv::matrix<T> &J)
+        {
+            MIV_PROFILE_SCOPE(jacobian);
+
+            prepare(x, functions, J);
+
+            if (fx.size() != system_size(functions))
+            {
+                throw std::invalid_argument(
+                    "jacobian_builder::build_two_point(): F(x) must have " + std::to_string(system_size(functions)) +
+                    " elements, but got " + std::to_string(fx.size()));
+            }
+
+            fill_two_point(x, functions, fx.data(), J);
+        }
+
+        /**
+         * @brief Трёхузловая (центральная) формула: J(:, j) = (F(x + h e_j) - F(x - h e_j)) / 2h.
+         */
+        template <typename System>
+        void build_three_point(miv::array<T> &x, const System &functions, miv::matrix<T> &J)
+        {
+            MIV_PROFILE_SCOPE(jacobian);
+
+            prepare(x, functions, J);
+
+            const std::size_t n = system_size(functions);
+            T *jac = J.data();
+
+            for_each_slot(x, [&](miv::array<T> &xs, T *f_plus, T *f_minus, std::size_t j0, std::size_t j1)
+            {
+                for (std::size_t j = j0; j < j1; ++j)
+                {
+                    const T xj = xs[j];
+                    const T h = step(xj);
+
+                    xs[j] = xj + h;
+                    evaluate_system(functions, xs, f_plus);
+
+                    xs[j] = xj - h;
+                    evaluate_system(functions, xs, f_minus);
+
+                    xs[j] = xj;
+
+                    const T inv = static_cast<T>(1) / (static_cast<T>(2) * h);
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        jac[i * n + j] = (f_plus[i] - f_minus[i]) * inv;
+                    }
+                }
+            });
+        }
+
+    private:
+        /**
+         * @brief Рабочие буферы одного параллельного слота.
+         */
+        struct slot_buffers
+        {
+            miv::array<T> x;
+            miv::array<T> f_plus;
+            miv::array<T> f_minus;
+        };
+
+        /**
+         * @brief Шаг дифференцирования: sqrt(eps) * (1 + |x_j|).
+         */
+        static T step(T xj)
+        {
+            const T eps = std::numeric_limits<T>::epsilon();
+            return std::sqrt(eps) * (static_cast<T>(1) + std::abs(xj));
+        }
+
+
+        template <typename System>
+        void prepare(const miv::array<T> &x, const System &functions, miv::matrix<T> &J)
+        {
+            const std::size_t n = system_size(functions);
+
+            if (x.size() != n)
+            {
+                throw std::invalid_argument(
+                    "jacobian_builder: x must have length n = " + std::to_string(n) +
+                    ", but got " + std::to_string(x.size()));
+            }
+
+            if (J.rows() != n || J.cols() != n)
+            {
+                J = miv::matrix<T>(n, n, miv::uninitialized);
+            }
+
+            if (m_fx.size() != n)
+            {
+                m_fx.resize(n);
+            }
+        }
+
+        template <typename System>
+        void fill_two_point(miv::array<T> &x, const System &functions, const T *fx, miv::matrix<T> &J)
+        {
+            const std::size_t n = system_size(functions);
+            T *jac = J.data();
+
+            for_each_slot(x, [&](miv::array<T> &xs, T *f_plus, T *, std::size_t j0, std::size_t j1)
+            {
+                for (std::size_t j = j0; j < j1; ++j)
+                {
+                    const T xj = xs[j];
+                    const T h = step(xj);
+
+                    xs[j] = xj + h;
+                    evaluate_system(functions, xs, f_plus);
+                    xs[j] = xj;
+
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        jac[i * n + j] = (f_plus[i] - fx[i]) / h;
+                    }
+                }
+            });
+        }
+
+        /**
+         * @brief Разбить столбцы 0..n-1 на слоты и вызвать body(x_slot, f_plus, f_minus, j0, j1).
+         *
+         * Один слот — работаем прямо с x вызывающего (возмущение на месте).
+         * Несколько слотов — каждый получает свою копию x, буферы переиспользуются.
+         */
+        template <typename Body>
+        void for_each_slot(miv::array<T> &x, Body &&body)
+        {
+            const std::size_t n = x.size();
+
+            if (n == 0)
+            {
+                return;
+            }
+
+            // Одна "единица работы" — вычисление одной компоненты F
+            const std::size_t work = n * n;
+            const std::size_t threads = (work < miv::exec::serial_threshold()) ? 1 : miv::exec::thread_count();
+            const std::size_t slots = std::min(n, threads);
+
+            if (m_slots.size() < slots)
+            {
+                m_slots.resize(slots);
+            }
+
+            for (std::size_t s = 0; s < slots; ++s)
+            {
+                auto &buf = m_slots[s];
+                if (buf.f_plus.size() != n)
+                {
+                    buf.f_plus.resize(n);
+                    buf.f_minus.resize(n);
+                }
+            }
+
+            if (slots == 1)
+            {
+                body(x, m_slots[0].f_plus.data(), m_slots[0].f_minus.data(), 0, n);
+                return;
+            }
+
+            for (std::size_t s = 0; s < slots; ++s)
+            {
+                auto &buf = m_slots[s];
+                if (buf.x.size() != n)
+                {
+                    buf.x.resize(n);
+                }
+                std::copy(x.begin(), x.end(), buf.x.begin());
+            }
+
+            // Вычисления F в потоках пула — в профиль вызывающего
+            MIV_PROFILE_CAPTURE(profile);
+            miv::exec::default_pool().parallel_for(0, slots, 1, [&](std::size_t lo, std::size_t hi)
+            {
+                MIV_PROFILE_RECORD_INTO(profile);
+                for (std::size_t s = lo; s < hi; ++s)
+                {
+                    auto &buf = m_slots[s];
+                    body(buf.x, buf.f_plus.data(), buf.f_minus.data(), (n * s) / slots, (n * (s + 1)) / slots);
+                }
+            });
+        }
+
+        miv::array<T> m_fx;
+        std::vector<slot_buffers> m_slots;
+    };
+}
+
+#endif // MIV_MATH_JACOBIAN_H
@@ -11,7 +11,10 @@
 #include <string>
 
 #include "containers/matrix.hpp"
+#include "containers/matrix_view.hpp"
 #include "math/helpers.hpp"
+#include "math/gemm.hpp"
+#include "math/simd.hpp"
 
 namespace miv::math
 {
@@ -22,6 +25,8 @@ namespace miv::math
     /**
      * @brief Сложение матриц одинакового размера: C = A + B
      *
+     * Большие матрицы обрабатываются параллельно (см. for_each_chunk).
+     *
      * @param a Левая матрица
      * @param b Правая матрица
      * @return Новая матрица (результат)
@@ -32,12 +37,16 @@ namespace miv::math
     {
         require_same_shape(a, b, "add(): matrices must have the same shape");
 
-        miv::matrix<T> out(a.rows(), a.cols());
+        miv::matrix<T> out(a.rows(), a.cols(), miv::uninitialized);
 
-        for (std::size_t i = 0; i < a.size(); ++i)
+        const T *pa = a.data();
+        const T *pb = b.data();
+        T *po = out.data();
+
+        for_each_chunk(a.size(), [=](std::size_t lo, std::size_t hi)
         {
-            out.data()[i] = a.data()[i] + b.data()[i];
-        }
+            simd::add(hi - lo, pa + lo, pb + lo, po + lo);
+        });
 
         return out;
     }
@@ -52,12 +61,16 @@ namespace miv::math
     {
         require_same_shape(a, b, "sub(): matrices must have the same shape");
 
-        miv::matrix<T> out(a.rows(), a.cols());
+        miv::matrix<T> out(a.rows(), a.cols(), miv::uninitialized);
 
-        for (std::size_t i = 0; i < a.size(); ++i)
+        const T *pa = a.data();
+        const T *pb = b.data();
+        T *po = out.data();
+
+        for_each_chunk(a.size(), [=](std::size_t lo, std::size_t hi)
         {
-            out.data()[i] = a.data()[i] - b.data()[i];
-        }
+            simd::sub(hi - lo, pa + lo, pb + lo, po + lo);
+        });
 
         return out;
     }
@@ -68,12 +81,9 @@ namespace miv::math
     template <Number T>
     inline miv::matrix<T> negate(const miv::matrix<T> &a)
     {
-        miv::matrix<T> out(a.rows(), a.cols());
+        miv::matrix<T> out(a.rows(), a.cols(), miv::uninitialized);
 
-        for (std::size_t i = 0; i < a.size(); ++i)
-        {
-            out.data()[i] = -a.data()[i];
-        }
+        simd::negate(a.size(), a.data(), out.data());
 
         return out;
     }
@@ -88,12 +98,9 @@ namespace miv::math
     template <Number T>
     inline miv::matrix<T> mul_scalar(const miv::matrix<T> &a, T k)
     {
-        miv::matrix<T> out(a.rows(), a.cols());
+        miv::matrix<T> out(a.rows(), a.cols(), miv::uninitialized);
 
-        for (std::size_t i = 0; i < a.size(); ++i)
-        {
-            out.data()[i] = a.data()[i] * k;
-        }
+        simd::scale(a.size(), a.data(), k, out.data());
 
         return out;
     }
@@ -114,7 +121,7 @@ namespace miv::math
             throw std::invalid_argument("div_scalar(): division by zero");
         }
 
-        miv::matrix<T> out(a.rows(), a.cols());
+        miv::matrix<T> out(a.rows(), a.cols(), miv::uninitialized);
 
         for (std::size_t i = 0; i < a.size(); ++i)
         {
@@ -129,43 +136,123 @@ namespace miv::math
     // ============================================================
 
     /**
-     * @brief Матричное произведение: C = A * B
+     * @brief Матричное произведение в готовую матрицу: C = A * B
+     *
+     * Если форма out уже (m x k), её буфер переиспользуется — повторные
+     * произведения в цикле не выделяют память.
      *
      * Требование совместимости:
      * - A: (m x n)
      * - B: (n x k)
-     * - C: (m x k)
+     * - out: любая, на выходе (m x k); не может быть самой A или B
      *
-     * @throws std::invalid_argument если A.cols != B.rows
+     * @param kernel naive — эталонный тройной цикл, blocked — блочное GEMM (см. gemm.hpp),
+     *               automatic — blocked начиная с некоторого размера
+     * @throws std::invalid_argument если A.cols != B.rows или out совпадает с A или B
      */
     template <Number T>
-    inline miv::matrix<T> matmul(const miv::matrix<T> &a, const miv::matrix<T> &b)
+    inline void matmul_into(
+        const miv::matrix<T> &a,
+        const miv::matrix<T> &b,
+        miv::matrix<T> &out,
+        matmul_kernel kernel = matmul_kernel::automatic)
     {
         require_mmul_compatible(a, b);
 
+        if (&out == &a || &out == &b)
+        {
+            throw std::invalid_argument("matmul_into(): out must not alias an operand");
+        }
+
         const std::size_t m = a.rows();
         const std::size_t n = a.cols();
         const std::size_t k = b.cols();
 
-        miv::matrix<T> out(m, k);
-        out.fill(T{});
+        if (out.rows() != m || out.cols() != k)
+        {
+            out = miv::matrix<T>(m, k, T{});
+        }
+        else
+        {
+            out.fill(T{});
+        }
+
+        if (kernel == matmul_kernel::automatic)
+        {
+            // На маленьких матрицах упаковка панелей дороже самого умножения
+            constexpr std::size_t blocked_threshold = 32;
+            kernel = (m >= blocked_threshold && n >= blocked_threshold && k >= blocked_threshold)
+                ? matmul_kernel::blocked
+                : matmul_kernel::naive;
+        }
+
+        if (m == 0 || n == 0 || k == 0)
+        {
+            return;
+        }
+
+        if (kernel == matmul_kernel::blocked)
+        {
+            gemm(m, k, n, static_cast<T>(1), a.data(), n, b.data(), k, T{}, out.data(), k);
+            return;
+        }
+
+        // Классический O(m*n*k), строки берутся через views без поэлементных проверок
+        const miv::matrix_view<const T> a_view(a);
+        const miv::matrix_view<const T> b_view(b);
+        const miv::matrix_view<T> out_view(out);
 
-        // Классический O(m*n*k)
         for (std::size_t i = 0; i < m; ++i)
         {
+            const T *a_row = a_view.row_ptr(i);
+            T *out_row = out_view.row_ptr(i);
+
             for (std::size_t t = 0; t < n; ++t)
             {
-                const T av = a(i, t);
+                const T av = a_row[t];
+                const T *b_row = b_view.row_ptr(t);
+
                 for (std::size_t j = 0; j < k; ++j)
                 {
-                    out(i, j) += av * b(t, j);
+                    out_row[j] += av * b_row[j];
                 }
             }
         }
+    }
 
+    /**
+     * @brief Матричное произведение с явным выбором ядра: C = A * B
+     *
+     * Требование совместимости:
+     * - A: (m x n)
+     * - B: (n x k)
+     * - C: (m x k)
+     *
+     * @param kernel naive — эталонный тройной цикл, blocked — блочное GEMM (см. gemm.hpp),
+     *               automatic — blocked начиная с некоторого размера
+     * @throws std::invalid_argument если A.cols != B.rows
+     */
+    template <Number T>
+    inline miv::matrix<T> matmul(const miv::matrix<T> &a, const miv::matrix<T> &b, matmul_kernel kernel)
+    {
+        miv::matrix<T> out;
+        matmul_into(a, b, out, kernel);
         return out;
     }
 
+    /**
+     * @brief Матричное произведение: C = A * B
+     *
+     * Ядро выбирается автоматически (matmul_kernel::automatic).
+     *
+     * @throws std::invalid_argument если A.cols != B.rows
+     */
+    template <Number T>
+    inline miv::matrix<T> matmul(const miv::matrix<T> &a, const miv::matrix<T> &b)
+    {
+        return matmul(a, b, matmul_kernel::automatic);
+    }
+
     /**
      * @brief Произведение Адамара (Hadamard): C = A ⊙ B (поэлементное умножение)
      *
@@ -176,12 +263,16 @@ namespace miv::math
     {
         require_same_shape(a, b, "hadamard(): matrices must have the same shape");
 
-        miv::matrix<T> out(a.rows(), a.cols());
+        miv::matrix<T> out(a.rows(), a.cols(), miv::uninitialized);
 
-        for (std::size_t i = 0; i < a.size(); ++i)
+        const T *pa = a.data();
+        const T *pb = b.data();
+        T *po = out.data();
+
+        for_each_chunk(a.size(), [=](std::size_t lo, std::size_t hi)
         {
-            out.data()[i] = a.data()[i] * b.data()[i];
-        }
+            simd::mul(hi - lo, pa + lo, pb + lo, po + lo);
+        });
 
         return out;
     }
@@ -213,14 +304,8 @@ namespace miv::math
             throw std::invalid_argument("dot(): vectors must have the same length");
         }
 
-        norm_t acc = 0;
-
-        for (std::size_t i = 0; i < na; ++i)
-        {
-            acc += static_cast<norm_t>(vector_at(a, i)) * static_cast<norm_t>(vector_at(b, i));
-        }
-
-        return acc;
+        // И строка 1 x N, и столбец N x 1 лежат в памяти подряд
+        return simd::dot(na, a.data(), b.data());
     }
 
     // ============================================================
@@ -228,26 +313,199 @@ namespace miv::math
     // ============================================================
 
     /**
-     * @brief Транспонирование матрицы: B = A^T
+     * @brief Сторона блока транспонирования (в элементах) и его микроблока.
      *
-     * (rows x cols) -> (cols x rows)
+     * Блок 64 x 64 — единица работы потока, внутри он обходится микроблоками
+     * 8 x 8: восемь строк приёмника одновременно в работе, поэтому даже при
+     * шаге строк, кратном размеру страницы (n = 4096), они не вытесняют друг
+     * друга из одного набора кэша.
+     */
+    inline constexpr std::size_t transpose_block_size = 64;
+    inline constexpr std::size_t transpose_micro_size = 8;
+
+    namespace detail
+    {
+        /**
+         * @brief dst(c, r) = src(r, c) для блока строк [r0, r1) и столбцов [c0, c1),
+         * микроблоками transpose_micro_size.
+         */
+        template <typename T>
+        inline void transpose_block(
+            const T *src, std::size_t src_stride,
+            T *dst, std::size_t dst_stride,
+            std::size_t r0, std::size_t r1, std::size_t c0, std::size_t c1)
+        {
+            constexpr std::size_t ms = transpose_micro_size;
+
+            for (std::size_t rm = r0; rm < r1; rm += ms)
+            {
+                const std::size_t rm1 = std::min(rm + ms, r1);
+
+                for (std::size_t cm = c0; cm < c1; cm += ms)
+                {
+                    const std::size_t cm1 = std::min(cm + ms, c1);
+
+                    for (std::size_t r = rm; r < rm1; ++r)
+                    {
+                        const T *s = src + r * src_stride;
+                        for (std::size_t c = cm; c < cm1; ++c)
+                        {
+                            dst[c * dst_stride + r] = s[c];
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Обменять блок [r0, r1) x [c0, c1) квадратной матрицы с симметричным
+         * (транспонируя оба), микроблоками; блоки не пересекаются с диагональю.
+         */
+        template <typename T>
+        inline void swap_transpose_block(
+            T *m, std::size_t n,
+            std::size_t r0, std::size_t r1, std::size_t c0, std::size_t c1)
+        {
+            constexpr std::size_t ms = transpose_micro_size;
+
+            for (std::size_t rm = r0; rm < r1; rm += ms)
+            {
+                const std::size_t rm1 = std::min(rm + ms, r1);
+
+                for (std::size_t cm = c0; cm < c1; cm += ms)
+                {
+                    const std::size_t cm1 = std::min(cm + ms, c1);
+
+                    for (std::size_t r = rm; r < rm1; ++r)
+                    {
+                        for (std::size_t c = cm; c < cm1; ++c)
+                        {
+                            std::swap(m[r * n + c], m[c * n + r]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Транспонирование по блокам: dst = src^T.
+     *
+     * Обход блоками transpose_block_size x transpose_block_size (внутри — микроблоки
+     * transpose_micro_size): и чтение, и запись идут внутри пары блоков в кэше. Большие матрицы
+     * обрабатываются параллельно полосами блоков.
+     *
+     * @throws std::invalid_argument если dst не (src.cols() x src.rows())
      */
     template <Number T>
-    inline miv::matrix<T> transpose(const miv::matrix<T> &a)
+    inline void transpose_into(const miv::matrix_view<const T> &src, const miv::matrix_view<T> &dst)
     {
-        miv::matrix<T> out(a.cols(), a.rows());
+        const std::size_t rows = src.rows();
+        const std::size_t cols = src.cols();
+
+        if (dst.rows() != cols || dst.cols() != rows)
+        {
+            throw std::invalid_argument("transpose_into(): destination must be cols x rows of the source");
+        }
+
+        constexpr std::size_t bs = transpose_block_size;
+        const std::size_t row_blocks = (rows + bs - 1) / bs;
 
-        for (std::size_t r = 0; r < a.rows(); ++r)
+        const T *s = src.data();
+        T *d = dst.data();
+        const std::size_t s_stride = src.stride();
+        const std::size_t d_stride = dst.stride();
+
+        miv::exec::parallel_for(0, row_blocks, rows * cols, [&](std::size_t lo, std::size_t hi)
         {
-            for (std::size_t c = 0; c < a.cols(); ++c)
+            for (std::size_t rb = lo; rb < hi; ++rb)
             {
-                out(c, r) = a(r, c);
+                const std::size_t r0 = rb * bs;
+                const std::size_t r1 = std::min(r0 + bs, rows);
+
+                for (std::size_t c0 = 0; c0 < cols; c0 += bs)
+                {
+                    detail::transpose_block(s, s_stride, d, d_stride, r0, r1, c0, std::min(c0 + bs, cols));
+                }
             }
+        });
+    }
+
+    /**
+     * @brief out = a^T; буфер out переиспользуется, если форма уже подходит.
+     */
+    template <Number T>
+    inline void transpose_into(const miv::matrix<T> &a, miv::matrix<T> &out)
+    {
+        if (&a == &out)
+        {
+            throw std::invalid_argument("transpose_into(): source and destination must differ (use transpose_inplace)");
+        }
+
+        if (out.rows() != a.cols() || out.cols() != a.rows())
+        {
+            out = miv::matrix<T>(a.cols(), a.rows(), miv::uninitialized);
         }
 
+        transpose_into(miv::matrix_view<const T>(a), miv::matrix_view<T>(out));
+    }
+
+    /**
+     * @brief Транспонирование матрицы: B = A^T
+     *
+     * (rows x cols) -> (cols x rows), по блокам (см. transpose_into).
+     */
+    template <Number T>
+    inline miv::matrix<T> transpose(const miv::matrix<T> &a)
+    {
+        miv::matrix<T> out(a.cols(), a.rows(), miv::uninitialized);
+        transpose_into(miv::matrix_view<const T>(a), miv::matrix_view<T>(out));
         return out;
     }
 
+    /**
+     * @brief Транспонирование квадратной матрицы на месте, без выделения памяти.
+     *
+     * Блоки над диагональю меняются местами с симметричными блоками под ней,
+     * диагональные блоки транспонируются внутри себя.
+     *
+     * @throws std::invalid_argument если матрица не квадратная
+     */
+    template <Number T>
+    inline void transpose_inplace(miv::matrix<T> &a)
+    {
+        require_squareness(a);
+
+        const std::size_t n = a.rows();
+        constexpr std::size_t bs = transpose_block_size;
+        const std::size_t blocks = (n + bs - 1) / bs;
+        T *m = a.data();
+
+        // Полоса блоков rb трогает только пары (rb, cb) и (cb, rb) с cb >= rb:
+        // полосы не пересекаются и идут параллельно
+        miv::exec::parallel_for(0, blocks, n * n / 2, [&](std::size_t lo, std::size_t hi)
+        {
+            for (std::size_t rb = lo; rb < hi; ++rb)
+            {
+                const std::size_t r0 = rb * bs;
+                const std::size_t r1 = std::min(r0 + bs, n);
+
+                for (std::size_t r = r0; r < r1; ++r)
+                {
+                    for (std::size_t c = r + 1; c < r1; ++c)
+                    {
+                        std::swap(m[r * n + c], m[c * n + r]);
+                    }
+                }
+
+                for (std::size_t c0 = r1; c0 < n; c0 += bs)
+                {
+                    detail::swap_transpose_block(m, n, r0, r1, c0, std::min(c0 + bs, n));
+                }
+            }
+        });
+    }
+
     // ============================================================
     //                 Min/Max (elements + element-wise)
     // ============================================================
@@ -294,12 +552,9 @@ namespace miv::math
     {
         require_same_shape(a, b, "elementwise_min(): matrices must have the same shape");
 
-        miv::matrix<T> out(a.rows(), a.cols());
+        miv::matrix<T> out(a.rows(), a.cols(), miv::uninitialized);
 
-        for (std::size_t i = 0; i < a.size(); ++i)
-        {
-            out.data()[i] = std::min(a.data()[i], b.data()[i]);
-        }
+        simd::min(a.size(), a.data(), b.data(), out.data());
 
         return out;
     }
@@ -314,12 +569,9 @@ namespace miv::math
     {
         require_same_shape(a, b, "elementwise_max(): matrices must have the same shape");
 
-        miv::matrix<T> out(a.rows(), a.cols());
+        miv::matrix<T> out(a.rows(), a.cols(), miv::uninitialized);
 
-        for (std::size_t i = 0; i < a.size(); ++i)
-        {
-            out.data()[i] = std::max(a.data()[i], b.data()[i]);
-        }
+        simd::max(a.size(), a.data(), b.data(), out.data());
 
         return out;
     }
@@ -327,6 +579,9 @@ namespace miv::math
     // ============================================================
     //                             Norms
     // ============================================================
+    //
+    // Для float/double редукции векторизованы (simd.hpp): накопление в T
+    // с компенсацией Кэхэна, результат по-прежнему norm_t.
 
     /**
      * @brief L1-норма матрицы/вектора: sum(|x_i|)
@@ -336,14 +591,7 @@ namespace miv::math
     template <Number T>
     inline norm_t norm_l1(const miv::matrix<T> &a)
     {
-        norm_t acc = 0;
-
-        for (std::size_t i = 0; i < a.size(); ++i)
-        {
-            acc += std::abs(static_cast<norm_t>(a.data()[i]));
-        }
-
-        return acc;
+        return simd::sum_abs(a.size(), a.data());
     }
 
     /**
@@ -355,15 +603,7 @@ namespace miv::math
     template <Number T>
     inline norm_t norm_l2(const miv::matrix<T> &a)
     {
-        norm_t acc = 0;
-
-        for (std::size_t i = 0; i < a.size(); ++i)
-        {
-            const norm_t v = static_cast<norm_t>(a.data()[i]);
-            acc += v * v;
-        }
-
-        return std::sqrt(acc);
+        return simd::norm_l2(a.size(), a.data());
     }
 
     /**
@@ -372,14 +612,28 @@ namespace miv::math
     template <Number T>
     inline norm_t norm_linf(const miv::matrix<T> &a)
     {
-        norm_t best = 0;
+        return simd::max_abs(a.size(), a.data());
+    }
 
-        for (std::size_t i = 0; i < a.size(); ++i)
-        {
-            best = std::max(best, std::abs(static_cast<norm_t>(a.data()[i])));
-        }
+    /**
+     * @brief Нормы вектора-массива (любой аллокатор): без копии в матрицу-столбец.
+     */
+    template <Number T, typename Alloc>
+    inline norm_t norm_l1(const miv::array<T, Alloc> &x)
+    {
+        return simd::sum_abs(x.size(), x.data());
+    }
+
+    template <Number T, typename Alloc>
+    inline norm_t norm_l2(const miv::array<T, Alloc> &x)
+    {
+        return simd::norm_l2(x.size(), x.data());
+    }
 
-        return best;
+    template <Number T, typename Alloc>
+    inline norm_t norm_linf(const miv::array<T, Alloc> &x)
+    {
+        return simd::max_abs(x.size(), x.data());
     }
 
     // ============================================================
@@ -417,7 +671,7 @@ namespace miv::math
 
         if constexpr (std::is_floating_point_v<T>)
         {
-            miv::matrix<T> out(v.rows(), v.cols());
+            miv::matrix<T> out(v.rows(), v.cols(), miv::uninitialized);
 
             for (std::size_t i = 0; i < v.size(); ++i)
             {
@@ -428,7 +682,7 @@ namespace miv::math
         }
         else
         {
-            miv::matrix<norm_t> out(v.rows(), v.cols());
+            miv::matrix<norm_t> out(v.rows(), v.cols(), miv::uninitialized);
 
             for (std::size_t i = 0; i < v.size(); ++i)
             {
@@ -456,7 +710,7 @@ namespace miv::math
 
         if constexpr (std::is_floating_point_v<T>)
         {
-            miv::matrix<T> out(v.rows(), v.cols());
+            miv::matrix<T> out(v.rows(), v.cols(), miv::uninitialized);
 
             for (std::size_t i = 0; i < v.size(); ++i)
             {
@@ -467,7 +721,7 @@ namespace miv::math
         }
         else
         {
-            miv::matrix<norm_t> out(v.rows(), v.cols());
+            miv::matrix<norm_t> out(v.rows(), v.cols(), miv::uninitialized);
 
             for (std::size_t i = 0; i < v.size(); ++i)
             {
@@ -488,14 +742,7 @@ namespace miv::math
     template <Number T>
     inline norm_t sum(const miv::matrix<T> &a)
     {
-        norm_t acc = 0;
-
-        for (std::size_t i = 0; i < a.size(); ++i)
-        {
-            acc += static_cast<norm_t>(a.data()[i]);
-        }
-
-        return acc;
+        return simd::sum(a.size(), a.data());
     }
 
     /**
@@ -528,10 +775,11 @@ namespace miv::math
         }
 
         norm_t acc = 0;
+        const miv::matrix_view<const T> v(a);
 
-        for (std::size_t i = 0; i < a.rows(); ++i)
+        for (std::size_t i = 0; i < v.rows(); ++i)
         {
-            acc += static_cast<norm_t>(a(i, i));
+            acc += static_cast<norm_t>(v(i, i));
         }
 
         return acc;
@@ -543,12 +791,13 @@ namespace miv::math
     template <Number T>
     inline miv::matrix<T> identity(std::size_t n)
     {
-        miv::matrix<T> out(n, n);
-        out.fill(T{});
+        miv::matrix<T> out(n, n, T{});
+
+        const miv::matrix_view<T> v(out);
 
         for (std::size_t i = 0; i < n; ++i)
         {
-            out(i, i) = static_cast<T>(1);
+            v(i, i) = static_cast<T>(1);
         }
 
         return out;
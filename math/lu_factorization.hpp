@@ -0,0 +1,1041 @@
+#ifndef MIV_MATH_LU_FACTORIZATION_H
+#define MIV_MATH_LU_FACTORIZATION_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include "containers/array.hpp"
+#include "containers/matrix.hpp"
+#include "containers/matrix_view.hpp"
+#include "containers/profile.hpp"
+#include "math/helpers.hpp"   // FloatNumber, require_squareness, vector_length
+#include "math/linalg.hpp"    // identity
+#include "math/gemm.hpp"      // gemm (обновление хвоста в блочном LU)
+
+namespace miv::math
+{
+    // ============================================================
+    //            Packed in-place LUP kernels (L и U в одном буфере)
+    // ============================================================
+    //
+    // Упакованный формат (как в LAPACK getrf):
+    //  - над диагональю и на диагонали лежит U
+    //  - под диагональю лежат множители L (единичная диагональ L не хранится)
+    //  - pivots[k] — строка, с которой была обменяна строка k на шаге k
+    //
+    // Обмен строк трогает ровно две строки, никаких перестановок всей матрицы.
+
+    /**
+     * @brief LUP-разложение на месте над view: A заменяется на упакованные множители L и U.
+     *
+     * Ядро без выделений памяти: буфер матрицы и pivots (n элементов) даёт вызывающий
+     * (например, из miv::workspace). View может быть подматрицей (stride >= cols).
+     *
+     * @throws std::invalid_argument если матрица не квадратная или вырожденная
+     */
+    template <FloatNumber T>
+    inline void lu_decompose_lup_packed(const miv::matrix_view<T> &a, std::size_t *pivots)
+    {
+        MIV_PROFILE_SCOPE(factorize);
+
+        if (a.rows() != a.cols())
+        {
+            throw std::invalid_argument("lu_decompose_lup_packed(): matrix must be square");
+        }
+
+        const std::size_t n = a.rows();
+        const T eps = static_cast<T>(1e-18);
+
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            // Найдём опорный элемент в столбце k
+            std::size_t pivot = k;
+            T max_val = std::abs(a(k, k));
+
+            for (std::size_t i = k + 1; i < n; ++i)
+            {
+                const T val = std::abs(a(i, k));
+                if (val > max_val)
+                {
+                    max_val = val;
+                    pivot = i;
+                }
+            }
+
+            if (max_val <= eps)
+            {
+                throw std::invalid_argument("lu_decompose_lup_packed(): matrix is singular or near-singular");
+            }
+
+            pivots[k] = pivot;
+
+            if (pivot != k)
+            {
+                // Строки целиком: заодно переставляются и уже вычисленные множители L
+                std::swap_ranges(a.row_ptr(k), a.row_ptr(k) + n, a.row_ptr(pivot));
+            }
+
+            const T *row_k = a.row_ptr(k);
+            const T diag = row_k[k];
+
+            for (std::size_t i = k + 1; i < n; ++i)
+            {
+                T *row_i = a.row_ptr(i);
+                const T m = row_i[k] / diag;
+                row_i[k] = m;
+
+                for (std::size_t j = k + 1; j < n; ++j)
+                {
+                    row_i[j] -= m * row_k[j];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief LUP-разложение на месте: A заменяется на упакованные множители L и U.
+     *
+     * @param LU Квадратная матрица A; на выходе — упакованные множители
+     * @param pivots На выходе — последовательность обменов строк (размер n)
+     * @throws std::invalid_argument если матрица не квадратная или вырожденная
+     */
+    template <FloatNumber T>
+    inline void lu_decompose_lup_packed(miv::matrix<T> &LU, miv::array<std::size_t> &pivots)
+    {
+        require_squareness(LU);
+
+        if (pivots.size() != LU.rows())
+        {
+            pivots.resize(LU.rows());
+        }
+
+        // Внутренние циклы идут через view: без проверок границ в Release
+        lu_decompose_lup_packed(miv::matrix_view<T>(LU), pivots.data());
+    }
+
+    /**
+     * @brief Ширина панели блочного LU по умолчанию.
+     */
+    inline constexpr std::size_t lu_default_block_size = 64;
+
+    /**
+     * @brief Блочное right-looking LUP-разложение на месте (тот же упакованный формат).
+     *
+     * Для каждой панели ширины nb:
+     *  1) панель [k0.., k0..k0+nb) раскладывается без блоков с частичным выбором
+     *     главного элемента (строки меняются целиком);
+     *  2) TRSM: блок строк U12 := L11^{-1} A12;
+     *  3) GEMM: хвост A22 := A22 - L21 * U12 блочным ядром gemm().
+     *
+     * Основная работа (шаг 3) идёт через кэш-дружественное GEMM вместо
+     * n проходов по всему хвосту матрицы. При n <= nb (или nb == 0)
+     * выполняется обычное разложение lu_decompose_lup_packed.
+     *
+     * Вариант над view: буферы даёт вызывающий, pivots — n элементов.
+     *
+     * @throws std::invalid_argument если матрица не квадратная или вырожденная
+     */
+    template <FloatNumber T>
+    inline void lu_decompose_lup_blocked(
+        const miv::matrix_view<T> &LU,
+        std::size_t *pivots,
+        std::size_t block_size = lu_default_block_size)
+    {
+        MIV_PROFILE_SCOPE(factorize);
+
+        if (LU.rows() != LU.cols())
+        {
+            throw std::invalid_argument("lu_decompose_lup_blocked(): matrix must be square");
+        }
+
+        const std::size_t n = LU.rows();
+
+        if (block_size == 0 || n <= block_size)
+        {
+            lu_decompose_lup_packed(LU, pivots);
+            return;
+        }
+
+        const T eps = static_cast<T>(1e-18);
+
+        T *a = LU.data();
+        const std::size_t ld = LU.stride();
+
+        for (std::size_t k0 = 0; k0 < n; k0 += block_size)
+        {
+            const std::size_t kb = std::min(block_size, n - k0);
+            const std::size_t k_end = k0 + kb;
+
+            // 1) Панель: столбцы k0..k_end-1, строки k0..n-1
+            for (std::size_t k = k0; k < k_end; ++k)
+            {
+                std::size_t pivot = k;
+                T max_val = std::abs(a[k * ld + k]);
+
+                for (std::size_t i = k + 1; i < n; ++i)
+                {
+                    const T val = std::abs(a[i * ld + k]);
+                    if (val > max_val)
+                    {
+                        max_val = val;
+                        pivot = i;
+                    }
+                }
+
+                if (max_val <= eps)
+                {
+                    throw std::invalid_argument("lu_decompose_lup_blocked(): matrix is singular or near-singular");
+                }
+
+                pivots[k] = pivot;
+
+                if (pivot != k)
+                {
+                    std::swap_ranges(a + k * ld, a + k * ld + n, a + pivot * ld);
+                }
+
+                const T *row_k = a + k * ld;
+                const T diag = row_k[k];
+
+                for (std::size_t i = k + 1; i < n; ++i)
+                {
+                    T *row_i = a + i * ld;
+                    const T m = row_i[k] / diag;
+                    row_i[k] = m;
+
+                    // Только внутри панели: остальное догонят TRSM + GEMM
+                    for (std::size_t j = k + 1; j < k_end; ++j)
+                    {
+                        row_i[j] -= m * row_k[j];
+                    }
+                }
+            }
+
+            if (k_end == n)
+            {
+                break;
+            }
+
+            const std::size_t rest = n - k_end;
+
+            // 2) TRSM: U12 := L11^{-1} A12 (L11 — единичная нижнетреугольная)
+            for (std::size_t i = k0 + 1; i < k_end; ++i)
+            {
+                T *row_i = a + i * ld + k_end;
+
+                for (std::size_t t = k0; t < i; ++t)
+                {
+                    const T l = a[i * ld + t];
+                    const T *row_t = a + t * ld + k_end;
+
+                    for (std::size_t j = 0; j < rest; ++j)
+                    {
+                        row_i[j] -= l * row_t[j];
+                    }
+                }
+            }
+
+            // 3) GEMM: A22 := A22 - L21 * U12
+            gemm(
+                rest, rest, kb,
+                static_cast<T>(-1),
+                a + k_end * ld + k0, ld,
+                a + k0 * ld + k_end, ld,
+                static_cast<T>(1),
+                a + k_end * ld + k_end, ld);
+        }
+    }
+
+    /**
+     * @brief Блочное LUP-разложение матрицы на месте (см. вариант над view).
+     *
+     * @throws std::invalid_argument если матрица не квадратная или вырожденная
+     */
+    template <FloatNumber T>
+    inline void lu_decompose_lup_blocked(
+        miv::matrix<T> &LU,
+        miv::array<std::size_t> &pivots,
+        std::size_t block_size = lu_default_block_size)
+    {
+        require_squareness(LU);
+
+        if (pivots.size() != LU.rows())
+        {
+            pivots.resize(LU.rows());
+        }
+
+        lu_decompose_lup_blocked(miv::matrix_view<T>(LU), pivots.data(), block_size);
+    }
+
+    /**
+     * @brief Применить к вектору x обмены строк из pivots (x := Px).
+     */
+    template <FloatNumber T>
+    inline void apply_row_swaps(const std::size_t *pivots, std::size_t n, T *x)
+    {
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            if (pivots[k] != k)
+            {
+                std::swap(x[k], x[pivots[k]]);
+            }
+        }
+    }
+
+    template <FloatNumber T>
+    inline void apply_row_swaps(const miv::array<std::size_t> &pivots, T *x)
+    {
+        apply_row_swaps(pivots.data(), pivots.size(), x);
+    }
+
+    /**
+     * @brief Прямая подстановка L y = x на месте по упакованному LU (диагональ L — единицы).
+     */
+    template <FloatNumber T>
+    inline void forward_substitution_packed(const miv::matrix_view<const T> &lu, T *x)
+    {
+        MIV_PROFILE_SCOPE(substitute);
+
+        const std::size_t n = lu.rows();
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const T *l_row = lu.row_ptr(i);
+            T sum = 0;
+            for (std::size_t j = 0; j < i; ++j)
+            {
+                sum += l_row[j] * x[j];
+            }
+            x[i] -= sum;
+        }
+    }
+
+    template <FloatNumber T>
+    inline void forward_substitution_packed(const miv::matrix<T> &LU, T *x)
+    {
+        forward_substitution_packed(miv::matrix_view<const T>(LU), x);
+    }
+
+    /**
+     * @brief Обратная подстановка U x = y на месте по упакованному LU.
+     */
+    template <FloatNumber T>
+    inline void backward_substitution_packed(const miv::matrix_view<const T> &lu, T *x)
+    {
+        MIV_PROFILE_SCOPE(substitute);
+
+        const std::size_t n = lu.rows();
+
+        for (std::size_t i = n; i > 0; --i)
+        {
+            const std::size_t row = i - 1;
+            const T *u_row = lu.row_ptr(row);
+            T sum = 0;
+
+            for (std::size_t j = row + 1; j < n; ++j)
+            {
+                sum += u_row[j] * x[j];
+            }
+
+            x[row] = (x[row] - sum) / u_row[row];
+        }
+    }
+
+    template <FloatNumber T>
+    inline void backward_substitution_packed(const miv::matrix<T> &LU, T *x)
+    {
+        backward_substitution_packed(miv::matrix_view<const T>(LU), x);
+    }
+
+    // ============================================================
+    //      Много правых частей (B — n x k) и транспонированная система
+    // ============================================================
+    //
+    // Правые части — столбцы B, строка B (k значений) лежит подряд. Подстановки
+    // идут блоками по lu_default_block_size строк: внутри блока — обновления
+    // строками длины k, вне блока — одно GEMM на блок (BLAS-3 вместо k проходов
+    // по L и U).
+    //
+    // A^T x = b по тому же разложению PA = LU: A^T = U^T L^T P, поэтому
+    // U^T y = b (прямой ход по строкам U), L^T z = y (обратный ход по строкам L),
+    // x = P^T z (обмены в обратном порядке).
+
+    /**
+     * @brief Применить обмены строк к строкам B (B := PB).
+     */
+    template <FloatNumber T>
+    inline void apply_row_swaps(const std::size_t *pivots, std::size_t n, const miv::matrix_view<T> &B)
+    {
+        const std::size_t k = B.cols();
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (pivots[i] != i)
+            {
+                std::swap_ranges(B.row_ptr(i), B.row_ptr(i) + k, B.row_ptr(pivots[i]));
+            }
+        }
+    }
+
+    /**
+     * @brief Обратные обмены строк вектора x (x := P^T x).
+     */
+    template <FloatNumber T>
+    inline void apply_row_swaps_reverse(const std::size_t *pivots, std::size_t n, T *x)
+    {
+        for (std::size_t i = n; i > 0; --i)
+        {
+            const std::size_t row = i - 1;
+            if (pivots[row] != row)
+            {
+                std::swap(x[row], x[pivots[row]]);
+            }
+        }
+    }
+
+    /**
+     * @brief Обратные обмены строк B (B := P^T B).
+     */
+    template <FloatNumber T>
+    inline void apply_row_swaps_reverse(const std::size_t *pivots, std::size_t n, const miv::matrix_view<T> &B)
+    {
+        const std::size_t k = B.cols();
+
+        for (std::size_t i = n; i > 0; --i)
+        {
+            const std::size_t row = i - 1;
+            if (pivots[row] != row)
+            {
+                std::swap_ranges(B.row_ptr(row), B.row_ptr(row) + k, B.row_ptr(pivots[row]));
+            }
+        }
+    }
+
+    namespace detail
+    {
+        /**
+         * @brief row_i -= factor * row_t для строк длины k.
+         */
+        template <typename T>
+        inline void row_axpy(T *row_i, const T *row_t, T factor, std::size_t k)
+        {
+            for (std::size_t j = 0; j < k; ++j)
+            {
+                row_i[j] -= factor * row_t[j];
+            }
+        }
+    }
+
+    /**
+     * @brief Прямая подстановка L Y = B на месте для n x k правых частей.
+     */
+    template <FloatNumber T>
+    inline void forward_substitution_packed(const miv::matrix_view<const T> &lu, const miv::matrix_view<T> &B)
+    {
+        MIV_PROFILE_SCOPE(substitute);
+
+        const std::size_t n = lu.rows();
+        const std::size_t k = B.cols();
+        constexpr std::size_t bs = lu_default_block_size;
+
+        for (std::size_t i0 = 0; i0 < n; i0 += bs)
+        {
+            const std::size_t i1 = std::min(i0 + bs, n);
+
+            // Диагональный блок L11 (единичная диагональ)
+            for (std::size_t i = i0 + 1; i < i1; ++i)
+            {
+                const T *l_row = lu.row_ptr(i);
+                for (std::size_t t = i0; t < i; ++t)
+                {
+                    detail::row_axpy(B.row_ptr(i), B.row_ptr(t), l_row[t], k);
+                }
+            }
+
+            // B2 := B2 - L21 * Y1
+            if (i1 < n)
+            {
+                gemm(n - i1, k, i1 - i0, static_cast<T>(-1),
+                     lu.row_ptr(i1) + i0, lu.stride(),
+                     B.row_ptr(i0), B.stride(),
+                     static_cast<T>(1),
+                     B.row_ptr(i1), B.stride());
+            }
+        }
+    }
+
+    /**
+     * @brief Обратная подстановка U X = Y на месте для n x k правых частей.
+     */
+    template <FloatNumber T>
+    inline void backward_substitution_packed(const miv::matrix_view<const T> &lu, const miv::matrix_view<T> &B)
+    {
+        MIV_PROFILE_SCOPE(substitute);
+
+        const std::size_t n = lu.rows();
+        const std::size_t k = B.cols();
+        constexpr std::size_t bs = lu_default_block_size;
+
+        for (std::size_t i1 = n; i1 > 0;)
+        {
+            const std::size_t i0 = (i1 > bs) ? i1 - bs : 0;
+
+            // Диагональный блок U22
+            for (std::size_t i = i1; i > i0; --i)
+            {
+                const std::size_t row = i - 1;
+                const T *u_row = lu.row_ptr(row);
+                T *b_row = B.row_ptr(row);
+
+                for (std::size_t t = row + 1; t < i1; ++t)
+                {
+                    detail::row_axpy(b_row, B.row_ptr(t), u_row[t], k);
+                }
+
+                const T inv = static_cast<T>(1) / u_row[row];
+                for (std::size_t j = 0; j < k; ++j)
+                {
+                    b_row[j] *= inv;
+                }
+            }
+
+            // B1 := B1 - U12 * X2
+            if (i0 > 0)
+            {
+                gemm(i0, k, i1 - i0, static_cast<T>(-1),
+                     lu.row_ptr(0) + i0, lu.stride(),
+                     B.row_ptr(i0), B.stride(),
+                     static_cast<T>(1),
+                     B.row_ptr(0), B.stride());
+            }
+
+            i1 = i0;
+        }
+    }
+
+    /**
+     * @brief Прямая подстановка U^T y = x на месте по упакованному LU.
+     *
+     * Столбцовый вариант: после x_j /= U_jj строка j матрицы U вычитается из хвоста x.
+     */
+    template <FloatNumber T>
+    inline void forward_substitution_transposed_packed(const miv::matrix_view<const T> &lu, T *x)
+    {
+        MIV_PROFILE_SCOPE(substitute);
+
+        const std::size_t n = lu.rows();
+
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            const T *u_row = lu.row_ptr(j);
+            const T xj = x[j] / u_row[j];
+            x[j] = xj;
+
+            for (std::size_t i = j + 1; i < n; ++i)
+            {
+                x[i] -= u_row[i] * xj;
+            }
+        }
+    }
+
+    /**
+     * @brief Обратная подстановка L^T z = y на месте по упакованному LU (диагональ L — единицы).
+     */
+    template <FloatNumber T>
+    inline void backward_substitution_transposed_packed(const miv::matrix_view<const T> &lu, T *x)
+    {
+        MIV_PROFILE_SCOPE(substitute);
+
+        const std::size_t n = lu.rows();
+
+        for (std::size_t j = n; j > 0; --j)
+        {
+            const std::size_t col = j - 1;
+            const T *l_row = lu.row_ptr(col);
+            const T xj = x[col];
+
+            for (std::size_t i = 0; i < col; ++i)
+            {
+                x[i] -= l_row[i] * xj;
+            }
+        }
+    }
+
+    /**
+     * @brief U^T Y = B на месте для n x k правых частей.
+     *
+     * Блок U^T под диагональю — транспонированная полоса строк U: она копируется
+     * в рабочую матрицу (O(n * nb) на блок), после чего обновление хвоста — GEMM.
+     */
+    template <FloatNumber T>
+    inline void forward_substitution_transposed_packed(const miv::matrix_view<const T> &lu, const miv::matrix_view<T> &B)
+    {
+        MIV_PROFILE_SCOPE(substitute);
+
+        const std::size_t n = lu.rows();
+        const std::size_t k = B.cols();
+        constexpr std::size_t bs = lu_default_block_size;
+
+        // Транспонированная полоса: не больше n x bs
+        miv::array<T> panel(n * std::min(bs, n), miv::uninitialized);
+
+        for (std::size_t i0 = 0; i0 < n; i0 += bs)
+        {
+            const std::size_t i1 = std::min(i0 + bs, n);
+
+            for (std::size_t j = i0; j < i1; ++j)
+            {
+                const T *u_row = lu.row_ptr(j);
+                T *b_row = B.row_ptr(j);
+
+                const T inv = static_cast<T>(1) / u_row[j];
+                for (std::size_t c = 0; c < k; ++c)
+                {
+                    b_row[c] *= inv;
+                }
+
+                for (std::size_t i = j + 1; i < i1; ++i)
+                {
+                    detail::row_axpy(B.row_ptr(i), b_row, u_row[i], k);
+                }
+            }
+
+            // B2 := B2 - (U12)^T * Y1
+            if (i1 < n)
+            {
+                const std::size_t rest = n - i1;
+                const std::size_t kb = i1 - i0;
+                transpose_into(
+                    miv::matrix_view<const T>(lu.row_ptr(i0) + i1, kb, rest, lu.stride()),
+                    miv::matrix_view<T>(panel.data(), rest, kb));
+
+                gemm(rest, k, kb, static_cast<T>(-1),
+                     panel.data(), kb,
+                     B.row_ptr(i0), B.stride(),
+                     static_cast<T>(1),
+                     B.row_ptr(i1), B.stride());
+            }
+        }
+    }
+
+    /**
+     * @brief L^T Z = Y на месте для n x k правых частей (см. вариант для U^T).
+     */
+    template <FloatNumber T>
+    inline void backward_substitution_transposed_packed(const miv::matrix_view<const T> &lu, const miv::matrix_view<T> &B)
+    {
+        MIV_PROFILE_SCOPE(substitute);
+
+        const std::size_t n = lu.rows();
+        const std::size_t k = B.cols();
+        constexpr std::size_t bs = lu_default_block_size;
+
+        // Транспонированная полоса: не больше n x bs
+        miv::array<T> panel(n * std::min(bs, n), miv::uninitialized);
+
+        for (std::size_t i1 = n; i1 > 0;)
+        {
+            const std::size_t i0 = (i1 > bs) ? i1 - bs : 0;
+
+            for (std::size_t j = i1; j > i0; --j)
+            {
+                const std::size_t col = j - 1;
+                const T *l_row = lu.row_ptr(col);
+                const T *b_row = B.row_ptr(col);
+
+                for (std::size_t i = i0; i < col; ++i)
+                {
+                    detail::row_axpy(B.row_ptr(i), b_row, l_row[i], k);
+                }
+            }
+
+            // B1 := B1 - (L21)^T * Z2
+            if (i0 > 0)
+            {
+                const std::size_t kb = i1 - i0;
+                transpose_into(
+                    miv::matrix_view<const T>(lu.row_ptr(i0), kb, i0, lu.stride()),
+                    miv::matrix_view<T>(panel.data(), i0, kb));
+
+                gemm(i0, k, kb, static_cast<T>(-1),
+                     panel.data(), kb,
+                     B.row_ptr(i0), B.stride(),
+                     static_cast<T>(1),
+                     B.row_ptr(0), B.stride());
+            }
+
+            i1 = i0;
+        }
+    }
+
+    /**
+     * @brief Переиспользуемое LUP-разложение квадратной матрицы: PA = LU.
+     *
+     * Разложение выполняется один раз за O(n^3), после чего каждое решение
+     * Ax = b стоит O(n^2). Это именно то, что нужно модифицированному методу
+     * Ньютона: Якобиан заморожен, а правые части меняются на каждой итерации.
+     *
+     * L и U хранятся в одном упакованном буфере (см. lu_decompose_lup_packed),
+     * перестановка — как последовательность обменов строк (как ipiv в LAPACK).
+     * Большие матрицы раскладываются блочно (lu_decompose_lup_blocked).
+     */
+    template <FloatNumber T>
+    class lu_factorization
+    {
+    public:
+        using value_t = T;
+
+        /**
+         * @brief Пустое (ещё не выполненное) разложение.
+         */
+        lu_factorization() = default;
+
+        /**
+         * @brief Сразу разложить матрицу A (A копируется).
+         *
+         * @throws std::invalid_argument если A не квадратная или вырожденная
+         */
+        explicit lu_factorization(const miv::matrix<T> &A)
+        {
+            factorize(A);
+        }
+
+        /**
+         * @brief Разложить матрицу A на месте её собственного буфера (без копии).
+         *
+         * @throws std::invalid_argument если A не квадратная или вырожденная
+         */
+        explicit lu_factorization(miv::matrix<T> &&A)
+        {
+            factorize(std::move(A));
+        }
+
+        /**
+         * @brief Выполнить (или повторить) разложение матрицы A.
+         *
+         * Буферы предыдущего разложения того же размера переиспользуются:
+         * повторная факторизация (метод Ньютона) не выделяет память.
+         * Если разложение не удалось, объект становится пустым.
+         *
+         * @throws std::invalid_argument если A не квадратная или вырожденная
+         */
+        void factorize(const miv::matrix<T> &A)
+        {
+            require_squareness(A);
+
+            m_LU = A;
+
+            try
+            {
+                lu_decompose_lup_blocked(m_LU, m_pivots);
+            }
+            catch (...)
+            {
+                m_LU.clear();
+                throw;
+            }
+        }
+
+        /**
+         * @brief Выполнить разложение, забрав буфер A.
+         *
+         * Как и копирующая перегрузка: если разложение не удалось, объект становится пустым.
+         *
+         * @throws std::invalid_argument если A не квадратная или вырожденная
+         */
+        void factorize(miv::matrix<T> &&A)
+        {
+            // Прежнее разложение недействительно с этого момента, даже если A вырождена
+            m_LU.clear();
+            require_squareness(A);
+
+            miv::array<std::size_t> pivots(A.rows());
+            lu_decompose_lup_blocked(A, pivots);
+
+            m_LU = std::move(A);
+            m_pivots = std::move(pivots);
+        }
+
+        /**
+         * @brief Было ли выполнено разложение.
+         */
+        bool empty() const { return m_LU.empty(); }
+
+        /**
+         * @brief Размерность разложенной матрицы (n).
+         */
+        std::size_t n() const { return m_LU.rows(); }
+
+        /**
+         * @brief Упакованные множители: U на и над диагональю, L под диагональю.
+         */
+        const miv::matrix<T> &packed() const { return m_LU; }
+
+        /**
+         * @brief Обмены строк: на шаге k строка k обменяна со строкой pivots()[k].
+         */
+        const miv::array<std::size_t> &pivots() const { return m_pivots; }
+
+        /**
+         * @brief Нижнетреугольный множитель L (копия, с единичной диагональю).
+         */
+        miv::matrix<T> lower() const
+        {
+            const std::size_t n = m_LU.rows();
+            miv::matrix<T> L = identity<T>(n);
+
+            for (std::size_t i = 1; i < n; ++i)
+            {
+                std::copy(m_LU.row_ptr(i), m_LU.row_ptr(i) + i, L.row_ptr(i));
+            }
+
+            return L;
+        }
+
+        /**
+         * @brief Верхнетреугольный множитель U (копия).
+         */
+        miv::matrix<T> upper() const
+        {
+            const std::size_t n = m_LU.rows();
+            miv::matrix<T> U(n, n, T{});
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                std::copy(m_LU.row_ptr(i) + i, m_LU.row_ptr(i) + n, U.row_ptr(i) + i);
+            }
+
+            return U;
+        }
+
+        /**
+         * @brief Решить Ax = b на месте: b заменяется на x. O(n^2).
+         *
+         * Подходит массив с любым аллокатором (например, из miv::workspace).
+         *
+         * @throws std::logic_error если разложение не выполнено
+         * @throws std::invalid_argument если длина b не равна n
+         */
+        template <typename Alloc>
+        void solve_inplace(miv::array<T, Alloc> &b) const
+        {
+            require_rhs_length(b.size());
+            solve_raw(b.data());
+        }
+
+        /**
+         * @brief Решить AX = B на месте: B — вектор (1 x n или n x 1) или n x k
+         * (k правых частей — столбцы B).
+         *
+         * Все правые части решаются по одному разложению блочными подстановками
+         * (обновления вне диагональных блоков — GEMM), а не k проходами по L и U.
+         *
+         * @throws std::logic_error если разложение не выполнено
+         * @throws std::invalid_argument если B не вектор длины n и не n x k
+         */
+        void solve_inplace(miv::matrix<T> &b) const
+        {
+            if (is_rhs_block(b))
+            {
+                solve_block(b);
+            }
+            else
+            {
+                solve_raw(b.data());
+            }
+        }
+
+        /**
+         * @brief Решить Ax = b в готовый буфер x (b не меняется, x той же длины не перевыделяется).
+         */
+        template <typename Alloc>
+        void solve_into(const miv::array<T> &b, miv::array<T, Alloc> &x) const
+        {
+            require_rhs_length(b.size());
+
+            if (x.size() != b.size())
+            {
+                x.resize(b.size());
+            }
+
+            std::copy(b.begin(), b.end(), x.begin());
+            solve_raw(x.data());
+        }
+
+        /**
+         * @brief Решить Ax = b и вернуть x (b не меняется).
+         */
+        miv::array<T> solve(const miv::array<T> &b) const
+        {
+            miv::array<T> x = b;
+            solve_inplace(x);
+            return x;
+        }
+
+        /**
+         * @brief Решить AX = B и вернуть X той же формы, что и B (вектор или n x k).
+         */
+        miv::matrix<T> solve(const miv::matrix<T> &b) const
+        {
+            miv::matrix<T> x = b;
+            solve_inplace(x);
+            return x;
+        }
+
+        /**
+         * @brief Решить A^T x = b на месте по тому же разложению. O(n^2).
+         *
+         * @throws std::logic_error если разложение не выполнено
+         * @throws std::invalid_argument если длина b не равна n
+         */
+        template <typename Alloc>
+        void solve_transposed_inplace(miv::array<T, Alloc> &b) const
+        {
+            require_rhs_length(b.size());
+            solve_transposed_raw(b.data());
+        }
+
+        /**
+         * @brief Решить A^T X = B на месте: B — вектор или n x k (см. solve_inplace).
+         */
+        void solve_transposed_inplace(miv::matrix<T> &b) const
+        {
+            if (is_rhs_block(b))
+            {
+                solve_transposed_block(b);
+            }
+            else
+            {
+                solve_transposed_raw(b.data());
+            }
+        }
+
+        /**
+         * @brief Решить A^T x = b и вернуть x (b не меняется).
+         */
+        miv::array<T> solve_transposed(const miv::array<T> &b) const
+        {
+            miv::array<T> x = b;
+            solve_transposed_inplace(x);
+            return x;
+        }
+
+        /**
+         * @brief Решить A^T X = B и вернуть X той же формы, что и B.
+         */
+        miv::matrix<T> solve_transposed(const miv::matrix<T> &b) const
+        {
+            miv::matrix<T> x = b;
+            solve_transposed_inplace(x);
+            return x;
+        }
+
+    private:
+        void require_rhs_length(std::size_t len) const
+        {
+            if (empty())
+            {
+                throw std::logic_error("lu_factorization::solve(): factorization is empty");
+            }
+
+            if (len != n())
+            {
+                throw std::invalid_argument(
+                    "lu_factorization::solve(): b must be a vector of length n = " + std::to_string(n()) +
+                    ", but got length " + std::to_string(len));
+            }
+        }
+
+        /**
+         * @brief true — B из n x k правых частей (k != 1), false — B вектор длины n.
+         *
+         * @throws std::logic_error если разложение не выполнено
+         * @throws std::invalid_argument если B ни то, ни другое
+         */
+        bool is_rhs_block(const miv::matrix<T> &b) const
+        {
+            if (empty())
+            {
+                throw std::logic_error("lu_factorization::solve(): factorization is empty");
+            }
+
+            if (b.rows() == n() && b.cols() != 1)
+            {
+                return true;
+            }
+
+            if (!is_vector(b) || vector_length(b) != n())
+            {
+                throw std::invalid_argument(
+                    "lu_factorization::solve(): b must be a vector of length n = " + std::to_string(n()) +
+                    " or an n x k matrix, but got shape " + std::to_string(b.rows()) + "x" + std::to_string(b.cols()));
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Применить P, затем прямую (L y = Pb) и обратную (U x = y) подстановки.
+         *
+         * Вход и выход в одном непрерывном буфере длины n.
+         */
+        void solve_raw(T *x) const
+        {
+            MIV_PROFILE_SCOPE(substitute);   // прямой и обратный ход — одно решение
+
+            apply_row_swaps(m_pivots, x);
+            forward_substitution_packed(m_LU, x);
+            backward_substitution_packed(m_LU, x);
+        }
+
+        /**
+         * @brief То же для n x k правых частей (блочные подстановки).
+         */
+        void solve_block(miv::matrix<T> &b) const
+        {
+            MIV_PROFILE_SCOPE(substitute);
+
+            const miv::matrix_view<const T> lu(m_LU);
+            const miv::matrix_view<T> bv(b);
+
+            apply_row_swaps(m_pivots.data(), n(), bv);
+            forward_substitution_packed(lu, bv);
+            backward_substitution_packed(lu, bv);
+        }
+
+        /**
+         * @brief A^T x = b: U^T y = b, L^T z = y, x = P^T z.
+         */
+        void solve_transposed_raw(T *x) const
+        {
+            MIV_PROFILE_SCOPE(substitute);
+
+            const miv::matrix_view<const T> lu(m_LU);
+
+            forward_substitution_transposed_packed(lu, x);
+            backward_substitution_transposed_packed(lu, x);
+            apply_row_swaps_reverse(m_pivots.data(), n(), x);
+        }
+
+        void solve_transposed_block(miv::matrix<T> &b) const
+        {
+            MIV_PROFILE_SCOPE(substitute);
+
+            const miv::matrix_view<const T> lu(m_LU);
+            const miv::matrix_view<T> bv(b);
+
+            forward_substitution_transposed_packed(lu, bv);
+            backward_substitution_transposed_packed(lu, bv);
+            apply_row_swaps_reverse(m_pivots.data(), n(), bv);
+        }
+
+        miv::matrix<T> m_LU;
+        miv::array<std::size_t> m_pivots;
+    };
+}
+
+#endif // MIV_MATH_LU_FACTORIZATION_H
@@ -0,0 +1,558 @@
+#ifndef MIV_MATH_MULTI_START_H
+#define MIV_MATH_MULTI_START_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "containers/array.hpp"
+#include "containers/matrix.hpp"
+#include "exec/thread_pool.hpp"
+#include "math/helpers.hpp"   // FloatNumber, norm_t
+#include "math/newton_options.hpp"
+#include "math/newton_solver.hpp"
+
+namespace miv::math
+{
+    /**
+     * @brief Чем закончилось одно начальное приближение мульти-старта.
+     */
+    enum class start_status : unsigned char
+    {
+        root,            ///< сошлось к новому корню
+        duplicate,       ///< сошлось (или подошло на capture_radius) к уже найденному корню
+        diverged,        ///< F не конечна, ||x|| или ||F|| вышли за пределы — остановлено
+        not_converged,   ///< лимит итераций или ||F(x*)|| > max_residual
+        cancelled,       ///< найдено max_roots корней — остановлено или не запускалось
+        failed           ///< исключение решателя (вырожденный Якобиан и т.п.), текст — в errors
+    };
+
+    /**
+     * @brief Имя исхода (root, duplicate, diverged, not_converged, cancelled, failed).
+     */
+    constexpr std::string_view to_string(start_status status)
+    {
+        switch (status)
+        {
+        case start_status::root:
+            return "root";
+        case start_status::duplicate:
+            return "duplicate";
+        case start_status::diverged:
+            return "diverged";
+        case start_status::not_converged:
+            return "not_converged";
+        case start_status::cancelled:
+            return "cancelled";
+        case start_status::failed:
+            return "failed";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @brief Параметры мульти-старта.
+     *
+     * Расстояния — в норме max |x_i - y_i|.
+     */
+    struct multi_start_options
+    {
+        /// Одновременно решаемых стартов (0 — степень параллелизма общего пула miv::exec)
+        std::size_t jobs = 0;
+
+        /// Два решения — один корень, если они ближе root_tolerance
+        norm_t root_tolerance = 1e-6;
+
+        /// Дорожка останавливается как duplicate, когда x_k подходит к известному корню ближе capture_radius
+        /// (0 — только по окончании решения)
+        norm_t capture_radius = 1e-3;
+
+        /// Сошедшееся решение засчитывается корнем только при ||F(x*)|| <= max_residual
+        norm_t max_residual = 1e-6;
+
+        /// Расходимость: max |x_i| > divergence_bound или ||F(x_k)|| > divergence_ratio * ||F(x_0)||
+        norm_t divergence_bound = 1e10;
+        norm_t divergence_ratio = 1e10;
+
+        /// Остановить все дорожки, когда найдено столько разных корней (0 — без ограничения);
+        /// какие корни успеют найтись, зависит от числа потоков
+        std::size_t max_roots = 0;
+    };
+
+    /**
+     * @brief Корень, найденный мульти-стартом.
+     */
+    template <FloatNumber T>
+    struct multi_start_root
+    {
+        miv::array<T> x;
+        norm_t residual_norm = 0;   ///< ||F(x)||
+        std::size_t start = 0;      ///< старт, нашедший корень первым
+        std::size_t hits = 1;       ///< стартов, пришедших к этому корню (root + duplicate)
+    };
+
+    /**
+     * @brief Результат solve_multi_start: корни и исход каждого старта.
+     */
+    template <FloatNumber T>
+    struct multi_start_result
+    {
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        std::vector<multi_start_root<T>> roots;   ///< по возрастанию start
+        std::vector<start_status> status;         ///< по старту
+        std::vector<std::size_t> root_index;      ///< индекс в roots для root / duplicate, иначе npos
+        std::vector<std::size_t> iterations;      ///< итераций Ньютона по старту
+        std::vector<std::string> errors;          ///< текст исключения для failed, иначе пусто
+        std::chrono::nanoseconds elapsed{ 0 };
+
+        std::size_t starts() const { return status.size(); }
+
+        /**
+         * @brief Сколько стартов закончилось с данным исходом.
+         */
+        std::size_t count(start_status s) const
+        {
+            return static_cast<std::size_t>(std::count(status.begin(), status.end(), s));
+        }
+    };
+
+    // ============================================================
+    //                   Множество корней (spatial hash)
+    // ============================================================
+
+    /**
+     * @brief Корни с поиском соседа в пределах радиуса по сетке.
+     *
+     * Ячейка сетки — cell по первым min(n, 3) координатам: точка ближе cell
+     * к корню (в норме max) лежит в той же или соседней ячейке, поэтому
+     * поиск смотрит 3^d ячеек и сравнивает полные векторы только у кандидатов.
+     * Не потокобезопасно: solve_multi_start держит его под мьютексом.
+     */
+    template <FloatNumber T>
+    class root_set
+    {
+    public:
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        /**
+         * @throws std::invalid_argument если cell <= 0
+         */
+        explicit root_set(std::size_t n, norm_t cell) : m_n(n), m_dims(std::min<std::size_t>(n, 3)), m_cell(cell)
+        {
+            if (!(cell > 0))
+            {
+                throw std::invalid_argument("root_set: cell size must be positive");
+            }
+        }
+
+        std::size_t size() const { return m_roots.size(); }
+
+        multi_start_root<T> &operator[](std::size_t i) { return m_roots[i]; }
+        const multi_start_root<T> &operator[](std::size_t i) const { return m_roots[i]; }
+
+        std::vector<multi_start_root<T>> &roots() { return m_roots; }
+
+        /**
+         * @brief Ближайший (первый найденный) корень не дальше radius <= cell.
+         *
+         * @return индекс корня или npos
+         */
+        std::size_t find(const T *x, norm_t radius) const
+        {
+            if (m_roots.empty())
+            {
+                return npos;
+            }
+
+            std::int64_t base[3] = {};
+            for (std::size_t d = 0; d < m_dims; ++d)
+            {
+                base[d] = cell_of(x[d]);
+            }
+
+            // Соседние ячейки: смещения -1, 0, 1 по каждой из m_dims координат
+            std::size_t neighbours = 1;
+            for (std::size_t d = 0; d < m_dims; ++d)
+            {
+                neighbours *= 3;
+            }
+
+            for (std::size_t code = 0; code < neighbours; ++code)
+            {
+                std::int64_t cell[3] = {};
+                std::size_t rest = code;
+                for (std::size_t d = 0; d < m_dims; ++d)
+                {
+                    cell[d] = base[d] + static_cast<std::int64_t>(rest % 3) - 1;
+                    rest /= 3;
+                }
+
+                const auto range = m_grid.equal_range(key_of(cell));
+                for (auto it = range.first; it != range.second; ++it)
+                {
+                    if (distance(m_roots[it->second].x.data(), x) <= radius)
+                    {
+                        return it->second;
+                    }
+                }
+            }
+
+            return npos;
+        }
+
+        /**
+         * @brief Добавить новый корень.
+         *
+         * @return его индекс
+         */
+        std::size_t insert(multi_start_root<T> root)
+        {
+            std::int64_t cell[3] = {};
+            for (std::size_t d = 0; d < m_dims; ++d)
+            {
+                cell[d] = cell_of(root.x[d]);
+            }
+
+            m_roots.push_back(std::move(root));
+            m_grid.emplace(key_of(cell), m_roots.size() - 1);
+
+            return m_roots.size() - 1;
+        }
+
+    private:
+        std::int64_t cell_of(T v) const
+        {
+            // Далёкие и не конечные координаты — в крайние ячейки (это расходящиеся точки)
+            constexpr norm_t limit = static_cast<norm_t>(std::int64_t{ 1 } << 60);
+            const norm_t c = std::floor(static_cast<norm_t>(v) / m_cell);
+            if (!(c > -limit))
+            {
+                return -(std::int64_t{ 1 } << 60);
+            }
+            if (!(c < limit))
+            {
+                return std::int64_t{ 1 } << 60;
+            }
+            return static_cast<std::int64_t>(c);
+        }
+
+        std::uint64_t key_of(const std::int64_t *cell) const
+        {
+            // Совпадение ключей у разных ячеек безопасно: кандидаты проверяются по расстоянию
+            std::uint64_t key = 0x9e3779b97f4a7c15ull;
+            for (std::size_t d = 0; d < m_dims; ++d)
+            {
+                key ^= static_cast<std::uint64_t>(cell[d]) + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2);
+            }
+            return key;
+        }
+
+        norm_t distance(const T *a, const T *b) const
+        {
+            norm_t d = 0;
+            for (std::size_t i = 0; i < m_n; ++i)
+            {
+                d = std::max(d, static_cast<norm_t>(std::abs(a[i] - b[i])));
+            }
+            return d;
+        }
+
+        std::size_t m_n;
+        std::size_t m_dims;
+        norm_t m_cell;
+        std::vector<multi_start_root<T>> m_roots;
+        std::unordered_multimap<std::uint64_t, std::size_t> m_grid;
+    };
+
+    // ============================================================
+    //                   Начальные приближения
+    // ============================================================
+
+    /**
+     * @brief count равномерно распределённых стартов в прямоугольнике [lower, upper] (по столбцу на старт).
+     *
+     * Одно и то же seed даёт те же точки.
+     *
+     * @throws std::invalid_argument если размеры границ различаются или lower > upper
+     */
+    template <FloatNumber T>
+    miv::matrix<T> make_uniform_starts(const miv::array<T> &lower, const miv::array<T> &upper, std::size_t count,
+                                       std::uint64_t seed = 1)
+    {
+        const std::size_t n = lower.size();
+        if (upper.size() != n || n == 0)
+        {
+            throw std::invalid_argument("make_uniform_starts(): lower and upper must have the same nonzero length");
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (!(lower[i] <= upper[i]))
+            {
+                throw std::invalid_argument("make_uniform_starts(): lower must not exceed upper");
+            }
+        }
+
+        std::mt19937_64 engine(seed);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+        miv::matrix<T> starts(n, count, miv::uninitialized);
+        for (std::size_t s = 0; s < count; ++s)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                starts(i, s) = lower[i] + static_cast<T>(unit(engine)) * (upper[i] - lower[i]);
+            }
+        }
+
+        return starts;
+    }
+
+    // ============================================================
+    //                       Мульти-старт
+    // ============================================================
+
+    /**
+     * @brief Решить F(x) = 0 из каждого столбца starts (n x K) параллельно и собрать разные корни.
+     *
+     * make_solver() создаёт настроенный newton_solver<T> — по одному на одновременно
+     * работающую дорожку (буферы решателя не делятся). Дорожки разбирают старты по
+     * одному из общего счётчика на пуле miv::exec, так что долгие старты не задерживают
+     * остальные. Условие остановки решателя (set_stop_condition) проверяет на каждой
+     * итерации:
+     *  - расходимость (F не конечна, max |x_i| > divergence_bound,
+     *    ||F(x_k)|| > divergence_ratio * ||F(x_0)||) — diverged;
+     *  - x_k ближе capture_radius к найденному корню — duplicate, без добивания итераций;
+     *  - найдено max_roots корней — cancelled (и оставшиеся старты не запускаются).
+     * Сошедшееся решение с ||F|| <= max_residual сравнивается с корнями (root_set,
+     * допуск root_tolerance): новое — root, иначе duplicate.
+     *
+     * При max_roots == 0 набор корней не зависит от числа потоков, но какой из стартов
+     * «нашёл» корень первым — может (roots упорядочены по start). С max_roots != 0
+     * в результат попадают корни, найденные первыми по времени: какие именно, зависит
+     * от числа потоков и планирования, а не от порядка стартов.
+     *
+     * @throws std::invalid_argument если starts.rows() != n или допуски не положительны
+     */
+    template <FloatNumber T, typename System, typename SolverFactory>
+    multi_start_result<T> solve_multi_start(const System &functions, const miv::matrix<T> &starts,
+                                            const multi_start_options &options, SolverFactory make_solver)
+    {
+        const auto start_time = std::chrono::steady_clock::now();
+
+        const std::size_t n = system_size(functions);
+        const std::size_t K = starts.cols();
+
+        if (starts.rows() != n)
+        {
+            throw std::invalid_argument(
+                "solve_multi_start(): starts must have n = " + std::to_string(n) + " rows, but got " +
+                std::to_string(starts.rows()));
+        }
+
+        if (!(options.root_tolerance > 0) || options.capture_radius < 0)
+        {
+            throw std::invalid_argument(
+                "solve_multi_start(): root_tolerance must be positive and capture_radius non-negative");
+        }
+
+        using result_t = multi_start_result<T>;
+
+        result_t result;
+        result.status.assign(K, start_status::cancelled);
+        result.root_index.assign(K, result_t::npos);
+        result.iterations.assign(K, 0);
+        result.errors.assign(K, std::string());
+
+        root_set<T> roots(n, std::max(options.root_tolerance, options.capture_radius));
+        std::mutex roots_mutex;
+        std::atomic<std::size_t> root_count{ 0 };
+        std::atomic<bool> stop_all{ false };
+        std::atomic<std::size_t> next{ 0 };
+
+        // Найденный корень (под roots_mutex): root_index и статус дорожки
+        auto record_root = [&](std::size_t s, const miv::array<T> &x, norm_t residual)
+        {
+            std::lock_guard<std::mutex> lock(roots_mutex);
+
+            const std::size_t known = roots.find(x.data(), options.root_tolerance);
+            if (known != root_set<T>::npos)
+            {
+                ++roots[known].hits;
+                result.root_index[s] = known;
+                result.status[s] = start_status::duplicate;
+                return;
+            }
+
+            result.root_index[s] = roots.insert({ x, residual, s, 1 });
+            result.status[s] = start_status::root;
+
+            const std::size_t found = root_count.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (options.max_roots != 0 && found >= options.max_roots)
+            {
+                stop_all.store(true, std::memory_order_relaxed);
+            }
+        };
+
+        auto run_lane = [&]
+        {
+            auto solver = make_solver();
+
+            std::size_t s = 0;
+            norm_t f0 = 0;
+            start_status reason = start_status::cancelled;
+            std::size_t captured = result_t::npos;
+
+            solver.set_stop_condition([&](const newton_iteration<T> &it)
+            {
+                if (it.k == 0)
+                {
+                    f0 = it.fx_norm;
+                }
+
+                if (stop_all.load(std::memory_order_relaxed))
+                {
+                    reason = start_status::cancelled;
+                    return true;
+                }
+
+                norm_t x_max = 0;
+                for (std::size_t i = 0; i < it.x.size(); ++i)
+                {
+                    x_max = std::max(x_max, static_cast<norm_t>(std::abs(it.x[i])));
+                }
+
+                if (!std::isfinite(it.fx_norm) || !(x_max <= options.divergence_bound) ||
+                    it.fx_norm > options.divergence_ratio * f0)
+                {
+                    reason = start_status::diverged;
+                    return true;
+                }
+
+                if (options.capture_radius > 0 && root_count.load(std::memory_order_relaxed) != 0)
+                {
+                    std::lock_guard<std::mutex> lock(roots_mutex);
+                    captured = roots.find(it.x.data(), options.capture_radius);
+                    if (captured != root_set<T>::npos)
+                    {
+                        reason = start_status::duplicate;
+                        return true;
+                    }
+                }
+
+                return false;
+            });
+
+            while ((s = next.fetch_add(1, std::memory_order_relaxed)) < K && !stop_all.load(std::memory_order_relaxed))
+            {
+                f0 = 0;
+                captured = result_t::npos;
+
+                miv::array<T> x0(n, miv::uninitialized);
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    x0[i] = starts(i, s);
+                }
+
+                try
+                {
+                    auto r = solver.solve(functions, std::move(x0));
+                    result.iterations[s] = r.iterations;
+
+                    if (r.stop == newton_stop::cancelled)
+                    {
+                        result.status[s] = reason;
+                        if (reason == start_status::duplicate)
+                        {
+                            std::lock_guard<std::mutex> lock(roots_mutex);
+                            ++roots[captured].hits;
+                            result.root_index[s] = captured;
+                        }
+                    }
+                    else if (r.converged && r.residual_norm <= options.max_residual)
+                    {
+                        record_root(s, r.x, r.residual_norm);
+                    }
+                    else
+                    {
+                        result.status[s] = std::isfinite(r.residual_norm) ? start_status::not_converged
+                                                                           : start_status::diverged;
+                    }
+                }
+                catch (const std::exception &ex)
+                {
+                    result.status[s] = start_status::failed;
+                    result.errors[s] = ex.what();
+                }
+            }
+        };
+
+        const std::size_t jobs = std::min(options.jobs != 0 ? options.jobs : miv::exec::thread_count(),
+                                          std::max<std::size_t>(K, 1));
+        miv::exec::default_pool().parallel_for(0, jobs, 1, [&](std::size_t lo, std::size_t hi)
+        {
+            for (std::size_t lane = lo; lane < hi; ++lane)
+            {
+                run_lane();
+            }
+        });
+
+        // Корни по возрастанию старта: порядок не зависит от того, какая дорожка успела первой
+        auto &found = roots.roots();
+        std::vector<std::size_t> order(found.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return found[a].start < found[b].start; });
+
+        std::vector<std::size_t> renumber(found.size());
+        result.roots.reserve(found.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+        {
+            renumber[order[i]] = i;
+            result.roots.push_back(std::move(found[order[i]]));
+        }
+        for (auto &index : result.root_index)
+        {
+            if (index != result_t::npos)
+            {
+                index = renumber[index];
+            }
+        }
+
+        result.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_time);
+
+        return result;
+    }
+
+    /**
+     * @brief То же с решателем newton_solver<T>(newton_options) на каждой дорожке.
+     */
+    template <FloatNumber T, typename System>
+    multi_start_result<T> solve_multi_start(const System &functions, const miv::matrix<T> &starts,
+                                            const multi_start_options &options,
+                                            const newton_options<T> &solver_options)
+    {
+        return solve_multi_start(functions, starts, options, [&solver_options]
+        {
+            return newton_solver<T>(solver_options);
+        });
+    }
+}
+
+#endif // MIV_MATH_MULTI_START_H
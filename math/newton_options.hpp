@@ -0,0 +1,378 @@
+#ifndef MIV_MATH_NEWTON_OPTIONS_H
+#define MIV_MATH_NEWTON_OPTIONS_H
+
+#include <cstddef>
+#include <string_view>
+
+#include "math/helpers.hpp"   // FloatNumber
+
+namespace miv::math
+{
+    /**
+     * @brief Вариант метода Ньютона.
+     *
+     * - Newton:         Якобиан строится и раскладывается на каждой итерации
+     * - ModifiedNewton: Якобиан в x0 раскладывается один раз (замороженный Якобиан)
+     * - BroydenGood / BroydenBad: Якобиан строится в x0, дальше — поправки ранга 1
+     *   по шагам (одно вычисление F и O(n^2) на итерацию, см. broyden_updates);
+     *   при застое Якобиан строится заново
+     */
+    enum class Method
+    {
+        Newton = 1,
+        ModifiedNewton = 2,
+        BroydenGood = 3,
+        BroydenBad = 4
+    };
+
+    /**
+     * @brief Квазиньютоновский ли метод (обновления Бройдена).
+     */
+    constexpr bool is_broyden(Method method)
+    {
+        return method == Method::BroydenGood || method == Method::BroydenBad;
+    }
+
+    /**
+     * @brief Источник Якобиана.
+     *
+     * JacobianFree — Ньютон–Крылов без Якобиана: шаг J s = -F решается GMRES(m),
+     * произведения J v — разностью (F(x + εv) - F(x)) / ε. С ModifiedNewton
+     * разложение J(x0) служит предобуславливателем.
+     *
+     * Automatic — точный Якобиан прямым автоматическим дифференцированием
+     * (функции системы от miv::ad::dual, см. automatic_jacobian_builder).
+     */
+    enum class JacobianMode
+    {
+        Numeric = 1,
+        Manual = 2,
+        Sparse = 3,
+        JacobianFree = 4,
+        Automatic = 5
+    };
+
+    /**
+     * @brief Разностная формула численного Якобиана.
+     */
+    enum class NumericFormula
+    {
+        TwoPoint = 1,
+        ThreePoint = 2
+    };
+
+    /**
+     * @brief Глобализация шага Ньютона.
+     *
+     * - None:       x_{k+1} = x_k + λ s_k с постоянным λ
+     * - LineSearch: λ_k подбирается дроблением от λ (Армихо: ||F(x + λ s)||^2 <= (1 - 2 c λ) ||F(x)||^2,
+     *               квадратичная интерполяция); F в принятой точке — F(x_{k+1}) следующей итерации
+     * - Dogleg:     шаг dogleg в доверительной области радиуса Δ_k между точкой Коши и шагом Ньютона;
+     *               Δ_k меняется по отношению фактического и предсказанного убывания ||F||^2.
+     *               Нужен явный Якобиан (Newton / ModifiedNewton, не JacobianFree)
+     */
+    enum class Globalization
+    {
+        None = 1,
+        LineSearch = 2,
+        Dogleg = 3
+    };
+
+    /**
+     * @brief Точность плотного LU-разложения Якобиана.
+     *
+     * - Native:        разложение в точности системы T
+     * - Double, Float: разложение в double / float, решение J s = -F уточняется
+     *                  невязками в T (mixed_lu_factorization, math/refinement.hpp);
+     *                  для FuncFloat = Float128 разложение стоит почти как в double.
+     *                  Если уточнение не сходится, J раскладывается в T.
+     * Действует на плотные режимы (Numeric, Manual, Automatic и предобуславливатель
+     * JacobianFree); Sparse — всегда Native. Тип не грубее T — тоже Native.
+     */
+    enum class LinearPrecision
+    {
+        Native = 1,
+        Double = 2,
+        Float = 3
+    };
+
+    // ============================================================
+    //              Имена вариантов (конфигурация, CLI)
+    // ============================================================
+
+    /**
+     * @brief Разобрать метод по имени (newton, modified, broyden-good, broyden-bad) или номеру ("1".."4").
+     *
+     * @return false, если строка не распознана (method не меняется)
+     */
+    inline bool parse_method(std::string_view text, Method &method)
+    {
+        if (text == "newton" || text == "1")
+        {
+            method = Method::Newton;
+        }
+        else if (text == "modified" || text == "2")
+        {
+            method = Method::ModifiedNewton;
+        }
+        else if (text == "broyden-good" || text == "3")
+        {
+            method = Method::BroydenGood;
+        }
+        else if (text == "broyden-bad" || text == "4")
+        {
+            method = Method::BroydenBad;
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Разобрать источник Якобиана (numeric, manual, sparse, jacobian-free, automatic) или номер ("1".."5").
+     */
+    inline bool parse_jacobian_mode(std::string_view text, JacobianMode &mode)
+    {
+        if (text == "numeric" || text == "1")
+        {
+            mode = JacobianMode::Numeric;
+        }
+        else if (text == "manual" || text == "2")
+        {
+            mode = JacobianMode::Manual;
+        }
+        else if (text == "sparse" || text == "3")
+        {
+            mode = JacobianMode::Sparse;
+        }
+        else if (text == "jacobian-free" || text == "4")
+        {
+            mode = JacobianMode::JacobianFree;
+        }
+        else if (text == "automatic" || text == "5")
+        {
+            mode = JacobianMode::Automatic;
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Разобрать формулу (two-point, three-point) или номер ("1", "2").
+     */
+    inline bool parse_numeric_formula(std::string_view text, NumericFormula &formula)
+    {
+        if (text == "two-point" || text == "1")
+        {
+            formula = NumericFormula::TwoPoint;
+        }
+        else if (text == "three-point" || text == "2")
+        {
+            formula = NumericFormula::ThreePoint;
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Разобрать глобализацию (none, line-search, dogleg) или номер ("1".."3").
+     */
+    inline bool parse_globalization(std::string_view text, Globalization &globalization)
+    {
+        if (text == "none" || text == "1")
+        {
+            globalization = Globalization::None;
+        }
+        else if (text == "line-search" || text == "2")
+        {
+            globalization = Globalization::LineSearch;
+        }
+        else if (text == "dogleg" || text == "3")
+        {
+            globalization = Globalization::Dogleg;
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Разобрать точность разложения (native, double, float) или номер ("1".."3").
+     */
+    inline bool parse_linear_precision(std::string_view text, LinearPrecision &precision)
+    {
+        if (text == "native" || text == "1")
+        {
+            precision = LinearPrecision::Native;
+        }
+        else if (text == "double" || text == "2")
+        {
+            precision = LinearPrecision::Double;
+        }
+        else if (text == "float" || text == "3")
+        {
+            precision = LinearPrecision::Float;
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Имена (обратные к parse_*).
+     */
+    constexpr std::string_view to_string(Method method)
+    {
+        switch (method)
+        {
+        case Method::Newton:
+            return "newton";
+        case Method::ModifiedNewton:
+            return "modified";
+        case Method::BroydenGood:
+            return "broyden-good";
+        case Method::BroydenBad:
+            return "broyden-bad";
+        }
+        return "unknown";
+    }
+
+    constexpr std::string_view to_string(JacobianMode mode)
+    {
+        switch (mode)
+        {
+        case JacobianMode::Numeric:
+            return "numeric";
+        case JacobianMode::Manual:
+            return "manual";
+        case JacobianMode::Sparse:
+            return "sparse";
+        case JacobianMode::JacobianFree:
+            return "jacobian-free";
+        case JacobianMode::Automatic:
+            return "automatic";
+        }
+        return "unknown";
+    }
+
+    constexpr std::string_view to_string(NumericFormula formula)
+    {
+        switch (formula)
+        {
+        case NumericFormula::TwoPoint:
+            return "two-point";
+        case NumericFormula::ThreePoint:
+            return "three-point";
+        }
+        return "unknown";
+    }
+
+    constexpr std::string_view to_string(Globalization globalization)
+    {
+        switch (globalization)
+        {
+        case Globalization::None:
+            return "none";
+        case Globalization::LineSearch:
+            return "line-search";
+        case Globalization::Dogleg:
+            return "dogleg";
+        }
+        return "unknown";
+    }
+
+    constexpr std::string_view to_string(LinearPrecision precision)
+    {
+        switch (precision)
+        {
+        case LinearPrecision::Native:
+            return "native";
+        case LinearPrecision::Double:
+            return "double";
+        case LinearPrecision::Float:
+            return "float";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @brief Параметры итераций Ньютона x_{k+1} = x_k + λ s_k, J(x_k) s_k = -F(x_k).
+     *
+     * Остановка: ||F(x_k)|| < eps_F или ||s_k|| < eps_x * (1 + ||x_k||),
+     * не более max_iterations итераций.
+     */
+    template <FloatNumber T>
+    struct newton_options
+    {
+        Method method = Method::Newton;
+        JacobianMode jacobian = JacobianMode::Numeric;
+        NumericFormula formula = NumericFormula::TwoPoint;
+
+        /// Плотное разложение Якобиана в T или в double / float с уточнением в T
+        LinearPrecision linear_precision = LinearPrecision::Native;
+
+        std::size_t max_iterations = 50;
+        T eps_F = static_cast<T>(1e-12);
+        T eps_x = static_cast<T>(1e-12);
+
+        /// Демпфирование шага, λ в (0, 1]; для LineSearch — первое пробное λ
+        T lambda = static_cast<T>(1);
+
+        Globalization globalization = Globalization::None;
+
+        /// LineSearch: константа Армихо c в (0, 1/2)
+        T line_search_c = static_cast<T>(1e-4);
+
+        /// LineSearch / Dogleg: не более пробных вычислений F на итерацию (все отвергнуты — x_k не меняется)
+        std::size_t line_search_max_steps = 20;
+
+        /// Dogleg: начальный радиус Δ_0 (0 — длина первого шага Ньютона) и верхняя граница Δ
+        T trust_radius = static_cast<T>(0);
+        T trust_radius_max = static_cast<T>(1e8);
+
+        /// Методы Бройдена: сколько поправок накопить до нового построения Якобиана
+        std::size_t broyden_max_updates = 32;
+
+        /// Методы Бройдена: Якобиан строится заново, если ||F_{k+1}|| >= broyden_stall_ratio * ||F_k||
+        T broyden_stall_ratio = static_cast<T>(1);
+
+        /// JacobianFree: длина перезапуска GMRES(m) — память O(n m)
+        std::size_t krylov_restart = 30;
+
+        /// JacobianFree: не более шагов GMRES на одну итерацию Ньютона
+        std::size_t krylov_max_iterations = 300;
+
+        /// JacobianFree: GMRES останавливается при ||J s + F|| <= krylov_tolerance * ||F|| (неточный Ньютон)
+        T krylov_tolerance = static_cast<T>(1e-6);
+
+        /// Кэш разложений Якобиана между solve() (factorization_cache): предел памяти, байт (0 — выключен).
+        /// Не для JacobianFree
+        std::size_t cache_bytes = 0;
+
+        /// Кэш: разложение из J(x_c) берётся, если ||x0 - x_c|| <= cache_radius * (1 + ||x_c||)
+        T cache_radius = static_cast<T>(1e-2);
+
+        /// Кэш: разложение из кэша остаётся (как у модифицированного Ньютона), пока
+        /// ||F_{k+1}|| <= cache_contraction * ||F_k||; потом Якобиан строится как обычно
+        T cache_contraction = static_cast<T>(0.5);
+    };
+}
+
+#endif // MIV_MATH_NEWTON_OPTIONS_H
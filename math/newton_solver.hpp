@@ -0,0 +1,1381 @@
+#ifndef MIV_MATH_NEWTON_SOLVER_H
+#define MIV_MATH_NEWTON_SOLVER_H
+
+#include <cstddef>
+#include <cmath>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+
+#include "containers/array.hpp"
+#include "containers/matrix.hpp"
+#include "containers/matrix_view.hpp"
+#include "containers/profile.hpp"
+#include "containers/sparse_matrix.hpp"
+#include "containers/workspace.hpp"
+#include "math/helpers.hpp"   // FloatNumber, norm_t
+#include "math/linalg.hpp"    // norm_l2
+#include "math/system.hpp"    // system_size, evaluate_system
+#include "math/simd.hpp"      // dot
+#include "math/jacobian.hpp"
+#include "math/fixed_lu.hpp"
+#include "math/lu_factorization.hpp"
+#include "math/refinement.hpp"
+#include "math/factorization_cache.hpp"
+#include "math/sparse.hpp"
+#include "math/newton_options.hpp"
+#include "math/broyden.hpp"
+#include "math/gmres.hpp"
+#include "math/autodiff.hpp"
+#include "ad/dual.hpp"
+
+namespace miv::math
+{
+    /**
+     * @brief По какому критерию остановился метод.
+     */
+    enum class newton_stop
+    {
+        residual,         ///< ||F(x_k)|| < eps_F
+        step,             ///< ||s_k|| < eps_x * (1 + ||x_k||)
+        max_iterations,   ///< исчерпан лимит итераций
+        cancelled,        ///< остановлен условием set_stop_condition
+        no_decrease       ///< LineSearch / Dogleg: ни одна проба не уменьшила ||F|| при J(x_k)
+    };
+
+    /**
+     * @brief Имя критерия остановки (residual, step, max_iterations, cancelled, no_decrease).
+     */
+    constexpr std::string_view to_string(newton_stop stop)
+    {
+        switch (stop)
+        {
+        case newton_stop::residual:
+            return "residual";
+        case newton_stop::step:
+            return "step";
+        case newton_stop::max_iterations:
+            return "max_iterations";
+        case newton_stop::cancelled:
+            return "cancelled";
+        case newton_stop::no_decrease:
+            return "no_decrease";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @brief Данные одной итерации для callback-а журнала.
+     *
+     * Все view действительны только во время вызова callback-а.
+     * x_{k+1} = x + lambda * step: с LineSearch lambda — принятое λ_k,
+     * с Dogleg step — шаг в доверительной области, lambda = 1.
+     */
+    template <FloatNumber T>
+    struct newton_iteration
+    {
+        std::size_t k = 0;
+        miv::array_view<const T> x;      ///< x_k
+        miv::array_view<const T> fx;     ///< F(x_k)
+        miv::array_view<const T> step;   ///< s_k
+        norm_t fx_norm = 0;
+        norm_t step_norm = 0;
+        T lambda = static_cast<T>(1);
+
+        std::chrono::nanoseconds iteration_time{ 0 };   ///< F, Якобиан и шаг итерации k
+        std::chrono::nanoseconds elapsed{ 0 };          ///< от начала solve()
+    };
+
+    /**
+     * @brief Результат newton_solver::solve.
+     */
+    template <FloatNumber T>
+    struct newton_result
+    {
+        miv::array<T> x;                  ///< последнее приближение x*
+        norm_t residual_norm = 0;         ///< ||F(x*)||
+        std::size_t iterations = 0;       ///< выполненных итераций
+        bool converged = false;
+        newton_stop stop = newton_stop::max_iterations;
+        std::chrono::nanoseconds elapsed{ 0 };   ///< время solve()
+        std::size_t jacobian_builds = 0;  ///< построений и разложений Якобиана
+        std::size_t linear_iterations = 0;   ///< шагов GMRES (JacobianMode::JacobianFree)
+        std::size_t rejected_steps = 0;   ///< отвергнутых проб (LineSearch, Dogleg)
+        bool cache_hit = false;           ///< начато с разложения из кэша (options.cache_bytes)
+
+        /// Время и число вычислений F, построений Якобиана, разложений и подстановок,
+        /// выделения памяти (только при сборке с MIV_PROFILE, иначе нули)
+        miv::profile_counters profile;
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief Заглушка вместо mixed_lu_factorization<T, Low>, когда Low не грубее T.
+         */
+        struct no_mixed_lu
+        {
+        };
+
+        template <FloatNumber T, FloatNumber Low>
+        inline constexpr bool mixed_lu_useful_v = std::numeric_limits<Low>::digits < std::numeric_limits<T>::digits;
+
+        template <FloatNumber T, FloatNumber Low>
+        using mixed_lu_or_none =
+            std::conditional_t<mixed_lu_useful_v<T, Low>, mixed_lu_factorization<T, Low>, no_mixed_lu>;
+
+        /**
+         * @brief Плотное LUP-разложение с выбором ядра по размеру и точности.
+         *
+         * Малые системы (n <= max_fixed_size) — ядра фиксированного размера
+         * на стеке (small_lu_factorization), остальные — lu_factorization.
+         * LinearPrecision::Double / Float — mixed_lu_factorization при любом n.
+         */
+        template <FloatNumber T>
+        class dense_lu
+        {
+        public:
+            void factorize(const miv::matrix<T> &J, LinearPrecision precision = LinearPrecision::Native)
+            {
+                if constexpr (mixed_lu_useful_v<T, double>)
+                {
+                    if (precision == LinearPrecision::Double)
+                    {
+                        m_kernel = kernel::mixed_double;
+                        m_mixed_double.factorize(J);
+                        return;
+                    }
+                }
+                if constexpr (mixed_lu_useful_v<T, float>)
+                {
+                    if (precision == LinearPrecision::Float)
+                    {
+                        m_kernel = kernel::mixed_float;
+                        m_mixed_float.factorize(J);
+                        return;
+                    }
+                }
+
+                m_kernel = small_lu_factorization<T>::supports(J.rows()) ? kernel::small : kernel::full;
+
+                if (m_kernel == kernel::small)
+                {
+                    m_small.factorize(J);
+                }
+                else
+                {
+                    m_full.factorize(J);
+                }
+            }
+
+            template <typename Alloc>
+            void solve_inplace(miv::array<T, Alloc> &b)
+            {
+                switch (m_kernel)
+                {
+                case kernel::small:
+                    m_small.solve_inplace(b);
+                    break;
+                case kernel::full:
+                    m_full.solve_inplace(b);
+                    break;
+                case kernel::mixed_double:
+                    if constexpr (mixed_lu_useful_v<T, double>)
+                    {
+                        m_mixed_double.solve_inplace(b);
+                    }
+                    break;
+                case kernel::mixed_float:
+                    if constexpr (mixed_lu_useful_v<T, float>)
+                    {
+                        m_mixed_float.solve_inplace(b);
+                    }
+                    break;
+                }
+            }
+
+            /**
+             * @brief Объём разложения (для factorization_cache), байт.
+             */
+            std::size_t memory_bytes() const
+            {
+                switch (m_kernel)
+                {
+                case kernel::small:
+                    return sizeof(m_small);
+                case kernel::full:
+                    return m_full.n() * m_full.n() * sizeof(T) + m_full.n() * sizeof(std::size_t);
+                case kernel::mixed_double:
+                    if constexpr (mixed_lu_useful_v<T, double>)
+                    {
+                        return mixed_bytes<double>(m_mixed_double.n());
+                    }
+                    break;
+                case kernel::mixed_float:
+                    if constexpr (mixed_lu_useful_v<T, float>)
+                    {
+                        return mixed_bytes<float>(m_mixed_float.n());
+                    }
+                    break;
+                }
+                return 0;
+            }
+
+        private:
+            enum class kernel : unsigned char
+            {
+                small,
+                full,
+                mixed_double,
+                mixed_float
+            };
+
+            // A в T, её копия в Low и разложение в Low, перестановка, три буфера уточнения
+            template <FloatNumber Low>
+            static std::size_t mixed_bytes(std::size_t n)
+            {
+                return n * n * (sizeof(T) + 2 * sizeof(Low)) + n * sizeof(std::size_t) + 3 * n * sizeof(T);
+            }
+
+            small_lu_factorization<T> m_small;
+            lu_factorization<T> m_full;
+            mixed_lu_or_none<T, double> m_mixed_double;
+            mixed_lu_or_none<T, float> m_mixed_float;
+            kernel m_kernel = kernel::full;
+        };
+    }
+
+    /**
+     * @brief Метод Ньютона / модифицированный метод Ньютона для F(x) = 0.
+     *
+     * Итерация: J(x_k) s_k = -F(x_k), x_{k+1} = x_k + λ s_k. Якобиан — численный
+     * (плотный или разреженный, см. JacobianMode), точный по автоматическому
+     * дифференцированию либо заданная вручную матрица.
+     * В методах Бройдена разложение J(x_0) дополняется поправками ранга 1
+     * (broyden_updates); Якобиан строится заново, когда ||F|| перестаёт убывать,
+     * поправка вырождена или их накопилось broyden_max_updates.
+     * В режиме JacobianFree Якобиан не хранится: шаг решает GMRES(m) по
+     * разностным произведениям J v (с предобуславливателем, если он есть).
+     * Globalization::LineSearch и Dogleg вместо постоянного λ подбирают шаг по
+     * убыванию ||F||; F в принятой пробной точке становится F(x_{k+1}), так что
+     * ни одна невязка не вычисляется дважды. Если все пробы отвергнуты, x не
+     * меняется: устаревший Якобиан (замороженный, Бройдена, из кэша) строится
+     * заново в x_k, а при уже построенном J(x_k) solve() останавливается с
+     * newton_stop::no_decrease.
+     * options.linear_precision = Double / Float раскладывает плотный Якобиан в
+     * double / float и уточняет шаг невязками в T (mixed_lu_factorization).
+     * С options.cache_bytes > 0 решатель помнит разложения J(x0) прошлых solve()
+     * (LRU, factorization_cache): старт рядом с запомненной точкой начинается с
+     * этого разложения как модифицированный Ньютон, пока ||F|| убывает не медленнее
+     * cache_contraction, — без построения и разложения Якобиана на первых итерациях.
+     * Кэш относится к одной системе: при смене системы — clear_cache(); смена
+     * options().jacobian, formula или linear_precision очищает его сама.
+     *
+     * @code
+     * miv::math::newton_options<double> opt;
+     * opt.method = miv::math::Method::ModifiedNewton;
+     *
+     * miv::math::newton_solver<double> solver(opt);
+     * auto result = solver.solve(functions, x0);   // result.x, result.iterations, ...
+     * @endcode
+     *
+     * Буферы (F, Якобиан, разложение, workspace) живут в объекте: повторные solve()
+     * для системы той же размерности не выделяют память в цикле итераций.
+     * Журнал — необязательный callback, вызываемый на каждой итерации с view на
+     * данные итерации; без callback-а цикл не формирует никаких строк и не
+     * замеряет время итераций.
+     *
+     * Система — вектор функций fi(miv::array<T>&) -> T или vector_system
+     * (одна f(x, out) на все компоненты, см. math/system.hpp).
+     */
+    template <FloatNumber T>
+    class newton_solver
+    {
+    public:
+        using value_t = T;
+        using iteration_callback = std::function<void(const newton_iteration<T> &)>;
+        using stop_condition = std::function<bool(const newton_iteration<T> &)>;
+        using preconditioner = std::function<void(miv::array_view<T>)>;
+
+        newton_solver() = default;
+
+        explicit newton_solver(newton_options<T> options) : m_options(std::move(options)) {}
+
+        /**
+         * @brief Параметры метода (действуют на следующий solve()).
+         */
+        newton_options<T> &options() { return m_options; }
+        const newton_options<T> &options() const { return m_options; }
+
+        /**
+         * @brief Callback журнала итераций (пустой — журнал выключен).
+         */
+        void set_iteration_callback(iteration_callback callback)
+        {
+            m_on_iteration = std::move(callback);
+        }
+
+        /**
+         * @brief Кооперативная остановка: проверяется на каждой итерации после callback-а журнала.
+         *
+         * true — solve() завершается в x_k с newton_stop::cancelled (шаг s_k не делается,
+         * ||F(x_k)|| уже известна). Критерии сходимости этой итерации важнее.
+         * Вызывается из потока solve(): одному решателю — одно условие.
+         */
+        void set_stop_condition(stop_condition condition)
+        {
+            m_stop_condition = std::move(condition);
+        }
+
+        /**
+         * @brief Матрица Якоби для JacobianMode::Manual (постоянная на всех итерациях).
+         *
+         * @throws std::invalid_argument если J не квадратная
+         */
+        void set_manual_jacobian(miv::matrix<T> J)
+        {
+            require_squareness(J);
+            m_J_manual = std::move(J);
+            clear_cache();
+        }
+
+        /**
+         * @brief Система от dual<T, N> для JacobianMode::Automatic.
+         *
+         * Та же система, что передаётся в solve(), но инстанцированная для
+         * miv::ad::dual<T, N>: N столбцов Якобиана за один проход. Вектор
+         * функций или vector_system с шаблонным f (тогда это тот же объект).
+         *
+         * @code
+         * solver.set_automatic_jacobian<4>(dual_functions);
+         * @endcode
+         */
+        template <std::size_t N, typename System>
+        void set_automatic_jacobian(System functions)
+        {
+            m_automatic_size = system_size(functions);
+            m_automatic = [functions = std::move(functions), builder = automatic_jacobian_builder<T, N>()](
+                              const miv::array<T> &x, miv::matrix<T> &J) mutable
+            {
+                builder.build(x, functions, J);
+            };
+            clear_cache();
+        }
+
+        /**
+         * @brief То же для указателей на функции: N выводится из типа.
+         */
+        template <std::size_t N>
+        void set_automatic_jacobian(std::vector<miv::ad::dual<T, N> (*)(miv::array<miv::ad::dual<T, N>> &)> functions)
+        {
+            using dual_fn = miv::ad::dual<T, N> (*)(miv::array<miv::ad::dual<T, N>> &);
+            set_automatic_jacobian<N, std::vector<dual_fn>>(std::move(functions));
+        }
+
+        /**
+         * @brief Шаблон разреженности для JacobianMode::Sparse; раскраска столбцов — здесь же.
+         *
+         * Если шаблон не задан, solve() находит его численно в начальной точке
+         * (detect_sparsity).
+         */
+        void set_sparsity(sparsity_pattern pattern)
+        {
+            m_sparse_builder = std::make_unique<sparse_jacobian_builder<T>>(std::move(pattern));
+            m_lu_sparse = sparse_lu<T>();
+            clear_cache();
+        }
+
+        /**
+         * @brief Текущий построитель разреженного Якобиана (nullptr, если шаблона ещё нет).
+         */
+        const sparse_jacobian_builder<T> *sparse_builder() const { return m_sparse_builder.get(); }
+
+        /**
+         * @brief Правый предобуславливатель GMRES для JacobianMode::JacobianFree.
+         *
+         * p(v) заменяет v на M^{-1} v, где M ≈ J. Пустой — без пользовательского
+         * предобуславливателя: с ModifiedNewton тогда используется разложение
+         * численного J(x0), с Newton — никакого.
+         */
+        void set_preconditioner(preconditioner p)
+        {
+            m_preconditioner = std::move(p);
+        }
+
+        /**
+         * @brief Забыть запомненные разложения (options.cache_bytes).
+         */
+        void clear_cache()
+        {
+            m_cache_dense.clear();
+            m_cache_sparse.clear();
+        }
+
+        /**
+         * @brief Записей в кэше разложений, попаданий и промахов за время жизни решателя.
+         */
+        std::size_t cache_size() const { return m_cache_dense.size() + m_cache_sparse.size(); }
+        std::size_t cache_hits() const { return m_cache_dense.hits() + m_cache_sparse.hits(); }
+        std::size_t cache_misses() const { return m_cache_dense.misses() + m_cache_sparse.misses(); }
+
+        /**
+         * @brief Решить F(x) = 0 из начального приближения x0.
+         *
+         * Особые ситуации (вырожденный Якобиан, неверные размеры) — исключения,
+         * как у разложений; результат при этом не возвращается.
+         *
+         * @throws std::invalid_argument если система пуста, x0 неверной длины,
+         *         ручной Якобиан не задан / не того размера или Якобиан вырожден
+         */
+        template <typename System>
+        newton_result<T> solve(const System &functions, miv::array<T> x0)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            newton_result<T> result;
+            MIV_PROFILE_RECORD_INTO(&result.profile);
+
+            const std::size_t n = system_size(functions);
+            prepare(functions, x0);
+
+            result.x = std::move(x0);
+            miv::array<T> &x = result.x;
+
+            const newton_options<T> &opt = m_options;
+
+            // Замороженный Якобиан раскладывается один раз: дальше каждая итерация стоит O(n^2).
+            // Без Якобиана это предобуславливатель GMRES — если пользователь не задал свой.
+            const bool own_preconditioner = opt.jacobian == JacobianMode::JacobianFree && m_preconditioner;
+            bool fx_current = false;    // m_fx = F(x) уже посчитан (в x0 или в принятой пробной точке)
+
+            // Разложение из кэша вместо J(x0): Ньютон идёт на нём, пока ||F|| быстро убывает
+            m_cache_stored = false;
+            result.cache_hit = restore_factorization(x);
+            const bool broyden = is_broyden(opt.method);
+            bool warm = result.cache_hit && !broyden;
+            norm_t warm_fx_norm = 0;
+
+            bool jacobian_current = false;   // Якобиан разложения построен в текущем x
+
+            if (opt.method == Method::ModifiedNewton && !own_preconditioner && !result.cache_hit)
+            {
+                compute_F(functions, x);
+                fx_current = true;
+                update_jacobian(functions, x);
+                ++result.jacobian_builds;
+                jacobian_current = true;
+            }
+
+            bool rebuild = !result.cache_hit;   // Бройден: построить Якобиан в текущей точке
+            norm_t prev_fx_norm = 0;
+            norm_t radius = static_cast<norm_t>(opt.trust_radius);   // Dogleg: Δ_k
+            bool refresh = false;       // ModifiedNewton: замороженный J не дал убывания — разложить заново
+
+            for (std::size_t k = 0; k < opt.max_iterations; ++k)
+            {
+                result.iterations = k + 1;
+                m_ws.reset();
+
+                const auto iteration_start = (m_on_iteration || m_stop_condition)
+                    ? std::chrono::steady_clock::now()
+                    : std::chrono::steady_clock::time_point{};
+
+                if (!fx_current)
+                {
+                    compute_F(functions, x);
+                    fx_current = true;
+                }
+                const norm_t fx_norm = norm_l2(m_fx);
+
+                if (fx_norm < static_cast<norm_t>(opt.eps_F))
+                {
+                    result.converged = true;
+                    result.stop = newton_stop::residual;
+                    break;
+                }
+
+                // Разложение из кэша устарело: дальше — как без кэша
+                if (warm && k > 0 && fx_norm > static_cast<norm_t>(opt.cache_contraction) * warm_fx_norm)
+                {
+                    warm = false;
+                    refresh = opt.method == Method::ModifiedNewton;
+                }
+                warm_fx_norm = fx_norm;
+
+                if (((opt.method == Method::Newton && !warm) || refresh) && opt.jacobian != JacobianMode::JacobianFree)
+                {
+                    update_jacobian(functions, x);
+                    ++result.jacobian_builds;
+                    refresh = false;
+                    jacobian_current = true;
+                }
+                else if (broyden)
+                {
+                    // Застой (||F|| не убывает) — поправки больше не помогают
+                    if (!rebuild && k > 0)
+                    {
+                        rebuild = fx_norm >= static_cast<norm_t>(opt.broyden_stall_ratio) * prev_fx_norm ||
+                                  !broyden_update();
+                    }
+
+                    if (rebuild)
+                    {
+                        update_jacobian(functions, x);
+                        m_broyden.clear();
+                        ++result.jacobian_builds;
+                        rebuild = false;
+                        jacobian_current = true;
+                    }
+                }
+
+                miv::array<T, miv::workspace_allocator<T>> step(n, m_ws);
+                if (opt.jacobian == JacobianMode::JacobianFree)
+                {
+                    result.linear_iterations += solve_step_krylov(functions, x, step);
+                }
+                else
+                {
+                    solve_step(step);
+                }
+
+                const norm_t step_norm = norm_l2(step);
+                const norm_t x_norm = norm_l2(x);
+
+                const norm_t step_threshold =
+                    static_cast<norm_t>(opt.eps_x) * (static_cast<norm_t>(1) + x_norm);
+                const bool step_small = step_norm < step_threshold;
+
+                // Пробы пишут x + λ s и F в m_x_trial / m_f_trial; принятая — следующие x, F
+                const bool globalized = opt.globalization != Globalization::None && !step_small;
+                T lambda = opt.lambda;
+                step_outcome outcome = step_outcome::accepted;
+                if (globalized && opt.globalization == Globalization::LineSearch)
+                {
+                    outcome = line_search(functions, x, step, fx_norm, lambda, result.rejected_steps);
+                }
+                else if (globalized)
+                {
+                    lambda = static_cast<T>(1);
+                    outcome = dogleg_step(functions, x, step, fx_norm, radius, result.rejected_steps);
+                }
+
+                // Первая проба отвергнута: устаревший Якобиан (замороженный / Бройдена) строится заново
+                if (outcome != step_outcome::accepted)
+                {
+                    refresh = opt.method == Method::ModifiedNewton;
+                    rebuild = broyden;
+                    warm = false;
+                }
+
+                // Все пробы отвергнуты: x_k остаётся; с J(x_k) улучшать уже нечего
+                const bool rejected = outcome == step_outcome::failed;
+                if (rejected)
+                {
+                    lambda = static_cast<T>(0);
+                }
+
+                bool cancelled = false;
+                if (m_on_iteration || m_stop_condition)
+                {
+                    newton_iteration<T> info;
+                    info.k = k;
+                    info.x = miv::array_view<const T>(x.data(), n);
+                    info.fx = miv::array_view<const T>(m_fx.data(), n);
+                    info.step = miv::array_view<const T>(step.data(), n);
+                    info.fx_norm = fx_norm;
+                    info.step_norm = globalized ? norm_l2(step) : step_norm;
+                    info.lambda = lambda;
+
+                    const auto now = std::chrono::steady_clock::now();
+                    info.iteration_time = std::chrono::duration_cast<std::chrono::nanoseconds>(now - iteration_start);
+                    info.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start);
+
+                    if (m_on_iteration)
+                    {
+                        MIV_PROFILE_SCOPE(callback);
+                        m_on_iteration(info);
+                    }
+
+                    cancelled = m_stop_condition && m_stop_condition(info);
+                }
+
+                if (step_small)
+                {
+                    result.converged = true;
+                    result.stop = newton_stop::step;
+                    break;
+                }
+
+                if (cancelled)
+                {
+                    result.stop = newton_stop::cancelled;
+                    break;
+                }
+
+                if (rejected)
+                {
+                    if (jacobian_current || opt.jacobian == JacobianMode::JacobianFree)
+                    {
+                        result.stop = newton_stop::no_decrease;
+                        break;
+                    }
+                    continue;
+                }
+
+                if (broyden)
+                {
+                    // Для поправки на следующей итерации: dx = λ s_k, F(x_k)
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        m_dx[i] = lambda * step[i];
+                    }
+                    std::copy(m_fx.data(), m_fx.data() + n, m_fx_prev.data());
+                    prev_fx_norm = fx_norm;
+                }
+
+                if (globalized)
+                {
+                    std::swap(x, m_x_trial);
+                    std::swap(m_fx, m_f_trial);
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        x[i] += lambda * step[i];
+                    }
+                    fx_current = false;
+                }
+                jacobian_current = false;
+            }
+
+            if (!fx_current)
+            {
+                compute_F(functions, x);
+            }
+            result.residual_norm = norm_l2(m_fx);
+            result.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start);
+
+            return result;
+        }
+
+    private:
+        /**
+         * @brief Исход line_search / dogleg_step.
+         */
+        enum class step_outcome
+        {
+            accepted,   ///< принята первая проба
+            fallback,   ///< принята после укорочения шага
+            failed      ///< все пробы отвергнуты: x и F(x) не меняются
+        };
+
+        template <typename System>
+        void prepare(const System &functions, miv::array<T> &x0)
+        {
+            const std::size_t n = system_size(functions);
+
+            if (n == 0)
+            {
+                throw std::invalid_argument("newton_solver::solve(): the system has no functions");
+            }
+
+            if (x0.size() != n)
+            {
+                throw std::invalid_argument(
+                    "newton_solver::solve(): x0 must have length n = " + std::to_string(n) +
+                    ", but got " + std::to_string(x0.size()));
+            }
+
+            if (m_options.lambda <= static_cast<T>(0) || m_options.lambda > static_cast<T>(1))
+            {
+                throw std::invalid_argument("newton_solver::solve(): lambda must be in (0, 1]");
+            }
+
+            prepare_globalization(n);
+
+            if (m_options.cache_bytes > 0 &&
+                !(m_options.cache_radius >= static_cast<T>(0) && m_options.cache_contraction > static_cast<T>(0)))
+            {
+                throw std::invalid_argument(
+                    "newton_solver::solve(): cache_radius must be >= 0 and cache_contraction positive");
+            }
+
+            switch (m_options.jacobian)
+            {
+            case JacobianMode::Manual:
+                if (m_J_manual.rows() != n)
+                {
+                    throw std::invalid_argument(
+                        "newton_solver::solve(): manual Jacobian must be " + std::to_string(n) + "x" +
+                        std::to_string(n) + " (set_manual_jacobian)");
+                }
+                break;
+
+            case JacobianMode::Sparse:
+                // Шаблон (заданный или найденный в x0) и раскраска — один раз
+                if (!m_sparse_builder || m_sparse_builder->pattern().rows != n)
+                {
+                    set_sparsity(detect_sparsity(x0, functions));
+                }
+                break;
+
+            case JacobianMode::JacobianFree:
+                if (is_broyden(m_options.method))
+                {
+                    throw std::invalid_argument("newton_solver::solve(): Broyden methods need an explicit Jacobian");
+                }
+                m_xp.resize(n, miv::uninitialized);
+                m_pc.resize(n, miv::uninitialized);
+                break;
+
+            case JacobianMode::Automatic:
+                if (!m_automatic || m_automatic_size != n)
+                {
+                    throw std::invalid_argument(
+                        "newton_solver::solve(): automatic Jacobian needs " + std::to_string(n) +
+                        " dual functions (set_automatic_jacobian)");
+                }
+                break;
+
+            case JacobianMode::Numeric:
+                break;
+            }
+
+            if (is_broyden(m_options.method))
+            {
+                const broyden_kind kind =
+                    (m_options.method == Method::BroydenGood) ? broyden_kind::good : broyden_kind::bad;
+                m_broyden.reset(kind, n, std::max<std::size_t>(m_options.broyden_max_updates, 1));
+                m_dx.resize(n, miv::uninitialized);
+                m_fx_prev.resize(n, miv::uninitialized);
+            }
+            else
+            {
+                m_broyden.clear();
+            }
+        }
+
+        /**
+         * @brief Проверить параметры LineSearch / Dogleg и подготовить буферы проб.
+         */
+        void prepare_globalization(std::size_t n)
+        {
+            const newton_options<T> &opt = m_options;
+            if (opt.globalization == Globalization::None)
+            {
+                return;
+            }
+
+            if (opt.line_search_max_steps == 0)
+            {
+                throw std::invalid_argument("newton_solver::solve(): line_search_max_steps must be positive");
+            }
+
+            if (opt.globalization == Globalization::LineSearch &&
+                !(opt.line_search_c > static_cast<T>(0) && opt.line_search_c < static_cast<T>(0.5)))
+            {
+                throw std::invalid_argument("newton_solver::solve(): line_search_c must be in (0, 1/2)");
+            }
+
+            if (opt.globalization == Globalization::Dogleg)
+            {
+                if (is_broyden(opt.method) || opt.jacobian == JacobianMode::JacobianFree)
+                {
+                    throw std::invalid_argument(
+                        "newton_solver::solve(): dogleg needs an explicit Jacobian (Newton or ModifiedNewton, "
+                        "not jacobian-free)");
+                }
+
+                if (!(opt.trust_radius >= static_cast<T>(0)) || !(opt.trust_radius_max > static_cast<T>(0)))
+                {
+                    throw std::invalid_argument(
+                        "newton_solver::solve(): trust_radius must be >= 0 and trust_radius_max > 0");
+                }
+            }
+
+            m_x_trial.resize(n, miv::uninitialized);
+            if (m_f_trial.rows() != n || m_f_trial.cols() != 1)
+            {
+                m_f_trial = miv::matrix<T>(n, 1, miv::uninitialized);
+            }
+        }
+
+        /**
+         * @brief F(x) в m_fx (n x 1): та же форма — без выделений.
+         */
+        template <typename System>
+        void compute_F(const System &functions, miv::array<T> &x)
+        {
+            const std::size_t n = system_size(functions);
+            if (m_fx.rows() != n || m_fx.cols() != 1)
+            {
+                m_fx = miv::matrix<T>(n, 1, miv::uninitialized);
+            }
+
+            evaluate_system(functions, x, m_fx.data());
+        }
+
+
+        /**
+         * @brief Построить и разложить J(x) выбранным способом (m_fx = F(x) уже посчитан).
+         */
+        template <typename System>
+        void update_jacobian(const System &functions, miv::array<T> &x)
+        {
+            switch (m_options.jacobian)
+            {
+            case JacobianMode::Numeric:
+                if (m_options.formula == NumericFormula::TwoPoint)
+                {
+                    m_builder.build_two_point(x, functions, m_fx, m_J);
+                }
+                else
+                {
+                    m_builder.build_three_point(x, functions, m_J);
+                }
+                m_lu.factorize(m_J, m_options.linear_precision);
+                break;
+
+            case JacobianMode::Sparse:
+                if (m_options.formula == NumericFormula::TwoPoint)
+                {
+                    m_sparse_builder->build_two_point(x, functions, m_fx.data(), m_J_sparse);
+                }
+                else
+                {
+                    m_sparse_builder->build_three_point(x, functions, m_J_sparse);
+                }
+
+                // Структура J не меняется: упорядочение столбцов считается один раз
+                if (m_lu_sparse.empty())
+                {
+                    m_lu_sparse.factorize(m_J_sparse);
+                }
+                else
+                {
+                    m_lu_sparse.refactorize(m_J_sparse);
+                }
+                break;
+
+            case JacobianMode::Manual:
+                m_lu.factorize(m_J_manual, m_options.linear_precision);
+                break;
+
+            case JacobianMode::Automatic:
+                m_automatic(x, m_J);
+                m_lu.factorize(m_J, m_options.linear_precision);
+                break;
+
+            case JacobianMode::JacobianFree:
+                // Только ModifiedNewton: разложение J(x0) — предобуславливатель GMRES
+                m_builder.build_two_point(x, functions, m_fx, m_J);
+                m_lu.factorize(m_J, m_options.linear_precision);
+                break;
+            }
+
+            remember_factorization(x);
+        }
+
+        /**
+         * @brief Кэш разложений включён и применим (нет для JacobianFree; Dogleg нужен сам J, не только LU).
+         */
+        bool cache_usable() const
+        {
+            return m_options.cache_bytes > 0 && m_options.jacobian != JacobianMode::JacobianFree &&
+                   m_options.globalization != Globalization::Dogleg;
+        }
+
+        /**
+         * @brief Взять из кэша разложение Якобиана в точке рядом с x.
+         *
+         * @return true, если m_lu / m_lu_sparse заменены разложением из кэша
+         */
+        bool restore_factorization(const miv::array<T> &x)
+        {
+            if (!cache_usable())
+            {
+                return false;
+            }
+
+            // Разложения другого источника Якобиана, формулы или точности не подходят
+            if (m_cache_jacobian != m_options.jacobian || m_cache_formula != m_options.formula ||
+                m_cache_precision != m_options.linear_precision)
+            {
+                clear_cache();
+                m_cache_jacobian = m_options.jacobian;
+                m_cache_formula = m_options.formula;
+                m_cache_precision = m_options.linear_precision;
+            }
+
+            const norm_t radius = static_cast<norm_t>(m_options.cache_radius);
+            if (m_options.jacobian == JacobianMode::Sparse)
+            {
+                m_cache_sparse.set_capacity(m_options.cache_bytes);
+                if (const auto *cached = m_cache_sparse.find(x, radius))
+                {
+                    m_lu_sparse = *cached;
+                    return true;
+                }
+                return false;
+            }
+
+            m_cache_dense.set_capacity(m_options.cache_bytes);
+            if (const auto *cached = m_cache_dense.find(x, radius))
+            {
+                m_lu = *cached;
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Запомнить первое разложение solve() с точкой x, где строился Якобиан.
+         */
+        void remember_factorization(const miv::array<T> &x)
+        {
+            if (m_cache_stored || !cache_usable())
+            {
+                return;
+            }
+            m_cache_stored = true;
+
+            if (m_options.jacobian == JacobianMode::Sparse)
+            {
+                m_cache_sparse.insert(x, m_lu_sparse, m_lu_sparse.memory_bytes());
+            }
+            else
+            {
+                m_cache_dense.insert(x, m_lu, m_lu.memory_bytes());
+            }
+        }
+
+        /**
+         * @brief b := J^{-1} b по текущему разложению (без поправок Бройдена).
+         */
+        template <typename Alloc>
+        void solve_base(miv::array<T, Alloc> &b)
+        {
+            if (m_options.jacobian == JacobianMode::Sparse)
+            {
+                m_lu_sparse.solve_inplace(b, m_ws);
+            }
+            else
+            {
+                m_lu.solve_inplace(b);
+            }
+        }
+
+        /**
+         * @brief J s = -F(x) по текущему разложению (и поправкам Бройдена).
+         */
+        template <typename Alloc>
+        void solve_step(miv::array<T, Alloc> &step)
+        {
+            const std::size_t n = step.size();
+            const T *f = m_fx.data();
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                step[i] = -f[i];
+            }
+
+            solve_base(step);
+
+            if (m_broyden.size() > 0)
+            {
+                miv::array<T, miv::workspace_allocator<T>> rhs(n, m_ws);
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    rhs[i] = -f[i];
+                }
+                m_broyden.apply(step.data(), rhs.data());
+            }
+        }
+
+        /**
+         * @brief J s = -F(x) методом GMRES без Якобиана.
+         *
+         * J v ≈ (F(x + εv) - F(x)) / ε, ε = sqrt(eps) (1 + ||x||) / ||v||:
+         * одно вычисление F на произведение.
+         *
+         * @return число шагов GMRES
+         */
+        template <typename System, typename Alloc>
+        std::size_t solve_step_krylov(const System &functions, miv::array<T> &x, miv::array<T, Alloc> &step)
+        {
+            const std::size_t n = step.size();
+            const T *f = m_fx.data();
+
+            miv::array<T, miv::workspace_allocator<T>> rhs(n, m_ws);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                rhs[i] = -f[i];
+                step[i] = T{};
+            }
+
+            const T fd_base = std::sqrt(std::numeric_limits<T>::epsilon()) *
+                              (static_cast<T>(1) + static_cast<T>(norm_l2(x)));
+
+            auto apply = [&](const T *v, T *out)
+            {
+                const T v_norm = static_cast<T>(std::sqrt(simd::dot(n, v, v)));
+                if (v_norm == T{})
+                {
+                    std::fill(out, out + n, T{});
+                    return;
+                }
+
+                const T eps = fd_base / v_norm;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    m_xp[i] = x[i] + eps * v[i];
+                }
+
+                evaluate_system(functions, m_xp, out);
+
+                const T inv = static_cast<T>(1) / eps;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    out[i] = (out[i] - f[i]) * inv;
+                }
+            };
+
+            const bool frozen_lu = !m_preconditioner && m_options.method == Method::ModifiedNewton;
+            auto precondition = [&](T *v)
+            {
+                if (m_preconditioner)
+                {
+                    m_preconditioner(miv::array_view<T>(v, n));
+                }
+                else if (frozen_lu)
+                {
+                    std::copy(v, v + n, m_pc.data());
+                    m_lu.solve_inplace(m_pc);
+                    std::copy(m_pc.begin(), m_pc.end(), v);
+                }
+            };
+
+            gmres_options gmres;
+            gmres.restart = m_options.krylov_restart;
+            gmres.max_iterations = m_options.krylov_max_iterations;
+            gmres.tolerance = static_cast<norm_t>(m_options.krylov_tolerance);
+
+            return m_gmres.solve(n, apply, precondition, rhs.data(), step.data(), gmres).iterations;
+        }
+
+        /**
+         * @brief F в пробной точке m_x_trial = x + scale * s (в m_f_trial).
+         *
+         * @return ||F(x + scale * s)||^2 (+inf, если F не конечна)
+         */
+        template <typename System, typename Alloc>
+        norm_t evaluate_trial(const System &functions, const miv::array<T> &x, const miv::array<T, Alloc> &s, T scale)
+        {
+            const std::size_t n = x.size();
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                m_x_trial[i] = x[i] + scale * s[i];
+            }
+
+            evaluate_system(functions, m_x_trial, m_f_trial.data());
+
+            const norm_t norm = norm_l2(m_f_trial);
+            return std::isfinite(norm) ? norm * norm : std::numeric_limits<norm_t>::infinity();
+        }
+
+        /**
+         * @brief Дробление шага по Армихо от λ = options.lambda.
+         *
+         * Проба принимается при ||F(x + λ s)||^2 <= (1 - 2 c λ) ||F(x)||^2
+         * (достаточное убывание φ(λ) = ||F(x + λ s)||^2 / 2, φ'(0) = -||F||^2 для J s = -F).
+         * Следующее λ — минимум квадратичной интерполяции φ, ограниченный [0.1 λ, 0.5 λ],
+         * не больше line_search_max_steps проб.
+         *
+         * @param lambda принятое λ; m_x_trial, m_f_trial — точка и F в ней
+         * @return accepted — принято первое λ; fallback — меньшее (направление s плохое —
+         *         пора обновить J); failed — ни одно (m_x_trial, m_f_trial не годятся)
+         */
+        template <typename System, typename Alloc>
+        step_outcome line_search(const System &functions, const miv::array<T> &x, const miv::array<T, Alloc> &step,
+                         norm_t fx_norm, T &lambda, std::size_t &rejected)
+        {
+            const norm_t f0 = fx_norm * fx_norm;
+            const norm_t c = static_cast<norm_t>(m_options.line_search_c);
+
+            lambda = m_options.lambda;
+            for (std::size_t trial = 1;; ++trial)
+            {
+                const norm_t ft = evaluate_trial(functions, x, step, lambda);
+                const norm_t l = static_cast<norm_t>(lambda);
+
+                if (ft <= (static_cast<norm_t>(1) - 2 * c * l) * f0)
+                {
+                    return (trial == 1) ? step_outcome::accepted : step_outcome::fallback;
+                }
+                ++rejected;
+                if (trial >= m_options.line_search_max_steps)
+                {
+                    return step_outcome::failed;
+                }
+
+                // Знаменатель > 0, раз условие Армихо не выполнено
+                const norm_t quadratic = std::isfinite(ft) ? f0 * l * l / (ft - f0 + 2 * f0 * l) : 0;
+                lambda = static_cast<T>(std::clamp(quadratic, l / 10, l / 2));
+            }
+        }
+
+        /**
+         * @brief Шаг dogleg в доверительной области (step: шаг Ньютона -> принятый шаг).
+         *
+         * Модель m(s) = ||F + J s||^2 с тем же J, что в разложении: точка Коши
+         * s_c = -(||g||^2 / ||J g||^2) g, g = J^T F; шаг — s_N, если ||s_N|| <= Δ,
+         * иначе точка на ломаной 0 -> s_c -> s_N с ||s|| = Δ. J s известен без
+         * умножений: J s_N = -F, J s_c = -t J g. ρ = (||F||^2 - ||F(x + s)||^2) / (||F||^2 - m(s)):
+         * при ρ < 1/4 Δ делится на 4, при ρ > 3/4 на границе — удваивается (до trust_radius_max).
+         * Проба отвергается при ρ <= 1e-4 (или не конечной F), проб не больше line_search_max_steps.
+         *
+         * @return accepted — принята первая проба; fallback — после уменьшения Δ (модель
+         *         с этим J плохая); failed — ни одна
+         */
+        template <typename System, typename Alloc>
+        step_outcome dogleg_step(const System &functions, const miv::array<T> &x, miv::array<T, Alloc> &step,
+                         norm_t fx_norm, norm_t &radius, std::size_t &rejected)
+        {
+            const std::size_t n = x.size();
+            const T *f = m_fx.data();
+            const norm_t f0 = fx_norm * fx_norm;
+            const norm_t radius_max = static_cast<norm_t>(m_options.trust_radius_max);
+
+            miv::array<T, miv::workspace_allocator<T>> newton(n, m_ws);
+            miv::array<T, miv::workspace_allocator<T>> g(n, m_ws);
+            miv::array<T, miv::workspace_allocator<T>> jg(n, m_ws);
+            std::copy(step.begin(), step.end(), newton.begin());
+
+            jacobian_multiply_transposed(f, g.data());
+            jacobian_multiply(g.data(), jg.data());
+
+            const norm_t newton_norm = norm_l2(newton);
+            const norm_t g_norm = norm_l2(g);
+            const norm_t jg_norm = norm_l2(jg);
+            const norm_t t = (jg_norm > 0) ? (g_norm / jg_norm) * (g_norm / jg_norm) : 0;
+            const norm_t cauchy_norm = t * g_norm;
+
+            if (!(radius > 0))
+            {
+                radius = std::min(newton_norm, radius_max);
+            }
+
+            for (std::size_t trial = 1;; ++trial)
+            {
+                // s = a s_N - b g, J s = -a F - b J g
+                norm_t a = 1;
+                norm_t b = 0;
+                if (newton_norm > radius)
+                {
+                    if (t == 0)
+                    {
+                        a = radius / newton_norm;
+                    }
+                    else if (cauchy_norm >= radius)
+                    {
+                        a = 0;
+                        b = radius / g_norm;
+                    }
+                    else
+                    {
+                        // ||s_c + τ (s_N - s_c)|| = Δ, τ в [0, 1]
+                        norm_t dd = 0;
+                        norm_t cd = 0;
+                        for (std::size_t i = 0; i < n; ++i)
+                        {
+                            const norm_t ci = -t * static_cast<norm_t>(g[i]);
+                            const norm_t di = static_cast<norm_t>(newton[i]) - ci;
+                            dd += di * di;
+                            cd += ci * di;
+                        }
+                        const norm_t cc = cauchy_norm * cauchy_norm;
+                        const norm_t tau = (-cd + std::sqrt(cd * cd + dd * (radius * radius - cc))) / dd;
+                        a = tau;
+                        b = (1 - tau) * t;
+                    }
+                }
+
+                norm_t model = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    step[i] = static_cast<T>(a * newton[i] - b * g[i]);
+                    const norm_t r = (1 - a) * f[i] - b * jg[i];
+                    model += r * r;
+                }
+
+                const norm_t step_norm = norm_l2(step);
+                const norm_t ft = evaluate_trial(functions, x, step, static_cast<T>(1));
+                const norm_t predicted = f0 - model;
+                const norm_t actual = f0 - ft;
+                const bool accept = std::isfinite(ft) && predicted > 0 && actual > static_cast<norm_t>(1e-4) * predicted;
+
+                if (!accept || actual < predicted / 4)
+                {
+                    radius = step_norm / 4;
+                }
+                else if (actual > 3 * predicted / 4 && step_norm >= radius * static_cast<norm_t>(0.99))
+                {
+                    radius = std::min(2 * radius, radius_max);
+                }
+
+                if (accept)
+                {
+                    return (trial == 1) ? step_outcome::accepted : step_outcome::fallback;
+                }
+                ++rejected;
+                if (trial >= m_options.line_search_max_steps)
+                {
+                    return step_outcome::failed;
+                }
+            }
+        }
+
+        /**
+         * @brief Явный Якобиан текущего разложения (Dogleg): out = J v и out = J^T v.
+         */
+        void jacobian_multiply(const T *v, T *out) const
+        {
+            const std::size_t n = m_fx.rows();
+            if (m_options.jacobian == JacobianMode::Sparse)
+            {
+                const auto &offsets = m_J_sparse.row_offsets();
+                const auto &indices = m_J_sparse.col_indices();
+                const auto &values = m_J_sparse.values();
+                for (std::size_t r = 0; r < n; ++r)
+                {
+                    T acc = 0;
+                    for (std::size_t p = offsets[r]; p < offsets[r + 1]; ++p)
+                    {
+                        acc += values[p] * v[indices[p]];
+                    }
+                    out[r] = acc;
+                }
+                return;
+            }
+
+            const miv::matrix<T> &J = (m_options.jacobian == JacobianMode::Manual) ? m_J_manual : m_J;
+            for (std::size_t r = 0; r < n; ++r)
+            {
+                out[r] = static_cast<T>(simd::dot(n, J.data() + r * n, v));
+            }
+        }
+
+        void jacobian_multiply_transposed(const T *v, T *out) const
+        {
+            const std::size_t n = m_fx.rows();
+            std::fill(out, out + n, T{});
+
+            if (m_options.jacobian == JacobianMode::Sparse)
+            {
+                const auto &offsets = m_J_sparse.row_offsets();
+                const auto &indices = m_J_sparse.col_indices();
+                const auto &values = m_J_sparse.values();
+                for (std::size_t r = 0; r < n; ++r)
+                {
+                    for (std::size_t p = offsets[r]; p < offsets[r + 1]; ++p)
+                    {
+                        out[indices[p]] += values[p] * v[r];
+                    }
+                }
+                return;
+            }
+
+            const miv::matrix<T> &J = (m_options.jacobian == JacobianMode::Manual) ? m_J_manual : m_J;
+            for (std::size_t r = 0; r < n; ++r)
+            {
+                const T *row = J.data() + r * n;
+                const T vr = v[r];
+                for (std::size_t c = 0; c < n; ++c)
+                {
+                    out[c] += row[c] * vr;
+                }
+            }
+        }
+
+        /**
+         * @brief Поправка Бройдена по шагу m_dx и y = F(x_{k+1}) - F(x_k).
+         *
+         * @return false, если поправку добавить нельзя (нужен новый Якобиан)
+         */
+        bool broyden_update()
+        {
+            const std::size_t n = m_dx.size();
+            const T *f = m_fx.data();
+
+            miv::array<T, miv::workspace_allocator<T>> y(n, m_ws);
+            miv::array<T, miv::workspace_allocator<T>> z(n, m_ws);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                y[i] = f[i] - m_fx_prev[i];
+                z[i] = y[i];
+            }
+
+            // z = H_k y
+            solve_base(z);
+            m_broyden.apply(z.data(), y.data());
+
+            return m_broyden.push(m_dx.data(), y.data(), z.data());
+        }
+
+        newton_options<T> m_options;
+        iteration_callback m_on_iteration;
+        stop_condition m_stop_condition;
+
+        // Буферы итерации живут между solve(): F(x), Якобиан, разложение и workspace
+        // для временных векторов. После первой итерации цикл не обращается к куче.
+        miv::matrix<T> m_fx;
+        miv::matrix<T> m_J;
+        miv::matrix<T> m_J_manual;
+        jacobian_builder<T> m_builder;
+        detail::dense_lu<T> m_lu;
+
+        std::unique_ptr<sparse_jacobian_builder<T>> m_sparse_builder;
+        miv::sparse_matrix<T> m_J_sparse;
+        sparse_lu<T> m_lu_sparse;
+
+        // Методы Бройдена: поправки к разложению, последний шаг и F(x_k)
+        broyden_updates<T> m_broyden;
+        miv::array<T> m_dx;
+        miv::array<T> m_fx_prev;
+
+        // Automatic: построитель по dual-функциям (тип N стёрт)
+        std::function<void(const miv::array<T> &, miv::matrix<T> &)> m_automatic;
+        std::size_t m_automatic_size = 0;
+
+        // JacobianFree: GMRES, точка x + εv и буфер предобуславливателя
+        gmres_solver<T> m_gmres;
+        preconditioner m_preconditioner;
+        miv::array<T> m_xp;
+        miv::array<T> m_pc;
+
+        // Кэш разложений J(x0) между solve() (options.cache_bytes)
+        factorization_cache<T, detail::dense_lu<T>> m_cache_dense;
+        factorization_cache<T, sparse_lu<T>> m_cache_sparse;
+        bool m_cache_stored = false;   // первое разложение этого solve() уже в кэше
+        JacobianMode m_cache_jacobian = JacobianMode::Numeric;       // с какими options записи кэша
+        NumericFormula m_cache_formula = NumericFormula::TwoPoint;
+        LinearPrecision m_cache_precision = LinearPrecision::Native;
+
+        // LineSearch / Dogleg: пробная точка и F в ней (принятые меняются местами с x, m_fx)
+        miv::array<T> m_x_trial;
+        miv::matrix<T> m_f_trial;
+
+        miv::workspace m_ws;
+    };
+}
+
+#endif // MIV_MATH_NEWTON_SOLVER_H
@@ -0,0 +1,413 @@
+#ifndef MIV_MATH_REFINEMENT_H
+#define MIV_MATH_REFINEMENT_H
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+#include <stdexcept>
+#include <algorithm>
+
+#include "containers/array.hpp"
+#include "containers/matrix.hpp"
+#include "exec/thread_pool.hpp"
+#include "math/helpers.hpp"   // FloatNumber, norm_t, require_squareness
+#include "math/simd.hpp"      // max_abs
+#include "math/lu_factorization.hpp"
+
+namespace miv::math
+{
+    /**
+     * @brief Параметры итерационного уточнения.
+     *
+     * tolerance — порог нормированной обратной ошибки
+     *     ||b - Ax||_inf / (||A||_inf ||x||_inf + ||b||_inf);
+     * 0 означает «автоматически»: n * eps(T).
+     */
+    struct refinement_options
+    {
+        std::size_t max_iterations = 10;
+        norm_t tolerance = 0;
+
+        /// Если уточнение не сходится (A слишком плохо обусловлена для Low),
+        /// решить систему разложением в полной точности T.
+        bool fallback = true;
+    };
+
+    /**
+     * @brief Как прошло решение с уточнением.
+     */
+    struct refinement_report
+    {
+        std::size_t iterations = 0;   ///< выполненных шагов уточнения
+        norm_t backward_error = 0;    ///< итоговая нормированная обратная ошибка
+        bool converged = false;       ///< достигнут порог tolerance
+        bool fell_back = false;       ///< решено разложением в точности T
+    };
+
+    /**
+     * @brief LUP-разложение смешанной точности с итерационным уточнением.
+     *
+     * Разложение выполняется один раз в точности Low (float/double — аппаратные
+     * типы, O(n^3)), а невязка r = b - Ax считается в точности системы T
+     * (O(n^2) на шаг). Каждый шаг решает A d = r старым разложением и
+     * исправляет x += d:
+     *
+     * @code
+     * mixed_lu_factorization<Float128, double> lu(A);   // разложение в double
+     * auto report = lu.solve_inplace(b);                // b -> x с точностью Float128
+     * @endcode
+     *
+     * Уточнение сходится, пока cond(A) * eps(Low) заметно меньше 1; тогда
+     * результат имеет точность T при стоимости, близкой к решению в Low.
+     * Если Low не справляется (разложение вырождено в Low или поправки
+     * перестают убывать), при options.fallback система решается разложением в T,
+     * которое строится лениво и кешируется до следующей factorize().
+     *
+     * A хранится копией в точности T (для невязок).
+     */
+    template <FloatNumber T, FloatNumber Low = double>
+    class mixed_lu_factorization
+    {
+        static_assert(std::numeric_limits<Low>::digits <= std::numeric_limits<T>::digits,
+                      "mixed_lu_factorization: Low must not be more precise than T");
+
+    public:
+        using value_t = T;
+        using low_t = Low;
+
+        /**
+         * @brief Пустое (ещё не выполненное) разложение.
+         */
+        mixed_lu_factorization() = default;
+
+        /**
+         * @brief Сразу разложить матрицу A.
+         *
+         * @throws std::invalid_argument если A не квадратная или вырожденная
+         */
+        explicit mixed_lu_factorization(const miv::matrix<T> &A, refinement_options options = {})
+            : m_options(options)
+        {
+            factorize(A);
+        }
+
+        /**
+         * @brief Выполнить (или повторить) разложение матрицы A.
+         *
+         * Буферы того же размера переиспользуются. Если A вырождена в точности Low,
+         * а options.fallback включён, сразу строится разложение в точности T.
+         *
+         * @throws std::invalid_argument если A не квадратная или вырожденная
+         */
+        void factorize(const miv::matrix<T> &A)
+        {
+            require_squareness(A);
+
+            const std::size_t n = A.rows();
+
+            m_A = A;
+            m_A_norm = matrix_norm_inf(m_A);
+            m_full_valid = false;
+
+            if (m_low.rows() != n || m_low.cols() != n)
+            {
+                m_low = miv::matrix<Low>(n, n, miv::uninitialized);
+            }
+
+            bool representable = true;
+            for (std::size_t i = 0; i < n * n; ++i)
+            {
+                const Low v = static_cast<Low>(m_A.data()[i]);
+                representable = representable && std::isfinite(v);
+                m_low.data()[i] = v;
+            }
+
+            try
+            {
+                if (!representable)
+                {
+                    throw std::invalid_argument("mixed_lu_factorization: A overflows the factorization precision");
+                }
+
+                m_lu.factorize(m_low);
+            }
+            catch (const std::invalid_argument &)
+            {
+                if (!m_options.fallback)
+                {
+                    m_A.clear();
+                    throw;
+                }
+
+                // Вырождена (или не представима) в Low: сразу разложение в T
+                m_lu = lu_factorization<Low>();
+                factorize_full();
+            }
+
+            m_b.resize(n, miv::uninitialized);
+            m_r.resize(n, miv::uninitialized);
+            m_d.resize(n, miv::uninitialized);
+        }
+
+        /**
+         * @brief Было ли выполнено разложение.
+         */
+        bool empty() const { return m_A.empty(); }
+
+        /**
+         * @brief Размерность разложенной матрицы (n).
+         */
+        std::size_t n() const { return m_A.rows(); }
+
+        /**
+         * @brief Параметры уточнения (действуют на следующие solve).
+         */
+        refinement_options &options() { return m_options; }
+        const refinement_options &options() const { return m_options; }
+
+        /**
+         * @brief Используется ли уже разложение в полной точности T.
+         */
+        bool uses_full_precision() const { return m_full_valid; }
+
+        /**
+         * @brief Решить Ax = b на месте: b заменяется на x.
+         *
+         * Рабочие буферы — члены объекта, поэтому повторные решения не выделяют
+         * память (кроме однократного перехода на разложение в T).
+         *
+         * @throws std::logic_error если разложение не выполнено
+         * @throws std::invalid_argument если длина b не равна n
+         */
+        template <typename Alloc>
+        refinement_report solve_inplace(miv::array<T, Alloc> &b)
+        {
+            require_rhs_length(b.size());
+            return solve_raw(b.data());
+        }
+
+        /**
+         * @brief Решить Ax = b на месте для вектора-матрицы (1 x n или n x 1).
+         */
+        refinement_report solve_inplace(miv::matrix<T> &b)
+        {
+            require_rhs_length(vector_length(b));
+            return solve_raw(b.data());
+        }
+
+        /**
+         * @brief Решить Ax = b и вернуть x той же формы, что и b.
+         */
+        miv::matrix<T> solve(const miv::matrix<T> &b, refinement_report *report = nullptr)
+        {
+            miv::matrix<T> x = b;
+            const refinement_report r = solve_inplace(x);
+
+            if (report)
+            {
+                *report = r;
+            }
+
+            return x;
+        }
+
+    private:
+        void require_rhs_length(std::size_t len) const
+        {
+            if (empty())
+            {
+                throw std::logic_error("mixed_lu_factorization::solve(): factorization is empty");
+            }
+
+            if (len != n())
+            {
+                throw std::invalid_argument(
+                    "mixed_lu_factorization::solve(): b must be a vector of length n = " + std::to_string(n()) +
+                    ", but got length " + std::to_string(len));
+            }
+        }
+
+        static norm_t matrix_norm_inf(const miv::matrix<T> &A)
+        {
+            norm_t best = 0;
+            for (std::size_t i = 0; i < A.rows(); ++i)
+            {
+                norm_t row = 0;
+                for (std::size_t j = 0; j < A.cols(); ++j)
+                {
+                    row += static_cast<norm_t>(std::abs(A.data()[i * A.cols() + j]));
+                }
+                best = std::max(best, row);
+            }
+            return best;
+        }
+
+        /**
+         * @brief r = b - A x в точности T (строки параллельно для больших n).
+         */
+        void residual(const T *b, const T *x, T *r) const
+        {
+            const std::size_t n = m_A.rows();
+            const T *a = m_A.data();
+
+            miv::exec::parallel_for(0, n, n * n, [=](std::size_t lo, std::size_t hi)
+            {
+                for (std::size_t i = lo; i < hi; ++i)
+                {
+                    const T *row = a + i * n;
+                    T sum = b[i];
+                    for (std::size_t j = 0; j < n; ++j)
+                    {
+                        sum -= row[j] * x[j];
+                    }
+                    r[i] = sum;
+                }
+            });
+        }
+
+        /**
+         * @brief d = A^{-1} r разложением в Low.
+         *
+         * r масштабируется на max|r|: невязки малы и без масштаба ушли бы
+         * в денормалы или ноль при приведении к Low.
+         */
+        void correction(const T *r, T *d, norm_t r_max)
+        {
+            const std::size_t n = m_A.rows();
+            const T scale = static_cast<T>(r_max);
+            const T inv = static_cast<T>(1) / scale;
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                m_d[i] = static_cast<Low>(r[i] * inv);
+            }
+
+            m_lu.solve_inplace(m_d);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                d[i] = static_cast<T>(m_d[i]) * scale;
+            }
+        }
+
+        norm_t backward_error(const T *b, const T *x, norm_t r_max) const
+        {
+            const std::size_t n = m_A.rows();
+            const norm_t denom = m_A_norm * simd::max_abs(n, x) + simd::max_abs(n, b);
+            return denom > 0 ? r_max / denom : r_max;
+        }
+
+        /**
+         * @brief Разложение в T по той же A (строится при первой необходимости).
+         */
+        void factorize_full()
+        {
+            if (!m_full_valid)
+            {
+                m_full.factorize(m_A);
+                m_full_valid = true;
+            }
+        }
+
+        /**
+         * @brief bx: на входе b, на выходе x.
+         */
+        refinement_report solve_raw(T *bx)
+        {
+            const std::size_t n = m_A.rows();
+            const T eps = std::numeric_limits<T>::epsilon();
+            const norm_t tol = (m_options.tolerance > 0)
+                ? m_options.tolerance
+                : static_cast<norm_t>(n) * static_cast<norm_t>(eps);
+
+            refinement_report report;
+            std::copy(bx, bx + n, m_b.data());
+
+            if (!m_full_valid)
+            {
+                // x0 = 0, первая «поправка» — начальное решение в Low
+                std::fill(bx, bx + n, T{});
+                norm_t prev_step = std::numeric_limits<norm_t>::infinity();
+
+                for (std::size_t k = 0; k <= m_options.max_iterations; ++k)
+                {
+                    residual(m_b.data(), bx, m_r.data());
+
+                    const norm_t r_max = simd::max_abs(n, m_r.data());
+                    report.backward_error = backward_error(m_b.data(), bx, r_max);
+
+                    if (report.backward_error <= tol)
+                    {
+                        report.converged = true;
+                        break;
+                    }
+
+                    if (k == m_options.max_iterations || !std::isfinite(r_max))
+                    {
+                        break;
+                    }
+
+                    correction(m_r.data(), m_r.data(), r_max);
+                    const norm_t step = simd::max_abs(n, m_r.data());
+
+                    // Поправки должны убывать хотя бы вдвое, иначе cond(A) * eps(Low) ~ 1
+                    if (!std::isfinite(step) || (k >= 2 && step > prev_step / 2))
+                    {
+                        break;
+                    }
+
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        bx[i] += m_r[i];
+                    }
+
+                    prev_step = step;
+                    report.iterations = k + 1;
+
+                    // Поправка ниже eps(T) * |x|: точнее в T уже не станет
+                    if (k >= 1 && step <= static_cast<norm_t>(eps) * simd::max_abs(n, bx))
+                    {
+                        residual(m_b.data(), bx, m_r.data());
+                        report.backward_error = backward_error(m_b.data(), bx, simd::max_abs(n, m_r.data()));
+                        report.converged = true;
+                        break;
+                    }
+                }
+
+                if (report.converged || !m_options.fallback)
+                {
+                    return report;
+                }
+
+                factorize_full();
+            }
+
+            std::copy(m_b.begin(), m_b.end(), m_r.begin());
+            m_full.solve_inplace(m_r);
+            std::copy(m_r.begin(), m_r.end(), bx);
+
+            residual(m_b.data(), bx, m_r.data());
+            report.backward_error = backward_error(m_b.data(), bx, simd::max_abs(n, m_r.data()));
+            report.converged = report.backward_error <= tol;
+            report.fell_back = true;
+            return report;
+        }
+
+        refinement_options m_options;
+
+        miv::matrix<T> m_A;               // A в точности T (для невязок)
+        norm_t m_A_norm = 0;              // ||A||_inf
+        miv::matrix<Low> m_low;           // буфер приведения A к Low
+        lu_factorization<Low> m_lu;       // основное разложение
+        lu_factorization<T> m_full;       // запасное разложение в T
+        bool m_full_valid = false;
+
+        miv::array<T> m_b;                // копия правой части
+        miv::array<T> m_r;                // невязка / поправка
+        miv::array<Low> m_d;              // поправка в Low
+    };
+}
+
+#endif // MIV_MATH_REFINEMENT_H
@@ -0,0 +1,490 @@
+#ifndef MIV_MATH_SIMD_H
+#define MIV_MATH_SIMD_H
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+
+#include "math/helpers.hpp"   // Number, norm_t
+
+// std::experimental::simd (Parallelism TS v2), если есть и не отключён через MIV_NO_STD_SIMD.
+// Ширина вектора — native_simd<T> для целевой архитектуры сборки (-march / MIV_NATIVE_ARCH).
+#if !defined(MIV_NO_STD_SIMD) && __has_include(<experimental/simd>)
+    #include <experimental/simd>
+    #define MIV_HAS_STD_SIMD 1
+#else
+    #define MIV_HAS_STD_SIMD 0
+#endif
+
+namespace miv::math::simd
+{
+    /**
+     * @brief Векторизуются явно только float и double.
+     *
+     * Остальные типы (long double, целые) идут через скалярные циклы с накоплением в norm_t.
+     */
+    template <typename T>
+    concept Vectorizable = std::same_as<T, float> || std::same_as<T, double>;
+
+    namespace detail
+    {
+#if MIV_HAS_STD_SIMD
+        namespace stdx = std::experimental;
+
+        template <Vectorizable T>
+        using pack = stdx::native_simd<T>;
+
+        template <Vectorizable T>
+        inline constexpr std::size_t pack_size = pack<T>::size();
+
+        template <Vectorizable T>
+        inline pack<T> load(const T *p) { return pack<T>(p, stdx::element_aligned); }
+
+        template <Vectorizable T>
+        inline void store(const pack<T> &v, T *p) { v.copy_to(p, stdx::element_aligned); }
+
+        template <Vectorizable T>
+        inline pack<T> vabs(const pack<T> &v) { return stdx::abs(v); }
+
+        template <Vectorizable T>
+        inline pack<T> vmin(const pack<T> &a, const pack<T> &b) { return stdx::min(a, b); }
+
+        template <Vectorizable T>
+        inline pack<T> vmax(const pack<T> &a, const pack<T> &b) { return stdx::max(a, b); }
+#else
+        /**
+         * @brief Переносимая замена native_simd: 32 байта, циклы фиксированной длины
+         * (компилятор раскладывает их в векторные регистры).
+         */
+        template <Vectorizable T>
+        struct pack
+        {
+            static constexpr std::size_t width = 32 / sizeof(T);
+            T v[width];
+
+            pack() = default;
+            pack(T x) { for (std::size_t i = 0; i < width; ++i) v[i] = x; }
+
+            T operator[](std::size_t i) const { return v[i]; }
+
+            friend pack operator+(const pack &a, const pack &b) { pack r; for (std::size_t i = 0; i < width; ++i) r.v[i] = a.v[i] + b.v[i]; return r; }
+            friend pack operator-(const pack &a, const pack &b) { pack r; for (std::size_t i = 0; i < width; ++i) r.v[i] = a.v[i] - b.v[i]; return r; }
+            friend pack operator*(const pack &a, const pack &b) { pack r; for (std::size_t i = 0; i < width; ++i) r.v[i] = a.v[i] * b.v[i]; return r; }
+            friend pack operator-(const pack &a) { pack r; for (std::size_t i = 0; i < width; ++i) r.v[i] = -a.v[i]; return r; }
+        };
+
+        template <Vectorizable T>
+        inline constexpr std::size_t pack_size = pack<T>::width;
+
+        template <Vectorizable T>
+        inline pack<T> load(const T *p) { pack<T> r; for (std::size_t i = 0; i < pack_size<T>; ++i) r.v[i] = p[i]; return r; }
+
+        template <Vectorizable T>
+        inline void store(const pack<T> &v, T *p) { for (std::size_t i = 0; i < pack_size<T>; ++i) p[i] = v.v[i]; }
+
+        template <Vectorizable T>
+        inline pack<T> vabs(const pack<T> &a) { pack<T> r; for (std::size_t i = 0; i < pack_size<T>; ++i) r.v[i] = std::abs(a.v[i]); return r; }
+
+        template <Vectorizable T>
+        inline pack<T> vmin(const pack<T> &a, const pack<T> &b) { pack<T> r; for (std::size_t i = 0; i < pack_size<T>; ++i) r.v[i] = std::min(a.v[i], b.v[i]); return r; }
+
+        template <Vectorizable T>
+        inline pack<T> vmax(const pack<T> &a, const pack<T> &b) { pack<T> r; for (std::size_t i = 0; i < pack_size<T>; ++i) r.v[i] = std::max(a.v[i], b.v[i]); return r; }
+#endif
+
+        /**
+         * @brief Поэлементное ядро out[i] = op(a[i], b[i]) (векторная часть + скалярный хвост).
+         */
+        template <Vectorizable T, typename VecOp, typename ScalarOp>
+        inline void binary(std::size_t n, const T *a, const T *b, T *out, VecOp vop, ScalarOp sop)
+        {
+            constexpr std::size_t W = pack_size<T>;
+            const std::size_t vec_end = n - n % W;
+            std::size_t i = 0;
+
+            for (; i < vec_end; i += W)
+            {
+                store(vop(load(a + i), load(b + i)), out + i);
+            }
+            for (; i < n; ++i)
+            {
+                out[i] = sop(a[i], b[i]);
+            }
+        }
+
+        template <Vectorizable T, typename VecOp, typename ScalarOp>
+        inline void unary(std::size_t n, const T *a, T *out, VecOp vop, ScalarOp sop)
+        {
+            constexpr std::size_t W = pack_size<T>;
+            const std::size_t vec_end = n - n % W;
+            std::size_t i = 0;
+
+            for (; i < vec_end; i += W)
+            {
+                store(vop(load(a + i)), out + i);
+            }
+            for (; i < n; ++i)
+            {
+                out[i] = sop(a[i]);
+            }
+        }
+
+        /**
+         * @brief Компенсированная (Кэхэн) сумма term(i) по векторным полосам.
+         *
+         * Четыре независимых аккумулятора (сумма + поправка в T) скрывают латентность
+         * цепочки сложений; в конце полосы и поправки складываются в norm_t
+         * (расширенная финальная редукция — это 4 * W сложений, а не n).
+         */
+        template <Vectorizable T, typename VecTerm, typename ScalarTerm>
+        inline norm_t kahan_reduce(std::size_t n, VecTerm vterm, ScalarTerm sterm)
+        {
+            constexpr std::size_t W = pack_size<T>;
+            constexpr std::size_t U = 4;
+
+            pack<T> s[U];
+            pack<T> c[U];
+            for (std::size_t u = 0; u < U; ++u)
+            {
+                s[u] = pack<T>(T{});
+                c[u] = pack<T>(T{});
+            }
+
+            const auto step = [&](std::size_t u, std::size_t i)
+            {
+                const pack<T> y = vterm(i) - c[u];
+                const pack<T> t = s[u] + y;
+                c[u] = (t - s[u]) - y;
+                s[u] = t;
+            };
+
+            const std::size_t unrolled_end = n - n % (U * W);
+            const std::size_t vec_end = n - n % W;
+            std::size_t i = 0;
+
+            for (; i < unrolled_end; i += U * W)
+            {
+                for (std::size_t u = 0; u < U; ++u)
+                {
+                    step(u, i + u * W);
+                }
+            }
+            for (; i < vec_end; i += W)
+            {
+                step(0, i);
+            }
+
+            norm_t acc = 0;
+            for (std::size_t u = 0; u < U; ++u)
+            {
+                for (std::size_t l = 0; l < W; ++l)
+                {
+                    acc += static_cast<norm_t>(s[u][l]) - static_cast<norm_t>(c[u][l]);
+                }
+            }
+
+            // Хвост (< W элементов)
+            for (; i < n; ++i)
+            {
+                acc += static_cast<norm_t>(sterm(i));
+            }
+
+            return acc;
+        }
+    }
+
+    // ============================================================
+    //                     Element-wise kernels
+    // ============================================================
+
+    /**
+     * @brief out = a + b (n элементов).
+     */
+    template <Number T>
+    inline void add(std::size_t n, const T *a, const T *b, T *out)
+    {
+        if constexpr (Vectorizable<T>)
+        {
+            detail::binary(n, a, b, out, [](auto x, auto y) { return x + y; }, [](T x, T y) { return x + y; });
+        }
+        else
+        {
+            for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i];
+        }
+    }
+
+    /**
+     * @brief out = a - b.
+     */
+    template <Number T>
+    inline void sub(std::size_t n, const T *a, const T *b, T *out)
+    {
+        if constexpr (Vectorizable<T>)
+        {
+            detail::binary(n, a, b, out, [](auto x, auto y) { return x - y; }, [](T x, T y) { return x - y; });
+        }
+        else
+        {
+            for (std::size_t i = 0; i < n; ++i) out[i] = a[i] - b[i];
+        }
+    }
+
+    /**
+     * @brief out = a ⊙ b (поэлементное произведение).
+     */
+    template <Number T>
+    inline void mul(std::size_t n, const T *a, const T *b, T *out)
+    {
+        if constexpr (Vectorizable<T>)
+        {
+            detail::binary(n, a, b, out, [](auto x, auto y) { return x * y; }, [](T x, T y) { return x * y; });
+        }
+        else
+        {
+            for (std::size_t i = 0; i < n; ++i) out[i] = a[i] * b[i];
+        }
+    }
+
+    /**
+     * @brief out = min(a, b) поэлементно.
+     */
+    template <Number T>
+    inline void min(std::size_t n, const T *a, const T *b, T *out)
+    {
+        if constexpr (Vectorizable<T>)
+        {
+            detail::binary(n, a, b, out,
+                [](const auto &x, const auto &y) { return detail::vmin<T>(x, y); },
+                [](T x, T y) { return std::min(x, y); });
+        }
+        else
+        {
+            for (std::size_t i = 0; i < n; ++i) out[i] = std::min(a[i], b[i]);
+        }
+    }
+
+    /**
+     * @brief out = max(a, b) поэлементно.
+     */
+    template <Number T>
+    inline void max(std::size_t n, const T *a, const T *b, T *out)
+    {
+        if constexpr (Vectorizable<T>)
+        {
+            detail::binary(n, a, b, out,
+                [](const auto &x, const auto &y) { return detail::vmax<T>(x, y); },
+                [](T x, T y) { return std::max(x, y); });
+        }
+        else
+        {
+            for (std::size_t i = 0; i < n; ++i) out[i] = std::max(a[i], b[i]);
+        }
+    }
+
+    /**
+     * @brief out = -a.
+     */
+    template <Number T>
+    inline void negate(std::size_t n, const T *a, T *out)
+    {
+        if constexpr (Vectorizable<T>)
+        {
+            detail::unary(n, a, out, [](auto x) { return -x; }, [](T x) { return -x; });
+        }
+        else
+        {
+            for (std::size_t i = 0; i < n; ++i) out[i] = -a[i];
+        }
+    }
+
+    /**
+     * @brief out = a * k.
+     */
+    template <Number T>
+    inline void scale(std::size_t n, const T *a, T k, T *out)
+    {
+        if constexpr (Vectorizable<T>)
+        {
+            const detail::pack<T> kv(k);
+            detail::unary(n, a, out, [kv](auto x) { return x * kv; }, [k](T x) { return x * k; });
+        }
+        else
+        {
+            for (std::size_t i = 0; i < n; ++i) out[i] = a[i] * k;
+        }
+    }
+
+    // ============================================================
+    //                         Reductions
+    // ============================================================
+    //
+    // float/double: накопление в T по векторным полосам с компенсацией Кэхэна,
+    // финальная редукция полос — в norm_t. Погрешность O(eps) независимо от n,
+    // как у прежнего накопления в long double, но без x87 во внутреннем цикле.
+    // Компенсация требует строгой IEEE-арифметики (без -ffast-math).
+
+    /**
+     * @brief sum(a[i]).
+     */
+    template <Number T>
+    inline norm_t sum(std::size_t n, const T *a)
+    {
+        if constexpr (Vectorizable<T>)
+        {
+            return detail::kahan_reduce<T>(n,
+                [a](std::size_t i) { return detail::load(a + i); },
+                [a](std::size_t i) { return a[i]; });
+        }
+        else
+        {
+            norm_t acc = 0;
+            for (std::size_t i = 0; i < n; ++i) acc += static_cast<norm_t>(a[i]);
+            return acc;
+        }
+    }
+
+    /**
+     * @brief sum(|a[i]|).
+     */
+    template <Number T>
+    inline norm_t sum_abs(std::size_t n, const T *a)
+    {
+        if constexpr (Vectorizable<T>)
+        {
+            return detail::kahan_reduce<T>(n,
+                [a](std::size_t i) { return detail::vabs<T>(detail::load(a + i)); },
+                [a](std::size_t i) { return std::abs(a[i]); });
+        }
+        else
+        {
+            norm_t acc = 0;
+            for (std::size_t i = 0; i < n; ++i) acc += std::abs(static_cast<norm_t>(a[i]));
+            return acc;
+        }
+    }
+
+    /**
+     * @brief max(|a[i]|) (0 для пустого диапазона).
+     */
+    template <Number T>
+    inline norm_t max_abs(std::size_t n, const T *a)
+    {
+        if constexpr (Vectorizable<T>)
+        {
+            constexpr std::size_t W = detail::pack_size<T>;
+
+            detail::pack<T> best(T{});
+            const std::size_t vec_end = n - n % W;
+            std::size_t i = 0;
+
+            for (; i < vec_end; i += W)
+            {
+                best = detail::vmax<T>(best, detail::vabs<T>(detail::load(a + i)));
+            }
+
+            T out = T{};
+            for (std::size_t l = 0; l < W; ++l)
+            {
+                out = std::max(out, static_cast<T>(best[l]));
+            }
+            for (; i < n; ++i)
+            {
+                out = std::max(out, std::abs(a[i]));
+            }
+
+            return static_cast<norm_t>(out);
+        }
+        else
+        {
+            norm_t best = 0;
+            for (std::size_t i = 0; i < n; ++i) best = std::max(best, std::abs(static_cast<norm_t>(a[i])));
+            return best;
+        }
+    }
+
+    /**
+     * @brief sum(a[i] * b[i]).
+     */
+    template <Number T>
+    inline norm_t dot(std::size_t n, const T *a, const T *b)
+    {
+        if constexpr (Vectorizable<T>)
+        {
+            return detail::kahan_reduce<T>(n,
+                [a, b](std::size_t i) { return detail::load(a + i) * detail::load(b + i); },
+                [a, b](std::size_t i) { return a[i] * b[i]; });
+        }
+        else
+        {
+            norm_t acc = 0;
+            for (std::size_t i = 0; i < n; ++i) acc += static_cast<norm_t>(a[i]) * static_cast<norm_t>(b[i]);
+            return acc;
+        }
+    }
+
+    /**
+     * @brief sqrt(sum(a[i]^2)).
+     *
+     * Быстрый путь — квадраты в T. Если сумма переполнилась или ушла в область
+     * денормалов (а long double этого бы не заметил), второй проход считает
+     * норму с масштабированием на max|a[i]|. NaN в a даёт NaN (max_abs его
+     * теряет, а невязка NaN не должна выглядеть нулевой).
+     */
+    template <Number T>
+    inline norm_t norm_l2(std::size_t n, const T *a)
+    {
+        if constexpr (Vectorizable<T>)
+        {
+            const norm_t ss = detail::kahan_reduce<T>(n,
+                [a](std::size_t i) { const auto v = detail::load(a + i); return v * v; },
+                [a](std::size_t i) { return a[i] * a[i]; });
+
+            const norm_t tiny = static_cast<norm_t>(std::numeric_limits<T>::min()) /
+                                static_cast<norm_t>(std::numeric_limits<T>::epsilon());
+
+            if (std::isfinite(static_cast<T>(ss)) && (ss == 0 ? max_abs(n, a) == 0 : ss >= tiny))
+            {
+                return std::sqrt(ss);
+            }
+
+            // Сумма NaN и от NaN в a, и от inf (компенсация inf - inf): различить по элементам
+            if (std::isnan(ss))
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    if (std::isnan(a[i]))
+                    {
+                        return std::numeric_limits<norm_t>::quiet_NaN();
+                    }
+                }
+            }
+
+            const norm_t m = max_abs(n, a);
+            if (m == 0 || !std::isfinite(m))
+            {
+                return m;
+            }
+
+            const T inv = static_cast<T>(1 / m);
+            const norm_t scaled = detail::kahan_reduce<T>(n,
+                [a, inv](std::size_t i) { const auto v = detail::load(a + i) * detail::pack<T>(inv); return v * v; },
+                [a, inv](std::size_t i) { const T v = a[i] * inv; return v * v; });
+
+            return m * std::sqrt(scaled);
+        }
+        else
+        {
+            norm_t acc = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const norm_t v = static_cast<norm_t>(a[i]);
+                acc += v * v;
+            }
+            return std::sqrt(acc);
+        }
+    }
+}
+
+#endif // MIV_MATH_SIMD_H
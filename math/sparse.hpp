@@ -0,0 +1,1194 @@
+#ifndef MIV_MATH_SPARSE_H
+#define MIV_MATH_SPARSE_H
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <vector>
+#include <string>
+#include <utility>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+
+#include "containers/array.hpp"
+#include "containers/sparse_matrix.hpp"
+#include "containers/profile.hpp"
+#include "containers/workspace.hpp"
+#include "exec/thread_pool.hpp"
+#include "math/helpers.hpp"   // FloatNumber
+#include "math/system.hpp"    // system_size, evaluate_system
+
+namespace miv::math
+{
+    // ============================================================
+    //                      Sparsity pattern
+    // ============================================================
+
+    /**
+     * @brief Шаблон разреженности Якобиана в формате CSR (только структура).
+     *
+     * Строка i содержит номера переменных, от которых зависит уравнение i.
+     */
+    struct sparsity_pattern
+    {
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+        miv::array<std::size_t> row_offsets;
+        miv::array<std::size_t> col_indices;
+
+        std::size_t nnz() const { return col_indices.size(); }
+
+        /**
+         * @brief Собрать шаблон из списков зависимостей по строкам.
+         *
+         * Индексы в строке сортируются, повторы удаляются.
+         *
+         * @throws std::out_of_range если индекс столбца >= cols
+         */
+        static sparsity_pattern from_rows(std::size_t cols, const std::vector<std::vector<std::size_t>> &deps)
+        {
+            sparsity_pattern p;
+            p.rows = deps.size();
+            p.cols = cols;
+            p.row_offsets = miv::array<std::size_t>(p.rows + 1);
+
+            std::vector<std::size_t> flat;
+            p.row_offsets[0] = 0;
+
+            for (std::size_t r = 0; r < p.rows; ++r)
+            {
+                std::vector<std::size_t> row = deps[r];
+                std::sort(row.begin(), row.end());
+                row.erase(std::unique(row.begin(), row.end()), row.end());
+
+                for (const std::size_t c : row)
+                {
+                    if (c >= cols)
+                    {
+                        throw std::out_of_range(
+                            "sparsity_pattern::from_rows(): column " + std::to_string(c) +
+                            " is out of range in row " + std::to_string(r));
+                    }
+                    flat.push_back(c);
+                }
+
+                p.row_offsets[r + 1] = flat.size();
+            }
+
+            p.col_indices = miv::array<std::size_t>(flat.data(), flat.size());
+            return p;
+        }
+
+        /**
+         * @brief Шаблон произвольной разреженной матрицы.
+         */
+        template <typename U>
+        static sparsity_pattern of(const miv::sparse_matrix<U> &m)
+        {
+            sparsity_pattern p;
+            p.rows = m.rows();
+            p.cols = m.cols();
+            p.row_offsets = m.row_offsets();
+            p.col_indices = m.col_indices();
+            return p;
+        }
+    };
+
+    /**
+     * @brief Определить шаблон разреженности численно, возмущая по очереди каждую координату.
+     *
+     * Зависимость (i, j) фиксируется, если F_i меняется при сдвиге x_j вперёд или назад
+     * на заметный шаг cbrt(eps) * (1 + |x_j|). Стоит 2n + 1 вычислений F, выполняется один раз.
+     *
+     * Функция, локально постоянная по x_j в окрестности x, зависимость пропустит —
+     * в таких случаях шаблон лучше объявить явно (sparsity_pattern::from_rows).
+     */
+    template <FloatNumber T, typename System>
+    inline sparsity_pattern detect_sparsity(miv::array<T> &x, const System &functions)
+    {
+        const std::size_t n = x.size();
+        const std::size_t m = system_size(functions);
+
+        miv::array<T> f0(m);
+        miv::array<T> f1(m);
+
+        evaluate_system(functions, x, f0.data());
+
+        const T probe = std::cbrt(std::numeric_limits<T>::epsilon());
+        std::vector<std::vector<std::size_t>> deps(m);
+
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            const T xj = x[j];
+            const T h = probe * (static_cast<T>(1) + std::abs(xj));
+
+            for (const T shift : { h, -h })
+            {
+                x[j] = xj + shift;
+                evaluate_system(functions, x, f1.data());
+
+                for (std::size_t i = 0; i < m; ++i)
+                {
+                    if (f1[i] != f0[i] && (deps[i].empty() || deps[i].back() != j))
+                    {
+                        deps[i].push_back(j);
+                    }
+                }
+            }
+
+            x[j] = xj;
+        }
+
+        return sparsity_pattern::from_rows(n, deps);
+    }
+
+    // ============================================================
+    //          Column coloring (Curtis–Powell–Reid)
+    // ============================================================
+
+    /**
+     * @brief Раскраска столбцов: столбцы одного цвета не имеют общих строк.
+     */
+    struct column_coloring
+    {
+        miv::array<std::size_t> color; // цвет каждого столбца
+        std::size_t colors = 0;        // число цветов
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief Транспонировать структуру CSR (получить CSC).
+         *
+         * @param pos Для каждой позиции CSC — позиция того же элемента в CSR
+         */
+        inline void csr_to_csc(
+            std::size_t rows,
+            std::size_t cols,
+            const miv::array<std::size_t> &row_offsets,
+            const miv::array<std::size_t> &col_indices,
+            miv::array<std::size_t> &col_offsets,
+            miv::array<std::size_t> &row_indices,
+            miv::array<std::size_t> &pos)
+        {
+            const std::size_t nnz = col_indices.size();
+
+            col_offsets = miv::array<std::size_t>(cols + 1);
+            col_offsets.fill(0);
+            row_indices = miv::array<std::size_t>(nnz);
+            pos = miv::array<std::size_t>(nnz);
+
+            for (std::size_t p = 0; p < nnz; ++p)
+            {
+                ++col_offsets[col_indices[p] + 1];
+            }
+            for (std::size_t c = 0; c < cols; ++c)
+            {
+                col_offsets[c + 1] += col_offsets[c];
+            }
+
+            miv::array<std::size_t> next(col_offsets.data(), cols);
+
+            for (std::size_t r = 0; r < rows; ++r)
+            {
+                for (std::size_t p = row_offsets[r]; p < row_offsets[r + 1]; ++p)
+                {
+                    const std::size_t q = next[col_indices[p]]++;
+                    row_indices[q] = r;
+                    pos[q] = p;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Жадная раскраска столбцов (Curtis–Powell–Reid) в порядке убывания их заполненности.
+     *
+     * Столбцы одного цвета структурно ортогональны, поэтому их производные можно
+     * получить одним вычислением F со сдвигом всех этих координат сразу.
+     */
+    inline column_coloring color_columns(const sparsity_pattern &p)
+    {
+        miv::array<std::size_t> col_offsets;
+        miv::array<std::size_t> row_indices;
+        miv::array<std::size_t> pos;
+        detail::csr_to_csc(p.rows, p.cols, p.row_offsets, p.col_indices, col_offsets, row_indices, pos);
+
+        // Largest-first: сначала самые "конфликтные" столбцы
+        std::vector<std::size_t> order(p.cols);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+        {
+            return (col_offsets[a + 1] - col_offsets[a]) > (col_offsets[b + 1] - col_offsets[b]);
+        });
+
+        constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+        column_coloring out;
+        out.color = miv::array<std::size_t>(p.cols);
+        out.color.fill(none);
+
+        // forbidden[c] == j+1 означает: цвет c запрещён для текущего столбца j
+        std::vector<std::size_t> forbidden;
+
+        for (std::size_t idx = 0; idx < order.size(); ++idx)
+        {
+            const std::size_t j = order[idx];
+            const std::size_t stamp = idx + 1;
+
+            for (std::size_t q = col_offsets[j]; q < col_offsets[j + 1]; ++q)
+            {
+                const std::size_t r = row_indices[q];
+                for (std::size_t t = p.row_offsets[r]; t < p.row_offsets[r + 1]; ++t)
+                {
+                    const std::size_t c = out.color[p.col_indices[t]];
+                    if (c != none)
+                    {
+                        forbidden[c] = stamp;
+                    }
+                }
+            }
+
+            std::size_t c = 0;
+            while (c < forbidden.size() && forbidden[c] == stamp)
+            {
+                ++c;
+            }
+
+            if (c == forbidden.size())
+            {
+                forbidden.push_back(0);
+            }
+
+            out.color[j] = c;
+        }
+
+        out.colors = forbidden.size();
+        return out;
+    }
+
+    // ============================================================
+    //               Compressed sparse Jacobian builder
+    // ============================================================
+
+    /**
+     * @brief Построитель разреженного численного Якобиана по раскраске столбцов.
+     *
+     * Вместо n вычислений F нужно столько, сколько цветов (двухузловая формула)
+     * или вдвое больше (трёхузловая). Результат — miv::sparse_matrix<T> в CSR
+     * со структурой шаблона; при повторных построениях меняются только значения.
+     */
+    template <FloatNumber T>
+    class sparse_jacobian_builder
+    {
+    public:
+        using value_t = T;
+
+        explicit sparse_jacobian_builder(sparsity_pattern pattern)
+            : m_pattern(std::move(pattern)), m_coloring(color_columns(m_pattern))
+        {
+            detail::csr_to_csc(
+                m_pattern.rows, m_pattern.cols,
+                m_pattern.row_offsets, m_pattern.col_indices,
+                m_col_offsets, m_row_indices, m_value_pos);
+
+            // Столбцы, сгруппированные по цветам
+            m_color_offsets = miv::array<std::size_t>(m_coloring.colors + 1);
+            m_color_offsets.fill(0);
+            for (std::size_t j = 0; j < m_pattern.cols; ++j)
+            {
+                ++m_color_offsets[m_coloring.color[j] + 1];
+            }
+            for (std::size_t c = 0; c < m_coloring.colors; ++c)
+            {
+                m_color_offsets[c + 1] += m_color_offsets[c];
+            }
+
+            m_color_columns = miv::array<std::size_t>(m_pattern.cols);
+            miv::array<std::size_t> next(m_color_offsets.data(), m_coloring.colors);
+            for (std::size_t j = 0; j < m_pattern.cols; ++j)
+            {
+                m_color_columns[next[m_coloring.color[j]]++] = j;
+            }
+        }
+
+        const sparsity_pattern &pattern() const { return m_pattern; }
+        const column_coloring &coloring() const { return m_coloring; }
+
+        /**
+         * @brief Число вычислений F на одно построение (без F(x)) для двухузловой формулы.
+         */
+        std::size_t colors() const { return m_coloring.colors; }
+
+        /**
+         * @brief Двухузловая формула по известному F(x) (fx — n значений).
+         */
+        template <typename System>
+        void build_two_point(
+            miv::array<T> &x,
+            const System &functions,
+            const T *fx,
+            miv::sparse_matrix<T> &J)
+        {
+            MIV_PROFILE_SCOPE(jacobian);
+
+            prepare(x, functions, J);
+            T *values = J.values().data();
+
+            for_each_color(x, [&](miv::array<T> &xs, T *f_plus, T *, T *h, std::size_t c)
+            {
+                perturb(xs, c, h, static_cast<T>(1));
+                evaluate_system(functions, xs, f_plus);
+                restore(xs, c, h, static_cast<T>(1));
+
+                scatter(c, h, [&](std::size_t i, T hj) { return (f_plus[i] - fx[i]) / hj; }, values);
+            });
+        }
+
+        /**
+         * @brief Трёхузловая формула: два вычисления F на цвет.
+         */
+        template <typename System>
+        void build_three_point(miv::array<T> &x, const System &functions, miv::sparse_matrix<T> &J)
+        {
+            MIV_PROFILE_SCOPE(jacobian);
+
+            prepare(x, functions, J);
+            T *values = J.values().data();
+
+            for_each_color(x, [&](miv::array<T> &xs, T *f_plus, T *f_minus, T *h, std::size_t c)
+            {
+                perturb(xs, c, h, static_cast<T>(1));
+                evaluate_system(functions, xs, f_plus);
+                restore(xs, c, h, static_cast<T>(1));
+
+                perturb(xs, c, h, static_cast<T>(-1));
+                evaluate_system(functions, xs, f_minus);
+                restore(xs, c, h, static_cast<T>(-1));
+
+                scatter(c, h, [&](std::size_t i, T hj)
+                {
+                    return (f_plus[i] - f_minus[i]) / (static_cast<T>(2) * hj);
+                }, values);
+            });
+        }
+
+    private:
+        struct slot_buffers
+        {
+            miv::array<T> x;
+            miv::array<T> f_plus;
+            miv::array<T> f_minus;
+            miv::array<T> h;
+        };
+
+
+        template <typename System>
+        void prepare(const miv::array<T> &x, const System &functions, miv::sparse_matrix<T> &J)
+        {
+            if (system_size(functions) != m_pattern.rows || x.size() != m_pattern.cols)
+            {
+                throw std::invalid_argument(
+                    "sparse_jacobian_builder: system is " + std::to_string(system_size(functions)) + "x" +
+                    std::to_string(x.size()) + ", but pattern is " + std::to_string(m_pattern.rows) + "x" +
+                    std::to_string(m_pattern.cols));
+            }
+
+            if (J.rows() != m_pattern.rows || J.cols() != m_pattern.cols || J.nnz() != m_pattern.nnz())
+            {
+                J = miv::sparse_matrix<T>(m_pattern.rows, m_pattern.cols, m_pattern.row_offsets, m_pattern.col_indices);
+            }
+        }
+
+        /**
+         * @brief Сдвинуть все координаты цвета c на sign * h_j (h_j сохраняется в h[j]).
+         */
+        void perturb(miv::array<T> &xs, std::size_t c, T *h, T sign) const
+        {
+            const T sq = std::sqrt(std::numeric_limits<T>::epsilon());
+
+            for (std::size_t t = m_color_offsets[c]; t < m_color_offsets[c + 1]; ++t)
+            {
+                const std::size_t j = m_color_columns[t];
+                h[j] = sq * (static_cast<T>(1) + std::abs(xs[j]));
+                xs[j] += sign * h[j];
+            }
+        }
+
+        void restore(miv::array<T> &xs, std::size_t c, const T *h, T sign) const
+        {
+            for (std::size_t t = m_color_offsets[c]; t < m_color_offsets[c + 1]; ++t)
+            {
+                const std::size_t j = m_color_columns[t];
+                xs[j] -= sign * h[j];
+            }
+        }
+
+        /**
+         * @brief Разложить сжатый столбец по элементам J для всех столбцов цвета c.
+         */
+        template <typename D>
+        void scatter(std::size_t c, const T *h, D &&derivative, T *values) const
+        {
+            for (std::size_t t = m_color_offsets[c]; t < m_color_offsets[c + 1]; ++t)
+            {
+                const std::size_t j = m_color_columns[t];
+                for (std::size_t q = m_col_offsets[j]; q < m_col_offsets[j + 1]; ++q)
+                {
+                    values[m_value_pos[q]] = derivative(m_row_indices[q], h[j]);
+                }
+            }
+        }
+
+        /**
+         * @brief Обойти цвета, при большом объёме работы — параллельно (у каждого слота своя копия x).
+         *
+         * Копия x в слоте после restore() может отличаться от исходной в последнем бите,
+         * поэтому перед каждым цветом координаты цвета берутся из оригинала заново.
+         */
+        template <typename Body>
+        void for_each_color(miv::array<T> &x, Body &&body)
+        {
+            const std::size_t colors = m_coloring.colors;
+            const std::size_t n = m_pattern.cols;
+            const std::size_t m = m_pattern.rows;
+
+            if (colors == 0)
+            {
+                return;
+            }
+
+            const std::size_t work = colors * m;
+            const std::size_t threads = (work < miv::exec::serial_threshold()) ? 1 : miv::exec::thread_count();
+            const std::size_t slots = std::min(colors, threads);
+
+            if (m_slots.size() < slots)
+            {
+                m_slots.resize(slots);
+            }
+
+            for (std::size_t s = 0; s < slots; ++s)
+            {
+                auto &buf = m_slots[s];
+                if (buf.x.size() != n)
+                {
+                    buf.x.resize(n);
+                    buf.h.resize(n);
+                }
+                if (buf.f_plus.size() != m)
+                {
+                    buf.f_plus.resize(m);
+                    buf.f_minus.resize(m);
+                }
+                std::copy(x.begin(), x.end(), buf.x.begin());
+            }
+
+            auto run = [&](std::size_t s, std::size_t c0, std::size_t c1)
+            {
+                auto &buf = m_slots[s];
+                for (std::size_t c = c0; c < c1; ++c)
+                {
+                    body(buf.x, buf.f_plus.data(), buf.f_minus.data(), buf.h.data(), c);
+
+                    for (std::size_t t = m_color_offsets[c]; t < m_color_offsets[c + 1]; ++t)
+                    {
+                        const std::size_t j = m_color_columns[t];
+                        buf.x[j] = x[j];
+                    }
+                }
+            };
+
+            if (slots == 1)
+            {
+                run(0, 0, colors);
+                return;
+            }
+
+            // Вычисления F в потоках пула — в профиль вызывающего
+            MIV_PROFILE_CAPTURE(profile);
+            miv::exec::default_pool().parallel_for(0, slots, 1, [&](std::size_t lo, std::size_t hi)
+            {
+                MIV_PROFILE_RECORD_INTO(profile);
+                for (std::size_t s = lo; s < hi; ++s)
+                {
+                    run(s, (colors * s) / slots, (colors * (s + 1)) / slots);
+                }
+            });
+        }
+
+        sparsity_pattern m_pattern;
+        column_coloring m_coloring;
+
+        // CSC-структура шаблона и позиции элементов в CSR-значениях
+        miv::array<std::size_t> m_col_offsets;
+        miv::array<std::size_t> m_row_indices;
+        miv::array<std::size_t> m_value_pos;
+
+        // Столбцы по цветам
+        miv::array<std::size_t> m_color_offsets;
+        miv::array<std::size_t> m_color_columns;
+
+        std::vector<slot_buffers> m_slots;
+    };
+
+    // ============================================================
+    //                   Sparse matrix-vector product
+    // ============================================================
+
+    /**
+     * @brief y = A x для CSR-матрицы.
+     *
+     * @throws std::invalid_argument если x.size() != A.cols()
+     */
+    template <FloatNumber T>
+    inline miv::array<T> multiply(const miv::sparse_matrix<T> &A, const miv::array<T> &x)
+    {
+        if (x.size() != A.cols())
+        {
+            throw std::invalid_argument("multiply(): x must have A.cols() elements");
+        }
+
+        miv::array<T> y(A.rows());
+        const auto &offsets = A.row_offsets();
+        const auto &indices = A.col_indices();
+        const auto &values = A.values();
+
+        for (std::size_t r = 0; r < A.rows(); ++r)
+        {
+            T acc = 0;
+            for (std::size_t p = offsets[r]; p < offsets[r + 1]; ++p)
+            {
+                acc += values[p] * x[indices[p]];
+            }
+            y[r] = acc;
+        }
+
+        return y;
+    }
+
+    // ============================================================
+    //                   Fill-reducing orderings
+    // ============================================================
+
+    /**
+     * @brief Упорядочение столбцов перед разреженным LU.
+     *
+     * - natural:        как есть
+     * - reverse_cuthill_mckee: уменьшение ширины ленты A + A^T
+     * - minimum_degree: жадный минимум степени на графе A + A^T (меньше всего заполнения)
+     */
+    enum class sparse_ordering
+    {
+        natural,
+        reverse_cuthill_mckee,
+        minimum_degree
+    };
+
+    namespace detail
+    {
+        /**
+         * @brief Симметризованный граф A + A^T без петель (списки смежности отсортированы).
+         */
+        inline std::vector<std::vector<std::size_t>> symmetric_graph(
+            std::size_t n,
+            const miv::array<std::size_t> &row_offsets,
+            const miv::array<std::size_t> &col_indices)
+        {
+            std::vector<std::vector<std::size_t>> adj(n);
+
+            for (std::size_t r = 0; r < n; ++r)
+            {
+                for (std::size_t p = row_offsets[r]; p < row_offsets[r + 1]; ++p)
+                {
+                    const std::size_t c = col_indices[p];
+                    if (c != r)
+                    {
+                        adj[r].push_back(c);
+                        adj[c].push_back(r);
+                    }
+                }
+            }
+
+            for (auto &list : adj)
+            {
+                std::sort(list.begin(), list.end());
+                list.erase(std::unique(list.begin(), list.end()), list.end());
+            }
+
+            return adj;
+        }
+
+        inline miv::array<std::size_t> order_rcm(std::vector<std::vector<std::size_t>> adj)
+        {
+            const std::size_t n = adj.size();
+            miv::array<std::size_t> order(n);
+            std::vector<char> visited(n, 0);
+            std::size_t count = 0;
+
+            for (auto &list : adj)
+            {
+                std::sort(list.begin(), list.end(), [&](std::size_t a, std::size_t b)
+                {
+                    return adj[a].size() < adj[b].size();
+                });
+            }
+
+            // Стартуем каждую компоненту связности с вершины минимальной степени
+            std::vector<std::size_t> by_degree(n);
+            std::iota(by_degree.begin(), by_degree.end(), 0);
+            std::stable_sort(by_degree.begin(), by_degree.end(), [&](std::size_t a, std::size_t b)
+            {
+                return adj[a].size() < adj[b].size();
+            });
+
+            for (const std::size_t start : by_degree)
+            {
+                if (visited[start])
+                {
+                    continue;
+                }
+
+                std::size_t head = count;
+                order[count++] = start;
+                visited[start] = 1;
+
+                while (head < count)
+                {
+                    const std::size_t v = order[head++];
+                    for (const std::size_t u : adj[v])
+                    {
+                        if (!visited[u])
+                        {
+                            visited[u] = 1;
+                            order[count++] = u;
+                        }
+                    }
+                }
+            }
+
+            std::reverse(order.begin(), order.end());
+            return order;
+        }
+
+        inline miv::array<std::size_t> order_minimum_degree(std::vector<std::vector<std::size_t>> adj)
+        {
+            const std::size_t n = adj.size();
+            miv::array<std::size_t> order(n);
+            std::vector<char> eliminated(n, 0);
+
+            using entry = std::pair<std::size_t, std::size_t>; // (степень, вершина)
+            std::priority_queue<entry, std::vector<entry>, std::greater<entry>> heap;
+
+            for (std::size_t v = 0; v < n; ++v)
+            {
+                heap.emplace(adj[v].size(), v);
+            }
+
+            std::vector<std::size_t> merged;
+
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                std::size_t v = 0;
+                while (true)
+                {
+                    const auto [deg, cand] = heap.top();
+                    heap.pop();
+                    // Ленивое удаление устаревших записей
+                    if (!eliminated[cand] && deg == adj[cand].size())
+                    {
+                        v = cand;
+                        break;
+                    }
+                }
+
+                order[k] = v;
+                eliminated[v] = 1;
+
+                // Соседи v образуют клику в графе исключения
+                const std::vector<std::size_t> clique = std::move(adj[v]);
+                adj[v].clear();
+
+                for (const std::size_t u : clique)
+                {
+                    merged.clear();
+                    std::set_union(adj[u].begin(), adj[u].end(), clique.begin(), clique.end(), std::back_inserter(merged));
+
+                    auto &list = adj[u];
+                    list.clear();
+                    for (const std::size_t w : merged)
+                    {
+                        if (w != u && w != v && !eliminated[w])
+                        {
+                            list.push_back(w);
+                        }
+                    }
+
+                    heap.emplace(list.size(), u);
+                }
+            }
+
+            return order;
+        }
+    }
+
+    /**
+     * @brief Перестановка столбцов (и симметрично строк), уменьшающая заполнение в LU.
+     *
+     * @return order: k-й по порядку исключается столбец order[k]
+     */
+    template <typename U>
+    inline miv::array<std::size_t> fill_reducing_ordering(const miv::sparse_matrix<U> &A, sparse_ordering kind)
+    {
+        const std::size_t n = A.rows();
+
+        if (kind == sparse_ordering::natural)
+        {
+            miv::array<std::size_t> order(n);
+            std::iota(order.begin(), order.end(), 0);
+            return order;
+        }
+
+        auto adj = detail::symmetric_graph(n, A.row_offsets(), A.col_indices());
+
+        return (kind == sparse_ordering::reverse_cuthill_mckee)
+            ? detail::order_rcm(std::move(adj))
+            : detail::order_minimum_degree(std::move(adj));
+    }
+
+    // ============================================================
+    //                        Sparse LU
+    // ============================================================
+
+    /**
+     * @brief Разреженное LU-разложение A Q = P L U (левосторонний алгоритм Гилберта–Пирлса).
+     *
+     * - Q — упорядочение столбцов, уменьшающее заполнение (fill_reducing_ordering)
+     * - P — частичный выбор главного элемента по строкам с порогом: диагональный
+     *   (в смысле упорядочения Q) элемент предпочитается, если он не меньше
+     *   pivot_tolerance * max, чтобы не разрушать заполнение, выбранное Q
+     *
+     * Каждый столбец получается разреженным треугольным решением с уже построенной L,
+     * так что работа пропорциональна числу реальных операций, а не n^2.
+     */
+    template <FloatNumber T>
+    class sparse_lu
+    {
+    public:
+        using value_t = T;
+
+        sparse_lu() = default;
+
+        explicit sparse_lu(
+            const miv::sparse_matrix<T> &A,
+            sparse_ordering ordering = sparse_ordering::minimum_degree,
+            T pivot_tolerance = static_cast<T>(0.1))
+        {
+            factorize(A, ordering, pivot_tolerance);
+        }
+
+        /**
+         * @brief Выполнить разложение.
+         *
+         * @throws std::invalid_argument если A не квадратная или вырожденная
+         */
+        void factorize(
+            const miv::sparse_matrix<T> &A,
+            sparse_ordering ordering = sparse_ordering::minimum_degree,
+            T pivot_tolerance = static_cast<T>(0.1))
+        {
+            if (A.rows() != A.cols())
+            {
+                throw std::invalid_argument("sparse_lu::factorize(): matrix must be square");
+            }
+
+            MIV_PROFILE_SCOPE(factorize);
+
+            m_col_order = fill_reducing_ordering(A, ordering);
+            m_pivot_tolerance = pivot_tolerance;
+
+            // Столбцы A (CSC) — по ним идёт левосторонний алгоритм; структура
+            // запоминается, refactorize() её не пересчитывает
+            detail::csr_to_csc(A.rows(), A.cols(), A.row_offsets(), A.col_indices(),
+                               m_a_col_offsets, m_a_row_indices, m_a_pos);
+
+            factorize_numeric(A);
+        }
+
+        /**
+         * @brief Повторное разложение матрицы с той же структурой (например, Якобиана
+         * на следующей итерации Ньютона): упорядочение столбцов не пересчитывается.
+         *
+         * Все рабочие буферы переиспользуются: после первой факторизации
+         * повторная не выделяет память.
+         *
+         * @throws std::logic_error если разложения ещё не было
+         * Структура сверяется с запомненной в factorize() поэлементно (O(nnz)):
+         * тот же nnz с другими номерами столбцов — тоже изменённая структура.
+         *
+         * @throws std::invalid_argument если размер или структура A изменились, или A вырождена
+         */
+        void refactorize(const miv::sparse_matrix<T> &A)
+        {
+            if (empty())
+            {
+                throw std::logic_error("sparse_lu::refactorize(): call factorize() first");
+            }
+
+            if (A.rows() != m_n || A.cols() != m_n)
+            {
+                throw std::invalid_argument("sparse_lu::refactorize(): matrix size changed");
+            }
+
+            if (!same_structure(A))
+            {
+                throw std::invalid_argument("sparse_lu::refactorize(): sparsity structure changed");
+            }
+
+            MIV_PROFILE_SCOPE(factorize);
+
+            factorize_numeric(A);
+        }
+
+        bool empty() const { return m_n == 0; }
+        std::size_t n() const { return m_n; }
+
+        /**
+         * @brief Число элементов в L и U (без диагонали L) — мера заполнения.
+         */
+        std::size_t nnz_L() const { return m_L_rows.size(); }
+        std::size_t nnz_U() const { return m_U_steps.size() + m_n; }
+
+        /**
+         * @brief Объём разложения в памяти (L, U, перестановки и рабочие буферы), байт.
+         */
+        std::size_t memory_bytes() const
+        {
+            const std::size_t index = sizeof(std::size_t);
+            return (m_L_values.size() + m_U_values.size() + m_U_diag.size() + m_x.size()) * sizeof(T) +
+                   (m_L_rows.size() + m_L_offsets.size() + m_U_steps.size() + m_U_offsets.size()) * index +
+                   (m_col_order.size() + m_pivot_rows.size() + m_pinv.size() + m_mark.size() + m_reach.size() +
+                    m_stack_node.size() + m_stack_pos.size()) * index +
+                   (m_a_col_offsets.size() + m_a_row_indices.size() + m_a_pos.size()) * index;
+        }
+
+        /**
+         * @brief Решить A x = b на месте.
+         *
+         * @throws std::invalid_argument если b.size() != n
+         */
+        template <typename Alloc>
+        void solve_inplace(miv::array<T, Alloc> &b) const
+        {
+            require_rhs_length(b.size());
+
+            miv::array<T> z(m_n);
+            solve_raw(b.data(), z.data());
+        }
+
+        /**
+         * @brief Решить A x = b на месте; рабочий вектор берётся из workspace (без выделений кучи).
+         *
+         * @throws std::invalid_argument если b.size() != n
+         */
+        template <typename Alloc>
+        void solve_inplace(miv::array<T, Alloc> &b, miv::workspace &ws) const
+        {
+            require_rhs_length(b.size());
+            solve_raw(b.data(), ws.allocate<T>(m_n));
+        }
+
+        miv::array<T> solve(const miv::array<T> &b) const
+        {
+            miv::array<T> x = b;
+            solve_inplace(x);
+            return x;
+        }
+
+    private:
+        /**
+         * @brief Тот же шаблон, что у A из factorize(): O(nnz), без копии шаблона.
+         *
+         * m_a_pos — взаимно однозначное отображение CSC-элементов в позиции CSR;
+         * при том же nnz шаблоны совпадают, если каждый элемент (r, j) сохранённой
+         * структуры лежит в строке r матрицы A с номером столбца j.
+         */
+        bool same_structure(const miv::sparse_matrix<T> &A) const
+        {
+            if (A.nnz() != m_a_pos.size())
+            {
+                return false;
+            }
+
+            const auto &offsets = A.row_offsets();
+            const auto &indices = A.col_indices();
+
+            for (std::size_t j = 0; j < m_n; ++j)
+            {
+                for (std::size_t k = m_a_col_offsets[j]; k < m_a_col_offsets[j + 1]; ++k)
+                {
+                    const std::size_t r = m_a_row_indices[k];
+                    const std::size_t p = m_a_pos[k];
+                    if (indices[p] != j || p < offsets[r] || p >= offsets[r + 1])
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        void require_rhs_length(std::size_t len) const
+        {
+            if (len != m_n)
+            {
+                throw std::invalid_argument(
+                    "sparse_lu::solve(): b must have length n = " + std::to_string(m_n) +
+                    ", but got " + std::to_string(len));
+            }
+        }
+
+        /**
+         * @brief Прямой и обратный ход; b — вход и выход, z — рабочий буфер длины n.
+         */
+        void solve_raw(T *b, T *z) const
+        {
+            MIV_PROFILE_SCOPE(substitute);
+
+            // L z = P b: прямой ход по шагам, b индексируется исходными строками
+            for (std::size_t k = 0; k < m_n; ++k)
+            {
+                const T zk = b[m_pivot_rows[k]];
+                z[k] = zk;
+
+                for (std::size_t p = m_L_offsets[k]; p < m_L_offsets[k + 1]; ++p)
+                {
+                    b[m_L_rows[p]] -= m_L_values[p] * zk;
+                }
+            }
+
+            // U u = z: обратный ход по столбцам U
+            for (std::size_t k = m_n; k > 0; --k)
+            {
+                const std::size_t col = k - 1;
+                const T u = z[col] / m_U_diag[col];
+                z[col] = u;
+
+                for (std::size_t p = m_U_offsets[col]; p < m_U_offsets[col + 1]; ++p)
+                {
+                    z[m_U_steps[p]] -= m_U_values[p] * u;
+                }
+            }
+
+            // x = Q u
+            for (std::size_t k = 0; k < m_n; ++k)
+            {
+                b[m_col_order[k]] = z[k];
+            }
+        }
+
+        /**
+         * @brief Численное разложение по уже выбранному упорядочению m_col_order
+         * и запомненной CSC-структуре A.
+         */
+        void factorize_numeric(const miv::sparse_matrix<T> &A)
+        {
+            constexpr std::size_t none = static_cast<std::size_t>(-1);
+            const std::size_t n = A.rows();
+            const T eps = static_cast<T>(1e-18);
+            const T pivot_tolerance = m_pivot_tolerance;
+
+            // При ошибке объект остаётся пустым, а не полуразложенным
+            m_n = 0;
+
+            const miv::array<std::size_t> &a_col_offsets = m_a_col_offsets;
+            const miv::array<std::size_t> &a_row_indices = m_a_row_indices;
+            const miv::array<std::size_t> &a_pos = m_a_pos;
+            const T *a_values = A.values().data();
+
+            m_L_offsets.assign(1, 0);
+            m_L_rows.clear();
+            m_L_values.clear();
+            m_U_offsets.assign(1, 0);
+            m_U_steps.clear();
+            m_U_values.clear();
+            m_U_diag.resize(n);
+            m_pivot_rows.resize(n);
+
+            // Рабочие буферы — члены класса: при повторном разложении память не выделяется
+            // pinv[r] — шаг, на котором строка r стала ведущей (none — ещё нет)
+            std::vector<std::size_t> &pinv = m_pinv;
+            std::vector<T> &x = m_x;
+            std::vector<std::size_t> &mark = m_mark;
+            std::vector<std::size_t> &reach = m_reach;
+            std::vector<std::size_t> &stack_node = m_stack_node;
+            std::vector<std::size_t> &stack_pos = m_stack_pos;
+            pinv.assign(n, none);
+            x.assign(n, T{});
+            mark.assign(n, 0);
+            reach.clear();
+            stack_node.clear();
+            stack_pos.clear();
+            reach.reserve(n);
+            stack_node.reserve(n);
+            stack_pos.reserve(n);
+
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                const std::size_t col = m_col_order[k];
+                const std::size_t stamp = k + 1;
+
+                // 1) Символьная часть: множество достижимых строк в обратном порядке обхода
+                reach.clear();
+                for (std::size_t q = a_col_offsets[col]; q < a_col_offsets[col + 1]; ++q)
+                {
+                    const std::size_t start = a_row_indices[q];
+                    if (mark[start] == stamp)
+                    {
+                        continue;
+                    }
+
+                    mark[start] = stamp;
+                    stack_node.push_back(start);
+                    stack_pos.push_back(0);
+
+                    while (!stack_node.empty())
+                    {
+                        const std::size_t r = stack_node.back();
+                        const std::size_t j = pinv[r];
+                        bool descended = false;
+
+                        if (j != none)
+                        {
+                            std::size_t &p = stack_pos.back();
+                            const std::size_t end = m_L_offsets[j + 1] - m_L_offsets[j];
+
+                            while (p < end)
+                            {
+                                const std::size_t child = m_L_rows[m_L_offsets[j] + p];
+                                ++p;
+                                if (mark[child] != stamp)
+                                {
+                                    mark[child] = stamp;
+                                    stack_node.push_back(child);
+                                    stack_pos.push_back(0);
+                                    descended = true;
+                                    break;
+                                }
+                            }
+                        }
+
+                        if (!descended)
+                        {
+                            reach.push_back(r);
+                            stack_node.pop_back();
+                            stack_pos.pop_back();
+                        }
+                    }
+                }
+
+                // 2) Численная часть: x = L^{-1} A(:, col) по топологическому порядку
+                for (std::size_t q = a_col_offsets[col]; q < a_col_offsets[col + 1]; ++q)
+                {
+                    x[a_row_indices[q]] = a_values[a_pos[q]];
+                }
+
+                for (std::size_t t = reach.size(); t > 0; --t)
+                {
+                    const std::size_t r = reach[t - 1];
+                    const std::size_t j = pinv[r];
+
+                    if (j == none)
+                    {
+                        continue;
+                    }
+
+                    const T u = x[r];
+                    m_U_steps.push_back(j);
+                    m_U_values.push_back(u);
+
+                    for (std::size_t p = m_L_offsets[j]; p < m_L_offsets[j + 1]; ++p)
+                    {
+                        x[m_L_rows[p]] -= m_L_values[p] * u;
+                    }
+                }
+
+                // 3) Выбор ведущей строки среди ещё не ведущих
+                std::size_t pivot = none;
+                T max_val = 0;
+
+                for (const std::size_t r : reach)
+                {
+                    if (pinv[r] == none && std::abs(x[r]) > max_val)
+                    {
+                        max_val = std::abs(x[r]);
+                        pivot = r;
+                    }
+                }
+
+                if (pivot == none || max_val <= eps)
+                {
+                    throw std::invalid_argument("sparse_lu::factorize(): matrix is singular or near-singular");
+                }
+
+                if (pinv[col] == none && mark[col] == stamp && std::abs(x[col]) >= pivot_tolerance * max_val)
+                {
+                    pivot = col;
+                }
+
+                const T diag = x[pivot];
+                pinv[pivot] = k;
+                m_pivot_rows[k] = pivot;
+                m_U_diag[k] = diag;
+
+                for (const std::size_t r : reach)
+                {
+                    if (pinv[r] == none)
+                    {
+                        m_L_rows.push_back(r);
+                        m_L_values.push_back(x[r] / diag);
+                    }
+                    x[r] = T{};
+                }
+
+                m_L_offsets.push_back(m_L_rows.size());
+                m_U_offsets.push_back(m_U_steps.size());
+            }
+
+            m_n = n;
+        }
+
+        std::size_t m_n = 0;
+        T m_pivot_tolerance = static_cast<T>(0.1);
+
+        miv::array<std::size_t> m_col_order;   // Q: шаг k исключает столбец m_col_order[k]
+        miv::array<std::size_t> m_pivot_rows;  // P: на шаге k ведущая строка m_pivot_rows[k]
+
+        // L по столбцам (шагам): строки — исходные номера, единичная диагональ не хранится
+        std::vector<std::size_t> m_L_offsets;
+        std::vector<std::size_t> m_L_rows;
+        std::vector<T> m_L_values;
+
+        // U по столбцам (шагам): строки — номера шагов, диагональ отдельно
+        std::vector<std::size_t> m_U_offsets;
+        std::vector<std::size_t> m_U_steps;
+        std::vector<T> m_U_values;
+        miv::array<T> m_U_diag;
+
+        // CSC-структура A (из factorize) и рабочие буферы factorize_numeric
+        miv::array<std::size_t> m_a_col_offsets;
+        miv::array<std::size_t> m_a_row_indices;
+        miv::array<std::size_t> m_a_pos;
+        std::vector<std::size_t> m_pinv;
+        std::vector<T> m_x;
+        std::vector<std::size_t> m_mark;
+        std::vector<std::size_t> m_reach;
+        std::vector<std::size_t> m_stack_node;
+        std::vector<std::size_t> m_stack_pos;
+    };
+}
+
+#endif // MIV_MATH_SPARSE_H
@@ -0,0 +1,189 @@
+#ifndef MIV_MATH_SYSTEM_H
+#define MIV_MATH_SYSTEM_H
+
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+#include "containers/array.hpp"
+#include "containers/matrix_view.hpp"
+#include "containers/profile.hpp"
+
+namespace miv::math
+{
+    /**
+     * @brief Система F(x) = 0, заданная одним вызываемым объектом на все компоненты.
+     *
+     * f(x, out) пишет F_0(x)..F_{n-1}(x) в out за один проход:
+     *
+     * @code
+     * auto system = miv::math::make_vector_system(2, [](auto x, auto out)
+     * {
+     *     using std::sin;
+     *     const auto s = sin(x[1] + 1);   // общий член обоих уравнений
+     *     out[0] = s - x[0] - 1.2;
+     *     out[1] = s * x[0] + x[1];
+     * });
+     * solver.solve(system, x0);
+     * @endcode
+     *
+     * x — miv::array_view<const T>, out — miv::array_view<T>. Общие подвыражения
+     * считаются один раз, а тип F — параметр шаблона везде (newton_solver,
+     * jacobian_builder, sparse_jacobian_builder), так что вызов встраивается.
+     * Для JacobianMode::Automatic f должен быть шаблонным (auto-параметры):
+     * его же вызывают от miv::ad::dual.
+     *
+     * Покомпонентная форма std::vector<Fn> (fi(miv::array<T>&) -> T) остаётся —
+     * обе принимаются одними и теми же функциями через system_size / evaluate_system.
+     */
+    template <typename F>
+    class vector_system
+    {
+    public:
+        using function_t = F;
+
+        vector_system(std::size_t n, F f) : m_size(n), m_function(std::move(f)) {}
+
+        /// Число уравнений (= число неизвестных)
+        std::size_t size() const { return m_size; }
+
+        const F &function() const { return m_function; }
+
+    private:
+        std::size_t m_size;
+        F m_function;
+    };
+
+    template <typename F>
+    vector_system<std::decay_t<F>> make_vector_system(std::size_t n, F &&f)
+    {
+        return vector_system<std::decay_t<F>>(n, std::forward<F>(f));
+    }
+
+    /**
+     * @brief Семейство систем F(x; p) = 0: одна векторная функция, свой вектор параметров p у каждой задачи.
+     *
+     * f(x, p, out) — как у vector_system, но p (miv::array_view<const P>,
+     * parameters() чисел) передаётся отдельно и решателем не меняется:
+     *
+     * @code
+     * auto family = miv::math::make_parametric_system(2, 1, [](auto x, auto p, auto out)
+     * {
+     *     out[0] = x[0] * x[0] - p[0];
+     *     out[1] = x[1] - x[0];
+     * });
+     * auto result = miv::math::solve_batch(family, starts, params);   // params: строка на задачу
+     * @endcode
+     *
+     * bind_parameters(family, p) фиксирует p и даёт обычную vector_system,
+     * которую принимают все решатели.
+     */
+    template <typename F>
+    class parametric_system
+    {
+    public:
+        using function_t = F;
+
+        parametric_system(std::size_t n, std::size_t parameters, F f)
+            : m_size(n), m_parameters(parameters), m_function(std::move(f)) {}
+
+        /// Число уравнений (= число неизвестных)
+        std::size_t size() const { return m_size; }
+
+        /// Длина вектора параметров p
+        std::size_t parameters() const { return m_parameters; }
+
+        const F &function() const { return m_function; }
+
+    private:
+        std::size_t m_size;
+        std::size_t m_parameters;
+        F m_function;
+    };
+
+    template <typename F>
+    parametric_system<std::decay_t<F>> make_parametric_system(std::size_t n, std::size_t parameters, F &&f)
+    {
+        return parametric_system<std::decay_t<F>>(n, parameters, std::forward<F>(f));
+    }
+
+    /**
+     * @brief f(x, p, out) с зафиксированным p — функция для vector_system.
+     *
+     * Хранит указатели: система и p должны жить дольше результата bind_parameters.
+     */
+    template <typename F, typename P>
+    struct bound_parameters
+    {
+        const F *function;
+        miv::array_view<const P> p;
+
+        template <typename X, typename Out>
+        void operator()(X x, Out out) const
+        {
+            (*function)(x, p, out);
+        }
+    };
+
+    /**
+     * @brief Система F(x; p) = 0 при данном p.
+     */
+    template <typename F, typename P>
+    vector_system<bound_parameters<F, P>> bind_parameters(const parametric_system<F> &system, miv::array_view<const P> p)
+    {
+        return vector_system<bound_parameters<F, P>>(system.size(), { &system.function(), p });
+    }
+
+    template <typename S>
+    inline constexpr bool is_vector_system_v = false;
+
+    template <typename F>
+    inline constexpr bool is_vector_system_v<vector_system<F>> = true;
+
+    // ============================================================
+    //            Единый доступ к обеим формам системы
+    // ============================================================
+
+    /**
+     * @brief Число уравнений покомпонентной системы.
+     */
+    template <typename Fn>
+    std::size_t system_size(const std::vector<Fn> &functions)
+    {
+        return functions.size();
+    }
+
+    template <typename F>
+    std::size_t system_size(const vector_system<F> &system)
+    {
+        return system.size();
+    }
+
+    /**
+     * @brief out[i] = F_i(x), i < system_size: по вызову на компоненту.
+     */
+    template <typename Fn, typename V>
+    void evaluate_system(const std::vector<Fn> &functions, miv::array<V> &x, V *out)
+    {
+        MIV_PROFILE_SCOPE(evaluate);
+
+        for (std::size_t i = 0; i < functions.size(); ++i)
+        {
+            out[i] = functions[i](x);
+        }
+    }
+
+    /**
+     * @brief out = F(x) одним вызовом.
+     */
+    template <typename F, typename V>
+    void evaluate_system(const vector_system<F> &system, miv::array<V> &x, V *out)
+    {
+        MIV_PROFILE_SCOPE(evaluate);
+
+        system.function()(miv::array_view<const V>(x.data(), x.size()), miv::array_view<V>(out, system.size()));
+    }
+}
+
+#endif // MIV_MATH_SYSTEM_H
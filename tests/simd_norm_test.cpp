@@ -0,0 +1,70 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <initializer_list>
+#include <limits>
+#include <vector>
+
+#include "math/simd.hpp"
+
+/**
+ * @file simd_norm_test.cpp
+ * @brief norm_l2 (math/simd.hpp) на нечисловых входах: NaN не должен давать норму 0.
+ *
+ * Длины: 1, 2, 64 (кратна ширине SIMD и развёрнутому циклу ядра) и 67 (с хвостом). Код возврата
+ * — число проваленных проверок.
+ */
+
+namespace
+{
+    int failures = 0;
+
+    void expect(bool ok, const char *type, const char *what, std::size_t n)
+    {
+        if (!ok)
+        {
+            std::fprintf(stderr, "FAIL %s n=%zu: %s\n", type, n, what);
+            ++failures;
+        }
+    }
+
+    template <typename T>
+    void check(const char *type)
+    {
+        const T nan = std::numeric_limits<T>::quiet_NaN();
+        const T inf = std::numeric_limits<T>::infinity();
+
+        for (const std::size_t n : std::initializer_list<std::size_t> { 1, 2, 64, 67 })
+        {
+            std::vector<T> v(n, nan);
+            expect(std::isnan(miv::math::simd::norm_l2(n, v.data())), type, "all NaN", n);
+
+            std::vector<T> one(n, static_cast<T>(1));
+            one[n - 1] = nan;
+            expect(std::isnan(miv::math::simd::norm_l2(n, one.data())), type, "one NaN (last)", n);
+
+            one[n - 1] = static_cast<T>(1);
+            one[0] = nan;
+            expect(std::isnan(miv::math::simd::norm_l2(n, one.data())), type, "one NaN (first)", n);
+
+            std::vector<T> big(n, inf);
+            expect(std::isinf(miv::math::simd::norm_l2(n, big.data())), type, "all inf", n);
+
+            std::vector<T> zero(n, T{});
+            expect(miv::math::simd::norm_l2(n, zero.data()) == 0, type, "zeros", n);
+        }
+    }
+}
+
+int main()
+{
+    check<float>("float");
+    check<double>("double");
+    check<long double>("long double");
+
+    if (failures == 0)
+    {
+        std::puts("simd_norm_test: ok");
+    }
+    return failures;
+}
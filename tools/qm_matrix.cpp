@@ -0,0 +1,265 @@
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "io/matrix_file.hpp"
+
+/**
+ * @file qm_matrix.cpp
+ * @brief Работа с двоичными матрицами/векторами (.qmm, io/matrix_file.hpp).
+ *
+ * Использование:
+ *   qm_matrix info <файл.qmm>
+ *   qm_matrix pack <текст> <файл.qmm> [--vector] [--float32|--float64|--float80]
+ *   qm_matrix dump <файл.qmm>
+ *
+ * pack: строка текста — строка матрицы (числа через пробел), с --vector все
+ * числа подряд образуют вектор. Текст читается дважды (форма, затем данные),
+ * матрица целиком в памяти не держится. По умолчанию элементы — float64.
+ */
+
+namespace
+{
+    void print_usage(const char *program)
+    {
+        std::cerr << "Использование:\n"
+                  << "  " << program << " info <файл.qmm>\n"
+                  << "  " << program << " pack <текст> <файл.qmm> [--vector] [--float32|--float64|--float80]\n"
+                  << "  " << program << " dump <файл.qmm>\n";
+    }
+
+    /**
+     * @brief Числа одной строки текста (false — в строке есть не-число).
+     */
+    bool parse_line(const std::string &line, std::vector<long double> &values)
+    {
+        values.clear();
+        std::istringstream ss(line);
+        long double v;
+        while (ss >> v)
+        {
+            values.push_back(v);
+        }
+        return ss.eof();
+    }
+
+    /**
+     * @brief Первый проход: форма матрицы в тексте.
+     */
+    void scan_shape(const std::string &path, bool vector, std::size_t &rows, std::size_t &cols)
+    {
+        std::ifstream in(path);
+        if (!in)
+        {
+            throw std::runtime_error("cannot open '" + path + "'");
+        }
+
+        rows = 0;
+        cols = 0;
+        std::size_t total = 0;
+        std::size_t line_no = 0;
+        std::string line;
+        std::vector<long double> values;
+
+        while (std::getline(in, line))
+        {
+            ++line_no;
+            if (!parse_line(line, values))
+            {
+                throw std::runtime_error(path + ":" + std::to_string(line_no) + ": not a number");
+            }
+            if (values.empty())
+            {
+                continue;
+            }
+
+            if (!vector && rows > 0 && values.size() != cols)
+            {
+                throw std::runtime_error(path + ":" + std::to_string(line_no) + ": expected " +
+                                         std::to_string(cols) + " numbers, got " + std::to_string(values.size()));
+            }
+
+            cols = values.size();
+            total += values.size();
+            ++rows;
+        }
+
+        if (vector)
+        {
+            rows = total;
+            cols = 1;
+        }
+    }
+
+    template <typename T>
+    void pack(const std::string &text, const std::string &out_path, bool vector)
+    {
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+        scan_shape(text, vector, rows, cols);
+
+        auto out = vector ? miv::io::matrix_file_writer<T>(out_path, rows)
+                          : miv::io::matrix_file_writer<T>(out_path, rows, cols);
+
+        std::ifstream in(text);
+        std::string line;
+        std::vector<long double> values;
+        std::vector<T> row;
+
+        while (std::getline(in, line))
+        {
+            parse_line(line, values);
+            row.assign(values.begin(), values.end());
+            out.write(row.data(), row.size());
+        }
+
+        out.close();
+        std::printf("%s: %zu x %zu, %s\n", out_path.c_str(), rows, cols, miv::io::to_string(miv::io::dtype_of<T>()));
+    }
+
+    void info(const std::string &path)
+    {
+        const auto h = miv::io::read_matrix_file_header(path);
+        std::printf("%s: %s %llu x %llu, %s (%u байт на элемент), данные с байта %llu\n",
+                    path.c_str(),
+                    h.rank == 1 ? "вектор" : "матрица",
+                    static_cast<unsigned long long>(h.rows),
+                    static_cast<unsigned long long>(h.cols),
+                    miv::io::to_string(static_cast<miv::io::matrix_dtype>(h.dtype)),
+                    h.element_size,
+                    static_cast<unsigned long long>(h.data_offset));
+    }
+
+    template <typename T>
+    void dump_as(const std::string &path)
+    {
+        const miv::io::matrix_file_view<T> view(path);
+        const T *data = view.data();
+
+        for (std::size_t r = 0; r < view.rows(); ++r)
+        {
+            for (std::size_t c = 0; c < view.cols(); ++c)
+            {
+                std::printf(c == 0 ? "%.*Lg" : " %.*Lg", std::numeric_limits<T>::max_digits10,
+                            static_cast<long double>(data[r * view.cols() + c]));
+            }
+            std::printf("\n");
+        }
+    }
+
+    void dump(const std::string &path)
+    {
+        const auto h = miv::io::read_matrix_file_header(path);
+
+        switch (static_cast<miv::io::matrix_dtype>(h.dtype))
+        {
+        case miv::io::matrix_dtype::float32:
+            dump_as<float>(path);
+            return;
+        case miv::io::matrix_dtype::float64:
+            dump_as<double>(path);
+            return;
+        case miv::io::matrix_dtype::float80:
+        case miv::io::matrix_dtype::float128:
+            if (miv::io::dtype_of<long double>() == static_cast<miv::io::matrix_dtype>(h.dtype))
+            {
+                dump_as<long double>(path);
+                return;
+            }
+            break;
+        }
+
+        throw std::runtime_error("elements of '" + path + "' are not supported on this platform");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    const std::string_view command = argv[1];
+
+    try
+    {
+        if (command == "info" && argc == 3)
+        {
+            info(argv[2]);
+        }
+        else if (command == "dump" && argc == 3)
+        {
+            dump(argv[2]);
+        }
+        else if (command == "pack" && argc >= 4)
+        {
+            bool vector = false;
+            miv::io::matrix_dtype dtype = miv::io::matrix_dtype::float64;
+
+            for (int i = 4; i < argc; ++i)
+            {
+                const std::string_view arg = argv[i];
+                if (arg == "--vector")
+                {
+                    vector = true;
+                }
+                else if (arg == "--float32")
+                {
+                    dtype = miv::io::matrix_dtype::float32;
+                }
+                else if (arg == "--float64")
+                {
+                    dtype = miv::io::matrix_dtype::float64;
+                }
+                else if (arg == "--float80")
+                {
+                    dtype = miv::io::matrix_dtype::float80;
+                }
+                else
+                {
+                    print_usage(argv[0]);
+                    return 2;
+                }
+            }
+
+            switch (dtype)
+            {
+            case miv::io::matrix_dtype::float32:
+                pack<float>(argv[2], argv[3], vector);
+                break;
+            case miv::io::matrix_dtype::float64:
+                pack<double>(argv[2], argv[3], vector);
+                break;
+            default:
+                if (miv::io::dtype_of<long double>() != miv::io::matrix_dtype::float80)
+                {
+                    throw std::runtime_error("float80 is not available on this platform");
+                }
+                pack<long double>(argv[2], argv[3], vector);
+                break;
+            }
+        }
+        else
+        {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Ошибка: " << ex.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "io/trace.hpp"
+
+/**
+ * @file qm_trace_decode.cpp
+ * @brief Расшифровка двоичной трассы итераций (QM_TRACE) в текст.
+ *
+ * Использование:
+ *   qm_trace_decode <файл> [--csv]
+ *
+ * По умолчанию печатается выровненная таблица, с --csv — CSV с заголовком.
+ */
+
+namespace
+{
+    void print_usage(const char *program)
+    {
+        std::cerr << "Использование: " << program << " <файл трассы> [--csv]\n";
+    }
+
+    void print_row(const miv::io::trace_record &r, bool csv)
+    {
+        const double iteration_us = static_cast<double>(r.iteration_ns) / 1e3;
+        const double elapsed_us = static_cast<double>(r.elapsed_ns) / 1e3;
+
+        if (csv)
+        {
+            std::printf("%u,%u,%.17g,%.17g,%.17g,%lld,%lld\n",
+                        r.run, r.iteration, r.fx_norm, r.step_norm, r.lambda,
+                        static_cast<long long>(r.iteration_ns), static_cast<long long>(r.elapsed_ns));
+        }
+        else
+        {
+            std::printf("%5u %6u %14.6e %14.6e %8.4f %14.3f %14.3f\n",
+                        r.run, r.iteration, r.fx_norm, r.step_norm, r.lambda, iteration_us, elapsed_us);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string path;
+    bool csv = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--csv")
+        {
+            csv = true;
+        }
+        else if (path.empty() && !arg.starts_with("--"))
+        {
+            path = arg;
+        }
+        else
+        {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (path.empty())
+    {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    try
+    {
+        miv::io::trace_reader reader(path);
+
+        if (csv)
+        {
+            std::printf("run,iteration,fx_norm,step_norm,lambda,iteration_ns,elapsed_ns\n");
+        }
+        else
+        {
+            std::printf("%5s %6s %14s %14s %8s %14s %14s\n",
+                        "run", "k", "||F||", "||s||", "lambda", "t_iter, us", "t_total, us");
+        }
+
+        miv::io::trace_record record;
+        std::size_t count = 0;
+        while (reader.next(record))
+        {
+            print_row(record, csv);
+            ++count;
+        }
+
+        if (!csv)
+        {
+            std::printf("записей: %zu\n", count);
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        std::cerr << "Ошибка: " << ex.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}